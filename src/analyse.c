@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		16/11/2016
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -60,6 +60,22 @@
 static obj2struct	*obj2 = &outobj2;
 extern profitstruct	*theprofit,*thedprofit;
 
+/* Isophotal quantities available for pre-measurement selection */
+typedef enum	{PRESEL_FLAGS, PRESEL_ISOAREA, PRESEL_FLUX, PRESEL_FLUXERR,
+		PRESEL_MAG, PRESEL_SNR, PRESEL_PEAK, PRESEL_X, PRESEL_Y,
+		PRESEL_A, PRESEL_B, PRESEL_ELONG, PRESEL_FWHM}	preselenum;
+
+static const char	presel_paramname[][32] = {"FLAGS", "ISOAREA_IMAGE",
+			"FLUX_ISO", "FLUXERR_ISO", "MAG_ISO", "SNR_ISO",
+			"FLUX_MAX", "X_IMAGE", "Y_IMAGE", "A_IMAGE", "B_IMAGE",
+			"ELONGATION", "FWHM_IMAGE", ""};
+
+static preselenum	presel_param[MAXLIST];
+static double		presel_value[MAXLIST];
+static int		presel_gtflag[MAXLIST], npresel;
+
+static int		presel(objstruct *obj);
+
 /********************************* analyse ***********************************/
 void  analyse(picstruct *field, picstruct *dfield, int objnb,
 		objliststruct *objlist)
@@ -104,13 +120,15 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
   {
    checkstruct		*check;
    pliststruct		*pixt;
-   int			i,j,k,h, photoflag,area,errflag, cleanflag,
-			pospeakflag, minarea, gainflag;
+   plistsoastruct	*soa;
+   int			i,j,k,h,p, photoflag,area,errflag, cleanflag,
+			pospeakflag, minarea, gainflag, px,py;
    double		tv,sigtv, ngamma,
 			esum, emx2,emy2,emxy, err,gain,backnoise2,dbacknoise2,
 			xm,ym, x,y,var,var2, threshfac;
    float		*heap,*heapt,*heapj,*heapk, swap;
-   PIXTYPE		pix, cdpix, tpix, peak,cdpeak, thresh,dthresh,minthresh;
+   PIXTYPE		pix, cdpix, tpix, peak,cdpeak, thresh,dthresh,minthresh,
+			pdthresh, dgeox,dgeoy;
    static PIXTYPE	threshs[NISO];
 
 
@@ -168,22 +186,58 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
   threshfac = field->backsig > 0.0 ? field->thresh / field->backsig : 1.0;
   dthresh = dfield->dthresh;
   area = 0;
-  for (pixt=pixel+obj->firstpix; pixt>=pixel; pixt=pixel+PLIST(pixt,nextpix))
+  pdthresh = dthresh;
+  dgeox = dgeoy = 0.0;
+/* Pixels are read either from the compacted arrays or from the pixel-list */
+  soa = get_compactplist(pixel, obj);
+  pixt = pixel+obj->firstpix;
+  for (p=0; soa? p<soa->npix : pixt>=pixel; p++)
     {
-    pix = PLIST(pixt,value);
+    if (soa)
+      {
+      pix = soa->value[p];
+      cdpix = soa->cdvalue[p];
+      px = soa->x[p];
+      py = soa->y[p];
+      if (PLISTEXIST(var))
+        var = soa->var[p];
+      if (PLISTEXIST(dthresh))
+        pdthresh = soa->dthresh[p];
+      if (PLISTEXIST(dgeo))
+        {
+        dgeox = soa->dgeox[p];
+        dgeoy = soa->dgeoy[p];
+        }
+      }
+    else
+      {
+      pix = PLIST(pixt,value);
+      cdpix = PLISTPIX(pixt,cdvalue);
+      px = PLIST(pixt,x);
+      py = PLIST(pixt,y);
+      if (PLISTEXIST(var))
+        var = PLISTPIX(pixt, var);
+      if (PLISTEXIST(dthresh))
+        pdthresh = PLISTPIX(pixt, dthresh);
+      if (PLISTEXIST(dgeo))
+        {
+        dgeox = PLISTPIX(pixt, dgeox);
+        dgeoy = PLISTPIX(pixt, dgeoy);
+        }
+      pixt = pixel+PLIST(pixt,nextpix);
+      }
+
     if (pix>peak)
       peak = pix;
 
-    cdpix=PLISTPIX(pixt,cdvalue);
     if (pospeakflag && cdpix>cdpeak)
       {
       cdpeak=cdpix;
-      obj->peakx =  PLIST(pixt,x) + 1;
-      obj->peaky =  PLIST(pixt,y) + 1;
+      obj->peakx =  px + 1;
+      obj->peaky =  py + 1;
       }
     if (PLISTEXIST(var))
       {
-      var = PLISTPIX(pixt, var);
       thresh = threshfac*sqrt(var);
       if (thresh < minthresh)
         minthresh = thresh;
@@ -209,11 +263,11 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
       err = dbacknoise2;
       if (gain>0.0 && cdpix>0.0)
         err += cdpix/gain;
-      x = PLIST(pixt,x) - xm;
-      y = PLIST(pixt,y) - ym;
+      x = px - xm;
+      y = py - ym;
       if PLISTEXIST(dgeo) {
-        x -= PLISTPIX(pixt, dgeox);
-        y -= PLISTPIX(pixt, dgeoy);
+        x -= dgeox;
+        y -= dgeoy;
       }
       esum += err;
       emx2 += err*x*x;
@@ -224,8 +278,7 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
 /*-- Find the minareath pixel in decreasing intensity for CLEANing */
     if (cleanflag)
       {
-      tpix = PLISTPIX(pixt, cdvalue) - (PLISTEXIST(dthresh)?
-		PLISTPIX(pixt, dthresh):dthresh);
+      tpix = cdpix - pdthresh;
       if (h>0)
         *(heapt++) = (float)tpix;
       else if (h)
@@ -332,23 +385,46 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
         for (i=0; i<NISO; i++)
           threshs[i] = 0.0;
       }
-    for (pixt=pixel+obj->firstpix; pixt>=pixel; pixt=pixel+PLIST(pixt,nextpix))
-      for (i=NISO,iso=obj->iso,thresht=threshs;
+    if (soa)
+      for (p=0; p<soa->npix; p++)
+        for (i=NISO,iso=obj->iso,thresht=threshs;
+		i-- && soa->value[p]>*(thresht++);)
+          (*(iso++))++;
+    else
+      for (pixt=pixel+obj->firstpix; pixt>=pixel;
+		pixt=pixel+PLIST(pixt,nextpix))
+        for (i=NISO,iso=obj->iso,thresht=threshs;
 		i-- && PLIST(pixt,value)>*(thresht++);)
-        (*(iso++))++;
+          (*(iso++))++;
     }
 
 /* Put objects in "segmentation check-image" */
 
   if ((check = prefs.check[CHECK_SEGMENTATION]))
-    for (pixt=pixel+obj->firstpix; pixt>=pixel; pixt=pixel+PLIST(pixt,nextpix))
-      ((ULONG *)check->pix)[check->width*PLIST(pixt,y)+PLIST(pixt,x)]
+    {
+    if (soa)
+      for (p=0; p<soa->npix; p++)
+        ((ULONG *)check->pix)[check->width*soa->y[p]+soa->x[p]]
 		= (ULONG)obj->number;
+    else
+      for (pixt=pixel+obj->firstpix; pixt>=pixel;
+		pixt=pixel+PLIST(pixt,nextpix))
+        ((ULONG *)check->pix)[check->width*PLIST(pixt,y)+PLIST(pixt,x)]
+		= (ULONG)obj->number;
+    }
 
   if ((check = prefs.check[CHECK_OBJECTS]))
-    for (pixt=pixel+obj->firstpix; pixt>=pixel; pixt=pixel+PLIST(pixt,nextpix))
-      ((PIXTYPE *)check->pix)[check->width*PLIST(pixt,y)+PLIST(pixt,x)]
+    {
+    if (soa)
+      for (p=0; p<soa->npix; p++)
+        ((PIXTYPE *)check->pix)[check->width*soa->y[p]+soa->x[p]]
+		= soa->value[p];
+    else
+      for (pixt=pixel+obj->firstpix; pixt>=pixel;
+		pixt=pixel+PLIST(pixt,nextpix))
+        ((PIXTYPE *)check->pix)[check->width*PLIST(pixt,y)+PLIST(pixt,x)]
 		= PLIST(pixt,value);
+    }
 
 /* Compute the FWHM of the object */
   if (FLAG(obj.fwhm))
@@ -368,16 +444,39 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
       dbkg = obj->dbkg;
       sat = (double)(field->satur_level - obj->bkg);
       s = sx = sy = sxx = sxy = 0.0;
-      for (pixt=pixel+obj->firstpix;pixt>=pixel;pixt=pixel+PLIST(pixt,nextpix))
+      pixt = pixel+obj->firstpix;
+      for (p=0; soa? p<soa->npix : pixt>=pixel; p++)
         {
-        pix = PLIST(pixt,value)-dbkg;
+        if (soa)
+          {
+          pix = soa->value[p]-dbkg;
+          px = soa->x[p];
+          py = soa->y[p];
+          if (PLISTEXIST(dgeo))
+            {
+            dgeox = soa->dgeox[p];
+            dgeoy = soa->dgeoy[p];
+            }
+          }
+        else
+          {
+          pix = PLIST(pixt,value)-dbkg;
+          px = PLIST(pixt,x);
+          py = PLIST(pixt,y);
+          if (PLISTEXIST(dgeo))
+            {
+            dgeox = PLISTPIX(pixt, dgeox);
+            dgeoy = PLISTPIX(pixt, dgeoy);
+            }
+          pixt = pixel+PLIST(pixt,nextpix);
+          }
         if (pix>thresh0 && pix<sat)
           {
-          dx = PLIST(pixt,x) - mx;
-          dy = PLIST(pixt,y) - my;
+          dx = px - mx;
+          dy = py - my;
           if PLISTEXIST(dgeo) {
-            dx -= PLISTPIX(pixt, dgeox);
-            dy -= PLISTPIX(pixt, dgeoy);
+            dx -= dgeox;
+            dy -= dgeoy;
           }
           lpix = log(pix);
           inverr2 = pix*pix;
@@ -411,6 +510,102 @@ void  examineiso(picstruct *field, picstruct *dfield, objstruct *obj,
   }
 
 
+/******************************* init_presel ********************************/
+/*
+Parse the pre-measurement selection cuts (PRESELECT).
+*/
+void	init_presel(void)
+
+  {
+   char		*str, *opstr, *endstr;
+   int		i, p;
+
+  npresel = 0;
+  for (i=0; i<prefs.npresel_name; i++)
+    {
+    str = prefs.presel_name[i];
+    if (!*str || !strcmp(str, "NONE"))
+      continue;
+    if (!(opstr=strpbrk(str, "<>")) || opstr==str)
+      error(EXIT_FAILURE, "*Error*: PRESELECT cuts must read NAME<value "
+		"or NAME>value: ", str);
+    for (p=0; *presel_paramname[p]; p++)
+      if (strlen(presel_paramname[p])==(size_t)(opstr-str)
+		&& !strncmp(str, presel_paramname[p], opstr-str))
+        break;
+    if (!*presel_paramname[p])
+      error(EXIT_FAILURE, "*Error*: unknown PRESELECT quantity in ", str);
+    presel_value[npresel] = strtod(opstr+1, &endstr);
+    if (endstr==opstr+1 || *endstr)
+      error(EXIT_FAILURE, "*Error*: invalid PRESELECT value in ", str);
+    presel_gtflag[npresel] = (*opstr=='>');
+    presel_param[npresel++] = (preselenum)p;
+/*-- The FWHM is only computed on request */
+    if (p==PRESEL_FWHM)
+      FLAG(obj.fwhm) = 1;
+    }
+
+  prefs.presel_flag = (npresel>0);
+
+  return;
+  }
+
+
+/********************************** presel ***********************************/
+/*
+Apply the pre-measurement selection cuts to a detection. Returns 1 if the
+detection passes all cuts, 0 otherwise.
+*/
+static int	presel(objstruct *obj)
+
+  {
+   double	val;
+   int		i;
+
+  for (i=0; i<npresel; i++)
+    {
+    switch(presel_param[i])
+      {
+      case PRESEL_FLAGS:	val = obj->flag;
+				break;
+      case PRESEL_ISOAREA:	val = obj->npix;
+				break;
+      case PRESEL_FLUX:		val = obj->flux;
+				break;
+      case PRESEL_FLUXERR:	val = sqrt(obj->fluxerr);
+				break;
+      case PRESEL_MAG:		val = obj->flux>0.0?
+				-2.5*log10(obj->flux) + prefs.mag_zeropoint
+				: 99.0;
+				break;
+      case PRESEL_SNR:		val = obj->fluxerr>0.0?
+				obj->flux/sqrt(obj->fluxerr) : 0.0;
+				break;
+      case PRESEL_PEAK:		val = obj->peak;
+				break;
+      case PRESEL_X:		val = obj->mx+1.0;
+				break;
+      case PRESEL_Y:		val = obj->my+1.0;
+				break;
+      case PRESEL_A:		val = obj->a;
+				break;
+      case PRESEL_B:		val = obj->b;
+				break;
+      case PRESEL_ELONG:	val = obj->a/obj->b;
+				break;
+      case PRESEL_FWHM:		val = obj->fwhm;
+				break;
+      default:			val = 0.0;
+				break;
+      }
+    if (presel_gtflag[i]? (val<=presel_value[i]) : (val>=presel_value[i]))
+      return 0;
+    }
+
+  return 1;
+  }
+
+
 /******************************* endobject **********************************/
 /*
 Final processing of object data, just before saving it to the catalog.
@@ -460,6 +655,16 @@ void	endobject(picstruct *field, picstruct *dfield, picstruct *wfield,
   else
     selecflag = 1;
 
+/* Cheap cuts on isophotal quantities, before any costly measurement */
+  if (selecflag && prefs.presel_flag)
+    selecflag = presel(obj);
+
+#ifdef USE_MODEL
+/* Rejected objects are never measured: release their joint model fits */
+  if (!selecflag && prefs.prof_flag && prefs.model_blendflag)
+    profit_blenddrop(theprofit, obj);
+#endif
+
   if (selecflag)
     {
 /*-- Paste back to the image the object's pixels if BLANKing is on */
@@ -472,6 +677,9 @@ void	endobject(picstruct *field, picstruct *dfield, picstruct *wfield,
 		obj->subx, obj->suby);
       }
 
+/*-- Measurements below share copies of the pixels around the object */
+    measvig_reset();
+
 /*------------------------- Error ellipse parameters ------------------------*/
     if (FLAG(obj2.poserr_a))
       {
@@ -749,6 +957,9 @@ void	endobject(picstruct *field, picstruct *dfield, picstruct *wfield,
 #ifdef USE_MODEL
     if (prefs.prof_flag)
       {
+/*---- Fit jointly with the pending neighbours it overlaps */
+      if (prefs.model_blendflag)
+        profit_blendfit(theprofit, field, wfield, dgeofield, objlist, n, obj2);
       profit_fit(theprofit, field, wfield, dgeofield, obj, obj2);
 /*---- Express positions in FOCAL or WORLD coordinates */
       if (FLAG(obj2.xf_prof) || FLAG(obj2.xw_prof))
@@ -864,6 +1075,8 @@ void	endobject(picstruct *field, picstruct *dfield, picstruct *wfield,
       }
     }
 
+  measvig_reset();
+
   /* Clean (zero) all measurements */
   zerocat();
 
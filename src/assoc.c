@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		17/04/2013
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -39,6 +39,7 @@
 #include	"globals.h"
 #include	"prefs.h"
 #include	"assoc.h"
+#include	"fits/fitscat.h"
 #include	"fitswcs.h"
 
 /********************************* comp_assoc ********************************/
@@ -230,6 +231,90 @@ assocstruct  *load_assoc(char *filename, wcsstruct *wcs)
   }
 
 
+/******************************** load_assoccat ******************************/
+/*
+Read columns from the objects table of a FITS_LDAC catalogue, and return a
+pointer to the new assoc struct (or NULL if no catalogue, table or column was
+found). The first 2 columns are the coordinates; the following (scalar or
+vector) columns are concatenated to form the associated data.
+*/
+assocstruct  *load_assoccat(char *filename, char **keynames, int nkeys,
+			int ext, wcsstruct *wcs)
+
+  {
+   assocstruct	*assoc;
+   catstruct	*cat;
+   tabstruct	*tab;
+   keystruct	**keys, *key;
+   double	*list;
+   char		*ptr;
+   int		e,i,j,k,n, nlist, ndata, nobj, size;
+
+  if (!(cat = read_cat(filename)))
+    return NULL;
+
+/* Find the objects table that matches the current extension */
+  tab = cat->tab;
+  for (i=cat->ntab, e=0; i--; tab=tab->nexttab)
+    if (!strcmp("LDAC_OBJECTS", tab->extname) && ++e==ext)
+      break;
+  if (i<0)
+    {
+    free_cat(&cat, 1);
+    return NULL;
+    }
+
+  NFPRINTF(OUTPUT, "Reading ASSOC catalogue...");
+  QMALLOC(keys, keystruct *, nkeys);
+  read_keys(tab, keynames, keys, nkeys, NULL);
+  ndata = 0;
+  for (k=0; k<nkeys; k++)
+    {
+    if (!keys[k])
+      {
+      warning(keynames[k], " column not found in ASSOC catalogue");
+      free(keys);
+      free_cat(&cat, 1);
+      return NULL;
+      }
+    if (k>1)
+      ndata += keys[k]->nbytes/t_size[keys[k]->ttype];
+    }
+
+  QCALLOC(assoc, assocstruct, 1);
+  nobj = tab->naxisn[1];
+  nlist = ndata+3;
+  QCALLOC(assoc->list, double, nobj? nobj*nlist : 1);
+  list = assoc->list;
+  for (i=0; i<nobj; i++, list+=nlist)
+    {
+/*-- Coordinates come first, then the (unused) weighting parameter */
+    for (j=0, k=0; k<nkeys; k++)
+      {
+      key = keys[k];
+      size = t_size[key->ttype];
+      ptr = (char *)key->ptr + i*key->nbytes;
+      for (n=key->nbytes/size; n--; ptr+=size)
+        ttypeconv(ptr, list + j++, key->ttype, T_DOUBLE);
+      if (k==1)
+        j++;
+      }
+    if (wcs)
+      wcs_to_raw(wcs, list, list);
+    }
+
+  free(keys);
+  free_cat(&cat, 1);
+
+  assoc->nobj = nobj;
+  assoc->radius = prefs.assoc_radius;
+  assoc->ndata = ndata;
+  assoc->ncol = nlist;
+
+  return assoc;
+  }
+
+
 /********************************* init_assoc ********************************/
 /*
 Initialize the association procedure.
@@ -259,6 +344,39 @@ void	init_assoc(picstruct *field)
   }
 
 
+/******************************* init_modelassoc *****************************/
+/*
+Load the catalogue of model-fitting results from a previous run.
+*/
+void	init_modelassoc(picstruct *field)
+
+  {
+   static char	*pixnames[] = {"XMODEL_IMAGE", "YMODEL_IMAGE",
+				"VECTOR_MODEL"},
+		*wcsnames[] = {"XMODEL_WORLD", "YMODEL_WORLD",
+				"VECTOR_MODEL"};
+   assocstruct	*assoc;
+   int		worldflag;
+
+  worldflag = (prefs.assoccoord_type==ASSOCCOORD_WORLD && field->wcs);
+  if (!(assoc = field->modelassoc = load_assoccat(prefs.modelinit_name,
+		worldflag? wcsnames : pixnames, 3, thecat.currext,
+		worldflag? field->wcs : NULL)))
+    {
+    warning(prefs.modelinit_name,
+	" cannot be used for model initialisation");
+    return;
+    }
+
+  if (assoc->nobj==0)
+    warning(prefs.modelinit_name, " model initialisation catalogue is empty");
+
+  sort_assoc(field, assoc);
+
+  return;
+  }
+
+
 /********************************** end_assoc ********************************/
 /*
 Free memory related to the assoc operations.
@@ -273,6 +391,13 @@ void	end_assoc(picstruct *field)
     free((field->assoc)->hash);
     free(field->assoc);
     }
+  if (field->modelassoc)
+    {
+    free((field->modelassoc)->list);
+    free((field->modelassoc)->hash);
+    free(field->modelassoc);
+    field->modelassoc = NULL;
+    }
 
   return;
   }
@@ -399,3 +524,36 @@ int	do_assoc(picstruct *field, double x, double y)
   return flag;
   }
 
+
+/******************************** nearest_assoc ******************************/
+/*
+Return a pointer to the assoc-list row nearest to (x,y) within the association
+radius, or NULL if there is none.
+*/
+double	*nearest_assoc(picstruct *field, assocstruct *assoc, double x, double y)
+  {
+   double	dx,dy, dist, rad, rad2, *list, *best;
+   int		h, step, iy, nobj;
+
+  iy = (int)(y+0.499999);
+  if (iy<0 || iy>=field->height || (h=assoc->hash[iy])<0)
+    return NULL;
+  nobj = assoc->nobj;
+  step = assoc->ncol;
+  list = assoc->list + step*h;
+  rad = assoc->radius;
+  rad2 = rad*rad;
+  best = NULL;
+  for (; h++<nobj && *(list+1)-rad<y; list+=step)
+    {
+    dx = *list - x;
+    dy = *(list+1) - y;
+    if ((dist=dx*dx+dy*dy)<rad2)
+      {
+      best = list;
+      rad2 = dist;
+      }
+    }
+
+  return best;
+  }
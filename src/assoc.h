@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		12/01/2011
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -46,10 +46,16 @@ typedef struct structassoc
 
 /*------------------------------ Prototypes ---------------------------------*/
 
-assocstruct	*load_assoc(char *filename, wcsstruct *wcs);
+assocstruct	*load_assoc(char *filename, wcsstruct *wcs),
+		*load_assoccat(char *filename, char **keynames, int nkeys,
+			int ext, wcsstruct *wcs);
+
+double		*nearest_assoc(picstruct *field, assocstruct *assoc,
+			double x, double y);
 
 int		do_assoc(picstruct *field, double x, double y);
 
 void		init_assoc(picstruct *field),
 		end_assoc(picstruct *field),
+		init_modelassoc(picstruct *field),
 		sort_assoc(picstruct *field, assocstruct *assoc);
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -71,6 +71,11 @@ void	initastrom(picstruct *field)
       if (FLAG(obj2.theta1950) || FLAG(obj2.poserr_theta1950))
         j2b(wcs->equinox, wcs->ap2000, wcs->dp2000, &wcs->ap1950, &wcs->dp1950);
       }
+/*-- Tabulate pixel-to-WCS transforms for fast interpolation */
+    if (prefs.astrom_griderr > 0.0
+	&& grid_wcs(wcs, prefs.astrom_griderr) != RETURN_OK)
+      warning("Astrometric interpolation error too large: ",
+		"using exact transforms");
     }
 
 /* Override astrometric definitions only if user supplies a pixel-scale */
@@ -114,7 +119,7 @@ void	astrom_pos(picstruct *field, objstruct *obj)
     {
     rawpos[0] = obj2->posx;
     rawpos[1] = obj2->posy;
-    raw_to_wcs(wcs, rawpos, wcspos);
+    raw_to_wcsgrid(wcs, rawpos, wcspos);
     obj2->mxw = wcspos[0];
     obj2->myw = wcspos[1];
     if (lng != lat)
@@ -163,7 +168,7 @@ void	astrom_pos(picstruct *field, objstruct *obj)
     {
     rawpos[0] = obj2->posx - 0.5;
     rawpos[1] = obj2->posy - 0.5;
-    raw_to_wcs(wcs, rawpos, wcspos);
+    raw_to_wcsgrid(wcs, rawpos, wcspos);
     obj2->mamaposx = wcspos[1]*(MAMA_CORFLEX+1.0);
     obj2->mamaposy = wcspos[0]*(MAMA_CORFLEX+1.0);
     }
@@ -199,7 +204,7 @@ void	astrom_peakpos(picstruct *field, objstruct *obj)
     {
     rawpos[0] = obj->peakx;
     rawpos[1] = obj->peaky;
-    raw_to_wcs(wcs, rawpos, wcspos);
+    raw_to_wcsgrid(wcs, rawpos, wcspos);
     obj2->peakxw = wcspos[0];
     obj2->peakyw = wcspos[1];
     if (lng != lat)
@@ -254,7 +259,7 @@ void	astrom_winpos(picstruct *field, objstruct *obj)
     {
     rawpos[0] = obj2->winpos_x;
     rawpos[1] = obj2->winpos_y;
-    raw_to_wcs(wcs, rawpos, wcspos);
+    raw_to_wcsgrid(wcs, rawpos, wcspos);
     obj2->winpos_xw = wcspos[0];
     obj2->winpos_yw = wcspos[1];
     if (lng != lat)
@@ -309,7 +314,7 @@ void	astrom_psfpos(picstruct *field, objstruct *obj)
     {
     rawpos[0] = obj2->x_psf;
     rawpos[1] = obj2->y_psf;
-    raw_to_wcs(wcs, rawpos, wcspos);
+    raw_to_wcsgrid(wcs, rawpos, wcspos);
     obj2->xw_psf = wcspos[0];
     obj2->yw_psf = wcspos[1];
     if (lng != lat)
@@ -364,7 +369,7 @@ void	astrom_profpos(picstruct *field, objstruct *obj)
     {
     rawpos[0] = obj2->x_prof;
     rawpos[1] = obj2->y_prof;
-    raw_to_wcs(wcs, rawpos, wcspos);
+    raw_to_wcsgrid(wcs, rawpos, wcspos);
     obj2->xw_prof = wcspos[0];
     obj2->yw_prof = wcspos[1];
     if (lng != lat)
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		23/09/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -41,8 +41,36 @@
 #include	"fits/fitscat.h"
 #include	"back.h"
 #include	"field.h"
+#include	"pyramid.h"
 #include	"weight.h"
 
+static void		backcachename(picstruct *field, picstruct *wfield,
+				int wscale_flag, char *name,
+				char (*key)[BACK_CACHEKEYLEN]);
+static unsigned int	backcachesum(picstruct *field);
+static void		backnodes(picstruct *field, float *map, float *dmap,
+				int y, float **pnode, float **pdnode),
+			backsegline(float *coef, int stride, int n,
+				float blo, float dblo, float bhi, float dbhi,
+				PIXTYPE *line),
+			backxinterp(picstruct *field, float *node,
+				float *dnode, PIXTYPE *line),
+			makebackxcoef(picstruct *field);
+
+/* Header keywords identifying a background cache entry */
+static char		backcachekey[BACK_NCACHEKEY][9] = {"BKGDSUM ",
+				"BKGWSUM ", "BKGSETUP"},
+			backcachecomment[BACK_NCACHEKEY][40] = {
+				"Checksum of the image data",
+				"Checksum of the weight-map data",
+				"Digest of the background settings"};
+
+#ifdef VEC_X86
+static VEC_AVX2 void	backsegline_avx2(float *coef, int stride, int n,
+				float blo, float dblo, float bhi, float dbhi,
+				PIXTYPE *line);
+#endif
+
 /******************************** makeback ***********************************/
 /*
 Background maps are established from the images themselves; thus we need to
@@ -60,7 +88,7 @@ void	makeback(picstruct *field, picstruct *wfield, int wscale_flag)
 		size,meshsize;
    int		i,j,k,m,n, step, nlines,
 		w,bw, bh, nx,ny,nb,
-		lflag, nr;
+		lflag, nr, pyrflag;
    float	*ratio,*ratiop, *weight, *sigma,
 		sratio, sigfac;
 
@@ -79,6 +107,21 @@ void	makeback(picstruct *field, picstruct *wfield, int wscale_flag)
   ny = field->nbacky;
   nb = field->nback;
 
+/* Recover the maps from a previous run on the same data if possible */
+  if (prefs.backcache_flag
+	&& loadbackcache(field, wfield, wscale_flag) == RETURN_OK)
+    {
+    free(field->backline);
+    QMALLOC(field->backline, PIXTYPE, w);	/* current background line */
+    if (wfield)
+      {
+      free(wfield->backline);
+      QMALLOC(wfield->backline, PIXTYPE, w);	/* current background line */
+      }
+    makebackthresh(field);
+    return;
+    }
+
   NFPRINTF(OUTPUT, "Setting up background maps");
 
 /* Decide if it is worth displaying progress each 16 lines */
@@ -143,9 +186,15 @@ void	makeback(picstruct *field, picstruct *wfield, int wscale_flag)
     wbuf = NULL;
     }
 
+/* Use the decimated image pyramid instead of the full data if possible */
+/* Pyramid sidecar files cannot be associated with streamed images */
+  pyrflag = prefs.backpyr_flag && !is_memimage(field->filename)
+	&& !(wfield && is_memimage(wfield->filename))
+	&& pyr_back(field, wfield) == RETURN_OK;
+
 /* Loop over the data packets */
 
-  for (j=0; j<ny; j++)
+  for (j=0; j<ny && !pyrflag; j++)
     {
     if (lflag && j)
       NPRINTF(OUTPUT, "\33[1M> Setting up background map at line:%5d\n\33[1A",
@@ -384,6 +433,24 @@ void	makeback(picstruct *field, picstruct *wfield, int wscale_flag)
   NFPRINTF(OUTPUT, "Computing background-noise d-map");
   free(field->dsigma);
   field->dsigma = makebackspline(field, field->sigma);
+/* Save the maps for later runs on the same data */
+  if (prefs.backcache_flag)
+    savebackcache(field, wfield, wscale_flag);
+
+  makebackthresh(field);
+
+  return;
+  }
+
+
+/****************************** makebackthresh *******************************/
+/*
+Set the background mean and the detection/measurement thresholds from the
+background maps.
+*/
+void	makebackthresh(picstruct *field)
+
+  {
 /* If asked for, force the backmean parameter to the supplied value */
   if (field->back_type == BACK_ABSOLUTE)
     field->backmean = (float)prefs.back_val[(field->flags&DETECT_FIELD)?0:1];
@@ -436,6 +503,273 @@ void	makeback(picstruct *field, picstruct *wfield, int wscale_flag)
   }
 
 
+/****** loadbackcache ********************************************************
+PROTO	int loadbackcache(picstruct *field, picstruct *wfield, int wscale_flag)
+PURPOSE	Load the background maps of a field (and its weight-map) from the
+	background cache.
+INPUT	Pointer to the field,
+	pointer to the weight-map field (or NULL),
+	weight scaling flag.
+OUTPUT	RETURN_OK if the maps were found in the cache, RETURN_ERROR otherwise.
+NOTES	The cache entry must match the data checksums and the digest of the
+	background settings of the current run.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	loadbackcache(picstruct *field, picstruct *wfield, int wscale_flag)
+  {
+   catstruct	*cat;
+   tabstruct	*tab;
+   float	*map[BACK_NCACHEMAP];
+   char		name[MAXCHAR], key[BACK_NCACHEKEY][BACK_CACHEKEYLEN],
+		str[MAXCHAR];
+   int		k, m, nmap, t;
+
+  backcachename(field, wfield, wscale_flag, name, key);
+  if (!(cat = read_cat(name)))
+    return RETURN_ERROR;
+  tab = cat->tab;
+  for (k=0; k<BACK_NCACHEKEY; k++)
+    if (fitsread(tab->headbuf, backcachekey[k], str, H_STRING, T_STRING)
+		!= RETURN_OK || strcmp(str, key[k]))
+      {
+      free_cat(&cat, 1);
+      return RETURN_ERROR;
+      }
+
+  NFPRINTF(OUTPUT, "Loading background maps from cache");
+  nmap = wfield? BACK_NCACHEMAP : BACK_NCACHEMAP-2;
+  for (m=0; m<nmap; m++)
+    QMALLOC(map[m], float, field->nback);
+  m = 0;
+  for (t=cat->ntab-1; t-- && m<nmap;)
+    {
+    tab = tab->nexttab;
+    if (tab->naxis!=2 || tab->naxisn[0]!=field->nbackx
+	|| tab->naxisn[1]!=field->nbacky)
+      break;
+    QFSEEK(cat->file, tab->bodypos, SEEK_SET, cat->filename);
+#ifdef	HAVE_CFITSIO
+    tab->currentElement = 1;
+#endif
+    read_body(tab, map[m++], (size_t)field->nback);
+    }
+  tab = cat->tab;
+  if (m<nmap
+	|| fitsread(tab->headbuf, "BKGMEAN ", &field->backmean, H_EXPO, T_FLOAT)
+		!= RETURN_OK
+	|| fitsread(tab->headbuf, "BKGSIG  ", &field->backsig, H_EXPO, T_FLOAT)
+		!= RETURN_OK)
+    {
+    warning("Corrupted background cache file ", name);
+    for (m=0; m<nmap; m++)
+      free(map[m]);
+    free_cat(&cat, 1);
+    return RETURN_ERROR;
+    }
+
+  free(field->back);
+  field->back = map[0];
+  free(field->sigma);
+  field->sigma = map[1];
+  free(field->dback);
+  field->dback = map[2];
+  free(field->dsigma);
+  field->dsigma = map[3];
+  if (wfield)
+    {
+    free(wfield->back);
+    wfield->back = map[4];
+    free(wfield->sigma);
+    wfield->sigma = map[5];
+    fitsread(tab->headbuf, "BKGWMEAN", &wfield->backmean, H_EXPO, T_FLOAT);
+    fitsread(tab->headbuf, "BKGWSIG ", &wfield->backsig, H_EXPO, T_FLOAT);
+    fitsread(tab->headbuf, "BKGWSFAC", &wfield->sigfac, H_EXPO, T_FLOAT);
+    }
+  free_cat(&cat, 1);
+
+  return RETURN_OK;
+  }
+
+
+/****** savebackcache ********************************************************
+PROTO	void savebackcache(picstruct *field, picstruct *wfield, int wscale_flag)
+PURPOSE	Save the background maps of a field (and its weight-map) to the
+	background cache.
+INPUT	Pointer to the field,
+	pointer to the weight-map field (or NULL),
+	weight scaling flag.
+OUTPUT	-.
+NOTES	Failing to write the cache file only triggers a warning.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	savebackcache(picstruct *field, picstruct *wfield, int wscale_flag)
+  {
+   static char	extname[BACK_NCACHEMAP][16] = {"BACKGROUND", "BACK_RMS",
+			"BACK_DMAP", "BACK_RMS_DMAP",
+			"WBACKGROUND", "WBACK_RMS"};
+   catstruct	*cat;
+   tabstruct	*tab;
+   float	*map[BACK_NCACHEMAP];
+   char		name[MAXCHAR], key[BACK_NCACHEKEY][BACK_CACHEKEYLEN];
+   int		k, m, nmap;
+
+  backcachename(field, wfield, wscale_flag, name, key);
+  nmap = wfield? BACK_NCACHEMAP : BACK_NCACHEMAP-2;
+  map[0] = field->back;
+  map[1] = field->sigma;
+  map[2] = field->dback;
+  map[3] = field->dsigma;
+  if (wfield)
+    {
+    map[4] = wfield->back;
+    map[5] = wfield->sigma;
+    }
+
+  NFPRINTF(OUTPUT, "Saving background maps to cache");
+  cat = new_cat(1);
+  init_cat(cat);
+  strcpy(cat->filename, name);
+  tab = cat->tab;
+  tab->cat = cat;
+  addkeywordto_head(tab, "NEXTEND ", "Number of extensions");
+  fitswrite(tab->headbuf, "NEXTEND ", &nmap, H_INT, T_LONG);
+  for (k=0; k<BACK_NCACHEKEY; k++)
+    {
+    addkeywordto_head(tab, backcachekey[k], backcachecomment[k]);
+    fitswrite(tab->headbuf, backcachekey[k], key[k], H_STRING, T_STRING);
+    }
+  addkeywordto_head(tab, "BKGMEAN ", "Median background level");
+  fitswrite(tab->headbuf, "BKGMEAN ", &field->backmean, H_EXPO, T_FLOAT);
+  addkeywordto_head(tab, "BKGSIG  ", "Median background RMS");
+  fitswrite(tab->headbuf, "BKGSIG  ", &field->backsig, H_EXPO, T_FLOAT);
+  if (wfield)
+    {
+    addkeywordto_head(tab, "BKGWMEAN", "Median weight-map level");
+    fitswrite(tab->headbuf, "BKGWMEAN", &wfield->backmean, H_EXPO, T_FLOAT);
+    addkeywordto_head(tab, "BKGWSIG ", "Median weight-map RMS");
+    fitswrite(tab->headbuf, "BKGWSIG ", &wfield->backsig, H_EXPO, T_FLOAT);
+    addkeywordto_head(tab, "BKGWSFAC", "Weight-map scaling factor");
+    fitswrite(tab->headbuf, "BKGWSFAC", &wfield->sigfac, H_EXPO, T_FLOAT);
+    }
+  if (open_cat(cat, WRITE_ONLY) != RETURN_OK)
+    warning("Cannot save background maps to cache file ", name);
+  else
+    {
+    save_head(cat, tab);
+    ext_head(tab);
+    removekeywordfrom_head(tab, "NEXTEND ");
+    for (k=0; k<BACK_NCACHEKEY; k++)
+      removekeywordfrom_head(tab, backcachekey[k]);
+    removekeywordfrom_head(tab, "BKGMEAN ");
+    removekeywordfrom_head(tab, "BKGSIG  ");
+    removekeywordfrom_head(tab, "BKGWMEAN");
+    removekeywordfrom_head(tab, "BKGWSIG ");
+    removekeywordfrom_head(tab, "BKGWSFAC");
+    tab->bitpix = BP_FLOAT;
+    tab->bytepix = 4;
+    tab->bitsgn = 0;
+    tab->bscale = 1.0;
+    tab->bzero = 0.0;
+    tab->naxis = 2;
+    QMALLOC(tab->naxisn, int, 2);
+    tab->naxisn[0] = field->nbackx;
+    tab->naxisn[1] = field->nbacky;
+    for (m=0; m<nmap; m++)
+      {
+      strcpy(tab->extname, extname[m]);
+      save_head(cat, tab);
+      write_body(tab, map[m], (size_t)field->nback);
+      pad_tab(cat, (size_t)field->nback*sizeof(float));
+      }
+    close_cat(cat);
+    }
+  free_cat(&cat, 1);
+
+  return;
+  }
+
+
+/****** backcachename ********************************************************
+PROTO	void backcachename(picstruct *field, picstruct *wfield,
+		int wscale_flag, char *name, char (*key)[BACK_CACHEKEYLEN])
+PURPOSE	Build the filename and the identifying keys of the background cache
+	entry of a field.
+INPUT	Pointer to the field,
+	pointer to the weight-map field (or NULL),
+	weight scaling flag,
+	pointer to the output filename string (MAXCHAR long),
+	pointer to the BACK_NCACHEKEY output key strings.
+OUTPUT	-.
+NOTES	The keys are the checksums of the image and weight-map data, and a
+	64-bit digest of all the settings that affect the background maps.
+	They have a fixed length, so that they fit in FITS header values. The
+	filename is made from a hash of the keys.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	backcachename(picstruct *field, picstruct *wfield,
+			int wscale_flag, char *name, char (*key)[BACK_CACHEKEYLEN])
+  {
+   unsigned long long	digest;
+   unsigned int		hash;
+   char			setup[MAXCHAR], *pstr;
+   int			k;
+
+  sprintf(setup, "%dx%d:%dx%d:%dx%d:%.17g:%.17g:%x:%.17g:%d:%d",
+	field->width, field->height, field->backw, field->backh,
+	field->nbackfx, field->nbackfy, prefs.backfthresh, prefs.back_pearson,
+	wfield? (wfield->flags&(VAR_FIELD|WEIGHT_FIELD|RMS_FIELD)) : 0,
+	wfield? wfield->weight_thresh : 0.0, wscale_flag, prefs.backpyr_flag);
+
+/* 64-bit FNV-1a digest of the settings */
+  digest = 14695981039346656037ULL;
+  for (pstr=setup; *pstr; pstr++)
+    digest = (digest^(unsigned char)*pstr)*1099511628211ULL;
+
+  sprintf(key[0], "%08x", backcachesum(field));
+  sprintf(key[1], "%08x", wfield? backcachesum(wfield) : 0U);
+  sprintf(key[2], "%016llx", digest);
+
+/* 32-bit FNV-1a hash of the keys */
+  hash = 2166136261U;
+  for (k=0; k<BACK_NCACHEKEY; k++)
+    for (pstr=key[k]; *pstr; pstr++)
+      hash = (hash^(unsigned char)*pstr)*16777619U;
+  sprintf(name, "%s/%s%08x.fits", prefs.backcache_dir, BACK_CACHEPREFIX, hash);
+
+  return;
+  }
+
+
+/****** backcachesum *********************************************************
+PROTO	unsigned int backcachesum(picstruct *field)
+PURPOSE	Return the checksum of the data of a field.
+INPUT	Pointer to the field.
+OUTPUT	Checksum.
+NOTES	The DATASUM keyword is used if present; the checksum is computed
+	otherwise (at the cost of one pass through the data), and kept for
+	later use. The position in the image file is preserved.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static unsigned int	backcachesum(picstruct *field)
+  {
+   OFF_T2	fcurpos;
+
+  if (!field->tab->bodysum)
+    {
+    NFPRINTF(OUTPUT, "Computing data checksum");
+    QFTELL(field->file, fcurpos, field->filename);
+    field->tab->bodysum = compute_bodysum(field->tab, 0);
+    QFSEEK(field->file, fcurpos, SEEK_SET, field->filename);
+    }
+
+  return field->tab->bodysum;
+  }
+
+
 /******************************** backstat **********************************/
 /*
 Compute robust statistical estimators in a row of meshes.
@@ -1092,9 +1426,8 @@ background map vertices) and subtract it from the current line.
 void	subbackline(picstruct *field, int y, PIXTYPE *line)
 
   {
-   int		i,j,x,yl, nbx,nbxm1,nby, nx,width, ystep, changepoint;
-   float	dx,dx0,dy,dy3, cdx,cdy,cdy3, temp, xstep,
-		*node,*nodep,*dnode, *blo,*bhi,*dblo,*dbhi, *u;
+   int		j, width;
+   float	*node,*dnode;
    PIXTYPE	*backline, bval;
 
   width = field->width;
@@ -1104,123 +1437,26 @@ void	subbackline(picstruct *field, int y, PIXTYPE *line)
     {
 /*-- In absolute background mode, just subtract a cste */
     bval = field->backmean;
-    for (i=width; i--;)
+    for (j=width; j--;)
       *(line++) -= ((*backline++)=bval);
     return;
     }
 
-  nbx = field->nbackx;
-  nbxm1 = nbx - 1;
-  nby = field->nbacky;
-  if (nby > 1)
-    {
-    dy = (float)y/field->backh - 0.5;
-    dy -= (yl = (int)dy);
-    if (yl<0)
-      {
-      yl = 0;
-      dy -= 1.0;
-      }
-    else if (yl>=nby-1)
-      {
-      yl = nby<2 ? 0 : nby-2;
-      dy += 1.0;
-      }
-/*-- Interpolation along y for each node */
-    cdy = 1 - dy;
-    dy3 = (dy*dy*dy-dy);
-    cdy3 = (cdy*cdy*cdy-cdy);
-    ystep = nbx*yl;
-    blo = field->back + ystep;
-    bhi = blo + nbx;
-    dblo = field->dback + ystep;
-    dbhi = dblo + nbx;
-    QMALLOC(node, float, nbx);	/* Interpolated background */
-    nodep = node;
-    for (x=nbx; x--;)
-      *(nodep++) = cdy**(blo++) + dy**(bhi++) + cdy3**(dblo++) + dy3**(dbhi++);
-
-/*-- Computation of 2nd derivatives along x */
-    QMALLOC(dnode, float, nbx);	/* 2nd derivative along x */
-    if (nbx>1)
-      {
-      QMALLOC(u, float, nbxm1);	/* temporary array */
-      *dnode = *u = 0.0;	/* "natural" lower boundary condition */
-      nodep = node+1;
-      for (x=nbxm1; --x; nodep++)
-        {
-        temp = -1/(*(dnode++)+4);
-        *dnode = temp;
-        temp *= *(u++) - 6*(*(nodep+1)+*(nodep-1)-2**nodep);
-        *u = temp;
-        }
-      *(++dnode) = 0.0;	/* "natural" upper boundary condition */
-      for (x=nbx-2; x--;)
-        {
-        temp = *(dnode--);
-        *dnode = (*dnode*temp+*(u--))/6.0;
-        }
-      free(u);
-      dnode--;
-      }
-    }
-  else
-    {
-/*-- No interpolation and no new 2nd derivatives needed along y */
-    node = field->back;
-    dnode = field->dback;
-    }
-
-/*-- Interpolation along x */
-  if (nbx>1)
+  if (!field->backnode)
+    makebackxcoef(field);
+  backnodes(field, field->back, field->dback, y, &node, &dnode);
+  if (field->nbackx>1 && field->backw==1)
     {
-    nx = field->backw;
-    if (nx==1)		/* special handling of 1-pixel mesh sizes */
-      {
-      blo = node;
-      for (j=width; j--;)
-        *(line++) -= (*(backline++) = (PIXTYPE)*(blo++));
-      }
-    else
-      {
-      xstep = 1.0/nx;
-      changepoint = nx/2;
-      dx  = (xstep - 1)/2;	/* dx of the first pixel in the row */
-      dx0 = ((nx+1)%2)*xstep/2;	/* dx of the 1st pixel right to a bkgnd node */
-      blo = node;
-      bhi = node + 1;
-      dblo = dnode;
-      dbhi = dnode + 1;
-      for (x=i=0,j=width; j--; i++, dx += xstep)
-        {
-        if (i==changepoint && x>0 && x<nbxm1)
-          {
-          blo++;
-          bhi++;
-          dblo++;
-          dbhi++;
-          dx = dx0;
-          }
-        cdx = 1 - dx;
-        *(line++) -= (*(backline++) = (PIXTYPE)(cdx*(*blo+(cdx*cdx-1)**dblo)
-			+ dx*(*bhi+(dx*dx-1)**dbhi)));
-        if (i==nx)
-          {
-          x++;
-          i = 0;
-          }
-        }
-      }
+/*-- Special handling of 1-pixel mesh sizes */
+    for (j=width; j--;)
+      *(backline++) = (PIXTYPE)*(node++);
+    backline = field->backline;
     }
   else
-    for (j=width; j--;)
-      *(line++) -= (*(backline++) = (PIXTYPE)*node);
+    backxinterp(field, node, dnode, backline);
 
-  if (nby>1)
-    {
-    free(node);
-    free(dnode);
-    }
+  for (j=width; j--;)
+    *(line++) -= *(backline++);
 
   return;
   }
@@ -1234,16 +1470,109 @@ INPUT   Measurement or detection field pointer,
         Current line position. 
         Where to put the data. 
 OUTPUT  -.
-NOTES   Most of the code is a copy of subbackline(), for optimization reasons.
+NOTES   Shares the node interpolation and x-interpolation code with
+	subbackline().
 AUTHOR  E. Bertin (IAP & Leiden & ESO)
-VERSION 02/02/98
+VERSION 19/10/2026
  ***/
 void	backrmsline(picstruct *field, int y, PIXTYPE *line)
 
   {
-   int		i,j,x,yl, nbx,nbxm1,nby, nx,width, ystep, changepoint;
-   float	dx,dx0,dy,dy3, cdx,cdy,cdy3, temp, xstep,
-		*node,*nodep,*dnode, *blo,*bhi,*dblo,*dbhi, *u;
+   float	*node,*dnode;
+
+  if (!field->backnode)
+    makebackxcoef(field);
+  backnodes(field, field->sigma, field->dsigma, y, &node, &dnode);
+  backxinterp(field, node, dnode, line);
+
+  return;
+  }
+
+
+/****** makebackxcoef ********************************************************
+PROTO	void makebackxcoef(picstruct *field)
+PURPOSE	Tabulate the x-interpolation coefficients of the background spline,
+	and allocate the node buffers used by backnodes().
+INPUT	Pointer to the field.
+OUTPUT	-.
+NOTES	The coefficients only depend on the column, hence they are shared by
+	all the lines. They are computed with exactly the same operations as
+	the original per-pixel loop, so that interpolated values are unchanged.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	makebackxcoef(picstruct *field)
+  {
+   float	*cdxp,*cdx2p,*dxp,*dx2p,
+		dx,dx0,cdx, xstep;
+   int		i,j,s,x, nbx,nbxm1, nx,width, changepoint;
+
+  width = field->width;
+  nbx = field->nbackx;
+  nbxm1 = nbx - 1;
+  nx = field->backw;
+  QMALLOC(field->backnode, float, 3*nbx);	/* node, dnode and u */
+  QMALLOC(field->backxstart, int, nbx);
+  QMALLOC(field->backxcoef, float, 4*(size_t)width);
+  cdxp = field->backxcoef;
+  cdx2p = cdxp + width;
+  dxp = cdx2p + width;
+  dx2p = dxp + width;
+  xstep = 1.0/nx;
+  changepoint = nx/2;
+  dx  = (xstep - 1)/2;		/* dx of the first pixel in the row */
+  dx0 = ((nx+1)%2)*xstep/2;	/* dx of the 1st pixel right to a bkgnd node */
+  s = 0;
+  field->backxstart[0] = 0;
+  for (x=i=j=0; j<width; j++, i++, dx += xstep)
+    {
+    if (i==changepoint && x>0 && x<nbxm1)
+      {
+      field->backxstart[++s] = j;
+      dx = dx0;
+      }
+    cdx = 1 - dx;
+    *(cdxp++) = cdx;
+    *(cdx2p++) = cdx*cdx-1;
+    *(dxp++) = dx;
+    *(dx2p++) = dx*dx-1;
+    if (i==nx)
+      {
+      x++;
+      i = 0;
+      }
+    }
+/* Close the last segment */
+  while (s<nbxm1)
+    field->backxstart[++s] = width;
+
+  return;
+  }
+
+
+/****** backnodes ************************************************************
+PROTO	void backnodes(picstruct *field, float *map, float *dmap, int y,
+		float **pnode, float **pdnode)
+PURPOSE	Interpolate a background map and its spline 2nd derivatives along y at
+	the nodes of line y, and compute the 2nd derivatives along x.
+INPUT	Pointer to the field,
+	pointer to the map,
+	pointer to the map of 2nd derivatives along y,
+	current line position,
+	pointer to the interpolated node array (output),
+	pointer to the 2nd derivatives along x (output).
+OUTPUT	-.
+NOTES	The outputs point to the field node buffer, or to the map itself if
+	there is a single row of meshes.
+AUTHOR	E. Bertin (IAP & Leiden & ESO)
+VERSION	19/10/2026
+ ***/
+static void	backnodes(picstruct *field, float *map, float *dmap, int y,
+			float **pnode, float **pdnode)
+  {
+   int		x,yl, nbx,nbxm1,nby, ystep;
+   float	dy,dy3, cdy,cdy3, temp,
+		*node,*nodep,*dnode,*dnodep, *blo,*bhi,*dblo,*dbhi, *u;
 
   nbx = field->nbackx;
   nbxm1 = nbx - 1;
@@ -1267,91 +1596,179 @@ void	backrmsline(picstruct *field, int y, PIXTYPE *line)
     dy3 = (dy*dy*dy-dy);
     cdy3 = (cdy*cdy*cdy-cdy);
     ystep = nbx*yl;
-    blo = field->sigma + ystep;
+    blo = map + ystep;
     bhi = blo + nbx;
-    dblo = field->dsigma + ystep;
+    dblo = dmap + ystep;
     dbhi = dblo + nbx;
-    QMALLOC(node, float, nbx);	/* Interpolated background */
+    node = field->backnode;	/* Interpolated background */
+    dnode = node + nbx;		/* 2nd derivative along x */
+    u = dnode + nbx;		/* temporary array */
     nodep = node;
     for (x=nbx; x--;)
       *(nodep++) = cdy**(blo++) + dy**(bhi++) + cdy3**(dblo++) + dy3**(dbhi++);
 
 /*-- Computation of 2nd derivatives along x */
-    QMALLOC(dnode, float, nbx);	/* 2nd derivative along x */
     if (nbx>1)
       {
-      QMALLOC(u, float, nbxm1);	/* temporary array */
-      *dnode = *u = 0.0;	/* "natural" lower boundary condition */
+      dnodep = dnode;
+      *dnodep = *u = 0.0;	/* "natural" lower boundary condition */
       nodep = node+1;
       for (x=nbxm1; --x; nodep++)
         {
-        temp = -1/(*(dnode++)+4);
-        *dnode = temp;
+        temp = -1/(*(dnodep++)+4);
+        *dnodep = temp;
         temp *= *(u++) - 6*(*(nodep+1)+*(nodep-1)-2**nodep);
         *u = temp;
         }
-      *(++dnode) = 0.0;	/* "natural" upper boundary condition */
+      *(++dnodep) = 0.0;	/* "natural" upper boundary condition */
       for (x=nbx-2; x--;)
         {
-        temp = *(dnode--);
-        *dnode = (*dnode*temp+*(u--))/6.0;
+        temp = *(dnodep--);
+        *dnodep = (*dnodep*temp+*(u--))/6.0;
         }
-      free(u);
-      dnode--;
       }
     }
   else
     {
 /*-- No interpolation and no new 2nd derivatives needed along y */
-    node = field->sigma;
-    dnode = field->dsigma;
+    node = map;
+    dnode = dmap;
     }
 
-/*-- Interpolation along x */
+  *pnode = node;
+  *pdnode = dnode;
+
+  return;
+  }
+
+
+/****** backxinterp **********************************************************
+PROTO	void backxinterp(picstruct *field, float *node, float *dnode,
+		PIXTYPE *line)
+PURPOSE	Bicubic-spline interpolation along x of a line of background nodes.
+INPUT	Pointer to the field,
+	pointer to the interpolated nodes,
+	pointer to the 2nd derivatives along x,
+	pointer to the output line.
+OUTPUT	-.
+NOTES	The line is processed one mesh segment at a time, using the tabulated
+	coefficients from makebackxcoef().
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	backxinterp(picstruct *field, float *node, float *dnode,
+			PIXTYPE *line)
+  {
+   int		j,n,s, nbx,width, *start;
+
+  nbx = field->nbackx;
   width = field->width;
   if (nbx>1)
     {
-    nx = field->backw;
-    xstep = 1.0/nx;
-    changepoint = nx/2;
-    dx  = (xstep - 1)/2;	/* dx of the first pixel in the row */
-    dx0 = ((nx+1)%2)*xstep/2;	/* dx of the 1st pixel right to a bkgnd node */
-    blo = node;
-    bhi = node + 1;
-    dblo = dnode;
-    dbhi = dnode + 1;
-    for (x=i=0,j=width; j--; i++, dx += xstep)
-      {
-      if (i==changepoint && x>0 && x<nbxm1)
-        {
-        blo++;
-        bhi++;
-        dblo++;
-        dbhi++;
-        dx = dx0;
-        }
-      cdx = 1 - dx;
-      *(line++) = (PIXTYPE)(cdx*(*blo+(cdx*cdx-1)**dblo)
-			+ dx*(*bhi+(dx*dx-1)**dbhi));
-      if (i==nx)
+    start = field->backxstart;
+    for (s=0; s<nbx-1; s++)
+      if ((n = start[s+1] - (j=start[s])) > 0)
         {
-        x++;
-        i = 0;
+#ifdef VEC_X86
+        if (vec_getlevel() >= VEC_LEVEL_AVX2)
+          backsegline_avx2(field->backxcoef+j, width, n, node[s], dnode[s],
+		node[s+1], dnode[s+1], line+j);
+        else
+#endif
+          backsegline(field->backxcoef+j, width, n, node[s], dnode[s],
+		node[s+1], dnode[s+1], line+j);
         }
-      }
     }
   else
     for (j=width; j--;)
       *(line++) = (PIXTYPE)*node;
 
-  if (nby>1)
+  return;
+  }
+
+
+/****** backsegline **********************************************************
+PROTO	void backsegline(float *coef, int stride, int n, float blo, float dblo,
+		float bhi, float dbhi, PIXTYPE *line)
+PURPOSE	Interpolate the background spline between two nodes.
+INPUT	Pointer to the first cdx coefficient of the segment,
+	stride between the 4 coefficient arrays,
+	number of pixels,
+	lower node value,
+	lower node 2nd derivative,
+	upper node value,
+	upper node 2nd derivative,
+	pointer to the output line.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	backsegline(float *coef, int stride, int n, float blo, float dblo,
+			float bhi, float dbhi, PIXTYPE *line)
+  {
+   float	*cdx,*cdx2,*dx,*dx2;
+
+  cdx = coef;
+  cdx2 = cdx + stride;
+  dx = cdx2 + stride;
+  dx2 = dx + stride;
+  while (n--)
+    *(line++) = (PIXTYPE)(*(cdx++)*(blo+*(cdx2++)*dblo)
+			+ *(dx++)*(bhi+*(dx2++)*dbhi));
+
+  return;
+  }
+
+
+#ifdef VEC_X86
+/****** backsegline_avx2 *****************************************************
+PROTO	void backsegline_avx2(float *coef, int stride, int n, float blo,
+		float dblo, float bhi, float dbhi, PIXTYPE *line)
+PURPOSE	AVX2 version of backsegline().
+INPUT	Pointer to the first cdx coefficient of the segment,
+	stride between the 4 coefficient arrays,
+	number of pixels,
+	lower node value,
+	lower node 2nd derivative,
+	upper node value,
+	upper node 2nd derivative,
+	pointer to the output line.
+OUTPUT	-.
+NOTES	FMA contraction is avoided to reproduce exactly the scalar results.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static VEC_AVX2 void	backsegline_avx2(float *coef, int stride, int n,
+			float blo, float dblo, float bhi, float dbhi,
+			PIXTYPE *line)
+  {
+   __m256	vblo,vdblo,vbhi,vdbhi, vlo,vhi;
+   float	*cdx,*cdx2,*dx,*dx2;
+
+  cdx = coef;
+  cdx2 = cdx + stride;
+  dx = cdx2 + stride;
+  dx2 = dx + stride;
+  vblo = _mm256_set1_ps(blo);
+  vdblo = _mm256_set1_ps(dblo);
+  vbhi = _mm256_set1_ps(bhi);
+  vdbhi = _mm256_set1_ps(dbhi);
+  for (; n>=8; n-=8, cdx+=8, cdx2+=8, dx+=8, dx2+=8, line+=8)
     {
-    free(node);
-    free(dnode);
+    vlo = _mm256_mul_ps(_mm256_loadu_ps(cdx), _mm256_add_ps(vblo,
+		_mm256_mul_ps(_mm256_loadu_ps(cdx2), vdblo)));
+    vhi = _mm256_mul_ps(_mm256_loadu_ps(dx), _mm256_add_ps(vbhi,
+		_mm256_mul_ps(_mm256_loadu_ps(dx2), vdbhi)));
+    _mm256_storeu_ps(line, _mm256_add_ps(vlo, vhi));
     }
+  while (n--)
+    *(line++) = (PIXTYPE)(*(cdx++)*(blo+*(cdx2++)*dblo)
+			+ *(dx++)*(bhi+*(dx2++)*dbhi));
 
   return;
   }
+#endif
 
 
 /********************************* copyback **********************************/
@@ -1383,6 +1800,9 @@ void	endback(picstruct *field)
   free(field->sigma);
   free(field->dsigma);
   free(field->backline);
+  free(field->backnode);
+  free(field->backxstart);
+  free(field->backxcoef);
 
   return;
   }
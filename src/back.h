@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		09/03/2011
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -34,6 +34,11 @@
 #define	QUANTIF_NMAXLEVELS	4096		/* max nb of quantif. levels */
 #define	QUANTIF_AMIN		4		/* min nb of "mode pixels" */
 
+#define	BACK_NCACHEMAP		6		/* nb of maps in bkgnd cache */
+#define	BACK_CACHEPREFIX	"bkg_"		/* bkgnd cache file prefix */
+#define	BACK_NCACHEKEY		3		/* nb of bkgnd cache keys */
+#define	BACK_CACHEKEYLEN	20		/* max length of a cache key */
+
 #define	BACK_WSCALE		1		/* Activate weight scaling */
 #define	BACK_NOWSCALE		0		/* No weight scaling */
 
@@ -66,8 +71,12 @@ void		backhisto(backstruct *, backstruct *, PIXTYPE *, PIXTYPE *,
 		endback(picstruct *),
 		filterback(picstruct *),
 		makeback(picstruct *, picstruct *, int),
+		makebackthresh(picstruct *),
+		savebackcache(picstruct *, picstruct *, int),
 		subbackline(picstruct *, int, PIXTYPE *);
 
+int		loadbackcache(picstruct *, picstruct *, int);
+
 float		backguess(backstruct *, float *, float *),
 		localback(picstruct *, objstruct *),
 		*makebackspline(picstruct *, float *);
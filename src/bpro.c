@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -40,6 +40,15 @@
 #include	"fits/fitscat.h"
 #include	"bpro.h"
 
+#ifdef VEC_X86
+static VEC_AVX2 void	bpann_layer_avx2(NFLOAT *weight, NFLOAT *neuroni,
+			int nni, NFLOAT *neuronj, int nnj, int nb, int lflag);
+#endif
+
+static void		bpann_layer(NFLOAT *weight, NFLOAT *neuroni, int nni,
+			NFLOAT *neuronj, int nnj, int nb, int lflag);
+static NFLOAT		bpann_sigmoid(NFLOAT u);
+
 /******************************** play_bpann *********************************/
 /*
 Single forward pass through the ANN.
@@ -73,6 +82,213 @@ void	play_bpann(bpannstruct *bpann, NFLOAT *invec, NFLOAT *outvec)
   }
 
 
+/****************************** play_bpannbatch ******************************/
+/*
+Forward pass through the ANN for nvec input vectors, stored one after the
+other in invec; the output vectors are stored the same way in outvec.
+Vectors are processed in batches of BPANN_NBATCH, with neuron values stored
+with the batch index varying fastest: each layer then becomes a small
+matrix-matrix product with unit-stride inner loops.
+Hidden layer activations use bpann_sigmoid() instead of SIGMOID().
+*/
+void	play_bpannbatch(bpannstruct *bpann, NFLOAT *invec, int nvec,
+			NFLOAT *outvec)
+  {
+   NFLOAT	*neuron;
+   int		i,l,v, ll, nb, nin,nout;
+
+  ll = bpann->nlayers-1;
+  nin = bpann->nn[0];
+  nout = bpann->nn[ll];
+  for (; nvec>0; nvec-=nb, invec+=nb*nin, outvec+=nb*nout)
+    {
+    nb = nvec<BPANN_NBATCH? nvec : BPANN_NBATCH;
+/*-- Transpose the input vectors */
+    neuron = bpann->bneuron[0];
+    for (i=0; i<nin; i++, neuron+=BPANN_NBATCH)
+      for (v=0; v<nb; v++)
+        neuron[v] = invec[v*nin+i];
+    for (l=1; l<=ll; l++)
+      {
+#ifdef VEC_X86
+      if (vec_getlevel() >= VEC_LEVEL_AVX2)
+        bpann_layer_avx2(bpann->weight[l-1], bpann->bneuron[l-1], bpann->nn[l-1],
+		bpann->bneuron[l], bpann->nn[l], nb,
+		l==ll && bpann->linearoutflag);
+      else
+#endif
+        bpann_layer(bpann->weight[l-1], bpann->bneuron[l-1], bpann->nn[l-1],
+		bpann->bneuron[l], bpann->nn[l], nb,
+		l==ll && bpann->linearoutflag);
+      }
+/*-- Transpose the output vectors back */
+    neuron = bpann->bneuron[ll];
+    for (i=0; i<nout; i++, neuron+=BPANN_NBATCH)
+      for (v=0; v<nb; v++)
+        outvec[v*nout+i] = neuron[v];
+    }
+
+  return;
+  }
+
+
+/******************************** bpann_layer ********************************/
+/*
+Propagate a batch of nb vectors from one layer (with nni neurons plus the
+"bias" neuron) to the next one (nnj neurons). The summation order is that of
+play_bpann().
+*/
+static void	bpann_layer(NFLOAT *weight, NFLOAT *neuroni, int nni,
+			NFLOAT *neuronj, int nnj, int nb, int lflag)
+  {
+   NFLOAT	u[BPANN_NBATCH],
+		*ni, w;
+   int		i,j,v;
+
+  for (j=0; j<nnj; j++, neuronj+=BPANN_NBATCH)
+    {
+    ni = neuroni;
+    w = *(weight++);
+    for (v=0; v<BPANN_NBATCH; v++)
+      u[v] = w*ni[v];
+    for (i=nni; i--;)		/* The last one is the bias */
+      {
+      ni += BPANN_NBATCH;
+      w = *(weight++);
+      for (v=0; v<BPANN_NBATCH; v++)
+        u[v] += w*ni[v];
+      }
+    if (lflag)
+      for (v=0; v<nb; v++)
+        neuronj[v] = u[v];
+    else
+      for (v=0; v<nb; v++)
+        neuronj[v] = bpann_sigmoid(u[v]);
+    }
+
+  return;
+  }
+
+
+/******************************* bpann_sigmoid *******************************/
+/*
+Activation function of batched layers. The exponential is a Cephes-like
+polynomial approximation (relative error < 2e-7) that the SIMD code reproduces
+exactly.
+*/
+static NFLOAT	bpann_sigmoid(NFLOAT u)
+  {
+   union {float f; int i;}	y2n;
+   NFLOAT	x, fx, y;
+
+  if (u>=15.0f)
+    return 1.0f;
+  if (u<=-15.0f)
+    return 0.0f;
+  x = -u;
+  fx = floorf(x*1.44269504088896341f + 0.5f);
+  x = x - fx*0.693359375f;
+  x = x - fx*(-2.12194440e-4f);
+  y = 1.9875691500e-4f;
+  y = y*x + 1.3981999507e-3f;
+  y = y*x + 8.3334519073e-3f;
+  y = y*x + 4.1665795894e-2f;
+  y = y*x + 1.6666665459e-1f;
+  y = y*x + 5.0000001201e-1f;
+  y = y*(x*x) + x;
+  y = y + 1.0f;
+/* Multiply by 2^fx through the exponent bits */
+  y2n.f = y;
+  y2n.i += ((int)fx)<<23;
+  return 1.0f/(1.0f+y2n.f);
+  }
+
+
+#ifdef VEC_X86
+/***************************** bpann_layer_avx2 ******************************/
+/*
+AVX2 version of bpann_layer(), processing 8 vectors of the batch at a time.
+Results are identical to those of the scalar code.
+*/
+static VEC_AVX2 void	bpann_layer_avx2(NFLOAT *weight, NFLOAT *neuroni,
+			int nni, NFLOAT *neuronj, int nnj, int nb, int lflag)
+  {
+   __m256	vu, vw, vx, vfx, vy, vlo, vhi;
+   __m256i	vn;
+   NFLOAT	*ni, *wt;
+   int		i,j,v, nb8;
+
+  nb8 = (nb/8)*8;
+  for (j=0; j<nnj; j++, neuronj+=BPANN_NBATCH, weight+=nni+1)
+    {
+    for (v=0; v<nb8; v+=8)
+      {
+      wt = weight;
+      ni = neuroni + v;
+      vu = _mm256_mul_ps(_mm256_set1_ps(*(wt++)), _mm256_loadu_ps(ni));
+      for (i=nni; i--;)
+        {
+        ni += BPANN_NBATCH;
+        vw = _mm256_set1_ps(*(wt++));
+        vu = _mm256_add_ps(vu, _mm256_mul_ps(vw, _mm256_loadu_ps(ni)));
+        }
+      if (!lflag)
+        {
+        vlo = _mm256_cmp_ps(vu, _mm256_set1_ps(-15.0f), _CMP_LE_OQ);
+        vhi = _mm256_cmp_ps(vu, _mm256_set1_ps(15.0f), _CMP_GE_OQ);
+        vx = _mm256_sub_ps(_mm256_setzero_ps(), vu);
+        vx = _mm256_min_ps(_mm256_max_ps(vx, _mm256_set1_ps(-15.0f)),
+		_mm256_set1_ps(15.0f));
+        vfx = _mm256_floor_ps(_mm256_add_ps(
+		_mm256_mul_ps(vx, _mm256_set1_ps(1.44269504088896341f)),
+		_mm256_set1_ps(0.5f)));
+        vx = _mm256_sub_ps(vx, _mm256_mul_ps(vfx, _mm256_set1_ps(0.693359375f)));
+        vx = _mm256_sub_ps(vx,
+		_mm256_mul_ps(vfx, _mm256_set1_ps(-2.12194440e-4f)));
+        vy = _mm256_set1_ps(1.9875691500e-4f);
+        vy = _mm256_add_ps(_mm256_mul_ps(vy, vx),
+		_mm256_set1_ps(1.3981999507e-3f));
+        vy = _mm256_add_ps(_mm256_mul_ps(vy, vx),
+		_mm256_set1_ps(8.3334519073e-3f));
+        vy = _mm256_add_ps(_mm256_mul_ps(vy, vx),
+		_mm256_set1_ps(4.1665795894e-2f));
+        vy = _mm256_add_ps(_mm256_mul_ps(vy, vx),
+		_mm256_set1_ps(1.6666665459e-1f));
+        vy = _mm256_add_ps(_mm256_mul_ps(vy, vx),
+		_mm256_set1_ps(5.0000001201e-1f));
+        vy = _mm256_add_ps(_mm256_mul_ps(vy, _mm256_mul_ps(vx, vx)), vx);
+        vy = _mm256_add_ps(vy, _mm256_set1_ps(1.0f));
+/*------ Multiply by 2^n through the exponent bits */
+        vn = _mm256_slli_epi32(_mm256_cvtps_epi32(vfx), 23);
+        vy = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_castps_si256(vy), vn));
+        vu = _mm256_div_ps(_mm256_set1_ps(1.0f),
+		_mm256_add_ps(_mm256_set1_ps(1.0f), vy));
+        vu = _mm256_blendv_ps(vu, _mm256_setzero_ps(), vlo);
+        vu = _mm256_blendv_ps(vu, _mm256_set1_ps(1.0f), vhi);
+        }
+      _mm256_storeu_ps(neuronj+v, vu);
+      }
+/*-- Leftovers */
+    for (; v<nb; v++)
+      {
+      wt = weight;
+      ni = neuroni + v;
+      neuronj[v] = *(wt++)**ni;
+      for (i=nni; i--;)
+        {
+        ni += BPANN_NBATCH;
+        neuronj[v] += *(wt++)**ni;
+        }
+      if (!lflag)
+        neuronj[v] = bpann_sigmoid(neuronj[v]);
+      }
+    }
+
+  return;
+  }
+#endif
+
+
 /******************************* loadtab_bpann *******************************/
 /*
 Load the relevant ANN structure (using the LDACTools).
@@ -82,7 +298,7 @@ bpannstruct	*loadtab_bpann(tabstruct *tab, char *filename)
    bpannstruct	*bpann;
    keystruct	*key;
    char		*head, str[80];
-   int		l;
+   int		i,l;
 
 /* OK, we now allocate memory for the ANN structure itself */
   QCALLOC(bpann, bpannstruct, 1);
@@ -112,6 +328,15 @@ bpannstruct	*loadtab_bpann(tabstruct *tab, char *filename)
 
   QMALLOC(bpann->neuron[l], NFLOAT, bpann->nn[l]); /* no bias in this layer */
 
+/* Batch buffers: the "bias" neurons are set once for all */
+  QMALLOC(bpann->bneuron, NFLOAT *, bpann->nlayers);
+  for (l=0; l<bpann->nlayers; l++)
+    {
+    QCALLOC(bpann->bneuron[l], NFLOAT, (bpann->nn[l]+1)*BPANN_NBATCH);
+    for (i=0; i<BPANN_NBATCH; i++)
+      bpann->bneuron[l][bpann->nn[l]*BPANN_NBATCH+i] = -1.0;
+    }
+
   return bpann;
   }
 
@@ -133,6 +358,10 @@ void    free_bpann(bpannstruct *bpann)
 
   free(bpann->neuron[i]);       /* Because of the input layer */
 
+  for (i=0; i<bpann->nlayers; i++)
+    free(bpann->bneuron[i]);
+  free(bpann->bneuron);
+
 /* Then free pointers of pointers */
   free(bpann->neuron);
   free(bpann->weight);
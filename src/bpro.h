@@ -23,13 +23,14 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 /*------------------------------- definitions -------------------------------*/
 #define	SIGMOID(u)	((u)<15.0?((u)>-15.0?1/(1+expf(-(u))):0.0):1.0)
 				/* In-line activation function */
+#define	BPANN_NBATCH	64	/* Nb of vectors processed together in batches*/
 
 /*---------------------------------- types ----------------------------------*/
 typedef	float	NFLOAT;		/* Floating point units for neural data */
@@ -43,6 +44,8 @@ typedef	struct structbpann
 	NFLOAT	**neuron;		/* Neuron array (layer,pos in layer) */
 	NFLOAT	**weight;		/* Weight array (layer,pos in layer) */
 	int	linearoutflag;		/* Flag: 0 if outputs are non-linear */
+/*------ Batch buffers (pos in layer,vector in batch) */
+	NFLOAT	**bneuron;		/* Neuron arrays for batches */
 	}	bpannstruct;
 
 
@@ -51,5 +54,7 @@ typedef	struct structbpann
 bpannstruct	*loadtab_bpann(tabstruct *tab, char *filename);
 
 void		free_bpann(bpannstruct *bpann),
-		play_bpann(bpannstruct *bpann, NFLOAT *invec, NFLOAT *outvec);
+		play_bpann(bpannstruct *bpann, NFLOAT *invec, NFLOAT *outvec),
+		play_bpannbatch(bpannstruct *bpann, NFLOAT *invec, int nvec,
+			NFLOAT *outvec);
 
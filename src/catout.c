@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		26/02/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -40,11 +40,18 @@
 #include	"prefs.h"
 #include	"fits/fitscat.h"
 #include	"param.h"
+#include	"paramdep.h"
 #include	"sexhead.h"
 #include	"sexhead1.h"
 #include	"sexheadsc.h"
 #include	"xml.h"
 
+#define	MEMCAT_NOBJ	256	/* Initial number of objects in memory catalogs */
+
+static void	initmemcat(void),
+		resolveparamdeps(void),
+		writememcat(void);
+
 objstruct	outobj, flagobj;
 obj2struct	outobj2, flagobj2;
 
@@ -53,10 +60,54 @@ tabstruct	*objtab = NULL;
 FILE		*ascfile;
 char		*buf;
 int		catopen_flag = 0;
+static sexlibcatstruct	*memcat = NULL;
+static int	memcat_nobjmax;
 
 double		ddummy;
 int		idummy;
 
+/****************************** resetcatparams *******************************/
+/*
+Restore the catalog parameter definitions and measurement flags to their
+initial state, so that another catalog can be set up within the same process.
+The first call only saves the initial state.
+*/
+void	resetcatparams(void)
+  {
+   static keystruct	*objkey0 = NULL;
+   static int		nobjkey;
+   keystruct		*key;
+
+  if (!objkey0)
+    {
+    for (nobjkey=0; *objkey[nobjkey].name; nobjkey++);
+    nobjkey++;
+    QMALLOC(objkey0, keystruct, nobjkey);
+    memcpy(objkey0, objkey, nobjkey*sizeof(keystruct));
+    return;
+    }
+
+/* Free the arrays and table of the previous catalog if endcat() did not */
+  for (key=objkey; *key->name; key++)
+    if (key->naxis && key->allocflag)
+      free(key->ptr);
+  if (objtab)
+    {
+    objtab->key = NULL;
+    objtab->nkey = 0;
+    free_tab(objtab);
+    objtab = NULL;
+    }
+  memcpy(objkey, objkey0, nobjkey*sizeof(keystruct));
+  memset(&outobj, 0, sizeof(outobj));
+  memset(&outobj2, 0, sizeof(outobj2));
+  memset(&flagobj, 0, sizeof(flagobj));
+  memset(&flagobj2, 0, sizeof(flagobj2));
+
+  return;
+  }
+
+
 /******************************* readcatparams *******************************/
 /*
 Read the catalog config file
@@ -179,270 +230,31 @@ void	changecatparamarrays(char *keyword, int *axisn, int naxis)
 
 /***************************** updateparamflags ******************************/
 /*
-Update parameter flags according to their mutual dependencies.
+Set the flags of all the measurements required by the requested parameters.
 */
 void	updateparamflags()
 
   {
    int	i;
 
-/*----------------------------- Model-fitting -----------------------------*/
-
   prefs.pattern_flag |= FLAG(obj2.prof_disk_patternvector)
 			| FLAG(obj2.prof_disk_patternmodvector)
 			| FLAG(obj2.prof_disk_patternargvector)
 			| FLAG(obj2.prof_disk_patternspiral);
   FLAG(obj2.prof_disk_scale) |= prefs.pattern_flag;
+  if (prefs.assoccoord_type==ASSOCCOORD_WORLD)
+    FLAG(obj2.mxw) |= FLAG(obj2.assoc) | FLAG(obj2.assoc_number);
+  for (i=1; i<NISO; i++)
+    FLAG(obj.iso[0]) |= FLAG(obj.iso[i]);
 
-  FLAG(obj2.prof_concentration) |= FLAG(obj2.prof_concentrationerr);
-  FLAG(obj2.fluxcorerr_prof) |= FLAG(obj2.magcorerr_prof);
-  FLAG(obj2.fluxcor_prof) |= FLAG(obj2.magcor_prof)
-			| FLAG(obj2.fluxcorerr_prof);
-
-  FLAG(obj2.poserraw_prof) |= FLAG(obj2.poserrbw_prof);
-  FLAG(obj2.poserrcxxw_prof) |= FLAG(obj2.poserrcyyw_prof)
-			| FLAG(obj2.poserrcxyw_prof);
-  FLAG(obj2.poserrthetas_prof) |= FLAG(obj2.poserrtheta1950_prof)
-				| FLAG(obj2.poserrtheta2000_prof);
-  FLAG(obj2.poserrthetaw_prof) |= FLAG(obj2.poserrthetas_prof);
-
-  FLAG(obj2.poserrmx2w_prof) |= FLAG(obj2.poserrmy2w_prof)
-			| FLAG(obj2.poserrmxyw_prof)
-			| FLAG(obj2.poserrthetaw_prof)|FLAG(obj2.poserraw_prof)
-			| FLAG(obj2.poserrcxxw_prof);
-
-  FLAG(obj2.poserra_prof) |= FLAG(obj2.poserrb_prof)
-			| FLAG(obj2.poserrtheta_prof)
-			| FLAG(obj2.poserraw_prof);
-  FLAG(obj2.poserrcxx_prof) |= FLAG(obj2.poserrcyy_prof)
-			| FLAG(obj2.poserrcxy_prof);
-  FLAG(obj2.poserrmx2_prof) |= FLAG(obj2.poserrmy2_prof)
-			| FLAG(obj2.poserrmxy_prof)
-			| FLAG(obj2.poserrmx2w_prof);
-  FLAG(obj2.alpha1950_prof) |= FLAG(obj2.delta1950_prof)
-			| FLAG(obj2.poserrtheta1950_prof);
-  FLAG(obj2.alpha2000_prof) |= FLAG(obj2.delta2000_prof)
-			| FLAG(obj2.alpha1950_prof)
-			| FLAG(obj2.poserrtheta2000_prof);
-  FLAG(obj2.alphas_prof) |= FLAG(obj2.deltas_prof)
-			| FLAG(obj2.alpha2000_prof);
-  FLAG(obj2.xw_prof) |= FLAG(obj2.yw_prof)
-			| FLAG(obj2.alphas_prof);
-  FLAG(obj2.xf_prof) |= FLAG(obj2.yf_prof);
-  FLAG(obj2.x_prof) |= FLAG(obj2.y_prof)
-			| FLAG(obj2.xw_prof)
-			| FLAG(obj2.xf_prof)
-			| FLAG(obj2.poserra_prof)
-			| FLAG(obj2.poserrcxx_prof)
-			| FLAG(obj2.poserrmx2_prof)
-			| FLAG(obj2.prof_concentration)
-			| FLAG(obj2.prof_class_star)
-			| FLAG(obj2.fluxcor_prof);
-
-  FLAG(obj2.prof_dirac_fluxratio) |= FLAG(obj2.prof_dirac_fluxratioerr);
-  FLAG(obj2.prof_dirac_mag) |= FLAG(obj2.prof_dirac_magerr);
-  FLAG(obj2.prof_spheroid_fluxratio) |= FLAG(obj2.prof_spheroid_fluxratioerr);
-  FLAG(obj2.prof_spheroid_mag) |= FLAG(obj2.prof_spheroid_magerr);
-  FLAG(obj2.prof_spheroid_reff) |= FLAG(obj2.prof_spheroid_refferr);
-  FLAG(obj2.prof_spheroid_aspect) |= FLAG(obj2.prof_spheroid_aspecterr);
-  FLAG(obj2.prof_spheroid_theta) |= FLAG(obj2.prof_spheroid_thetaerr);
-  FLAG(obj2.prof_spheroid_sersicn) |= FLAG(obj2.prof_spheroid_sersicnerr);
-  FLAG(obj2.prof_disk_fluxratio) |= FLAG(obj2.prof_disk_fluxratioerr);
-  FLAG(obj2.prof_disk_mag) |= FLAG(obj2.prof_disk_magerr);
-  FLAG(obj2.prof_disk_scale) |= FLAG(obj2.prof_disk_scaleerr);
-  FLAG(obj2.prof_disk_aspect) |= FLAG(obj2.prof_disk_aspecterr);
-  FLAG(obj2.prof_disk_inclination) |= FLAG(obj2.prof_disk_inclinationerr);
-  FLAG(obj2.prof_disk_theta) |= FLAG(obj2.prof_disk_thetaerr);
-  FLAG(obj2.prof_bar_fluxratio) |= FLAG(obj2.prof_bar_fluxratioerr);
-  FLAG(obj2.prof_bar_mag) |= FLAG(obj2.prof_bar_magerr);
-  FLAG(obj2.prof_bar_length) |= FLAG(obj2.prof_bar_lengtherr);
-  FLAG(obj2.prof_bar_aspect) |= FLAG(obj2.prof_bar_aspecterr);
-  FLAG(obj2.prof_bar_theta) |= FLAG(obj2.prof_bar_thetaerr);
-  FLAG(obj2.prof_arms_fluxratio) |= FLAG(obj2.prof_arms_fluxratioerr);
-  FLAG(obj2.prof_arms_mag) |= FLAG(obj2.prof_arms_magerr);
-  FLAG(obj2.prof_e1errw) |= FLAG(obj2.prof_e2errw) | FLAG(obj2.prof_e12corrw);
-  FLAG(obj2.prof_e1w) |= FLAG(obj2.prof_e2w) | FLAG(obj2.prof_e1errw);
-  FLAG(obj2.prof_pol1errw) |= FLAG(obj2.prof_pol2errw)
-			| FLAG(obj2.prof_pol12corrw);
-  FLAG(obj2.prof_pol1w) |= FLAG(obj2.prof_pol2w) | FLAG(obj2.prof_pol1errw);
-  FLAG(obj2.prof_aw) |= FLAG(obj2.prof_bw);
-  FLAG(obj2.prof_cxxw) |= FLAG(obj2.prof_cyyw) | FLAG(obj2.prof_cxyw);
-  FLAG(obj2.prof_thetas) |= FLAG(obj2.prof_theta1950)
-			| FLAG(obj2.prof_theta2000);
-  FLAG(obj2.prof_thetaw) |= FLAG(obj2.prof_thetas);
-
-  FLAG(obj2.prof_mx2w) |= FLAG(obj2.prof_my2w)
-			| FLAG(obj2.prof_mxyw)
-			| FLAG(obj2.prof_thetaw) | FLAG(obj2.prof_aw)
-			| FLAG(obj2.prof_cxxw)
-			| FLAG(obj2.prof_e1w) | FLAG(obj2.prof_pol1w);
-
-  FLAG(obj2.dtheta1950) |= FLAG(obj2.prof_theta1950)
-			| FLAG(obj2.prof_spheroid_theta1950)
-			| FLAG(obj2.prof_disk_theta1950)
-//			| FLAG(obj2.prof_arms_theta1950)
-			| FLAG(obj2.prof_bar_theta1950)
-			| FLAG(obj2.poserrtheta1950_psf)
-			| FLAG(obj2.win_theta1950)
-			| FLAG(obj2.winposerr_theta1950)
-			| FLAG(obj2.poserr_theta1950)
-			| FLAG(obj2.theta1950)
-			| FLAG(obj2.poserrtheta1950_prof);
-  FLAG(obj2.dtheta2000) |= FLAG(obj2.prof_theta2000)
-			| FLAG(obj2.prof_spheroid_theta2000)
-			| FLAG(obj2.prof_disk_theta2000)
-//			| FLAG(obj2.prof_arms_theta2000)
-			| FLAG(obj2.prof_bar_theta2000)
-			| FLAG(obj2.poserrtheta2000_psf)
-			| FLAG(obj2.win_theta2000)
-			| FLAG(obj2.winposerr_theta2000)
-			| FLAG(obj2.poserr_theta2000)
-			| FLAG(obj2.theta2000)
-			| FLAG(obj2.poserrtheta2000_prof);
-
-
-  FLAG(obj2.prof_spheroid_thetas) |= FLAG(obj2.prof_spheroid_theta2000)
-			| FLAG(obj2.prof_spheroid_theta1950);
-  FLAG(obj2.prof_spheroid_thetaw) |= FLAG(obj2.prof_spheroid_thetas);
-  FLAG(obj2.prof_disk_thetas) |= FLAG(obj2.prof_disk_theta2000)
-			| FLAG(obj2.prof_disk_theta1950);
-  FLAG(obj2.prof_disk_thetaw) |= FLAG(obj2.prof_disk_thetas);
-  FLAG(obj2.prof_bar_thetas) |= FLAG(obj2.prof_bar_theta2000)
-			| FLAG(obj2.prof_bar_theta1950);
-  FLAG(obj2.prof_bar_thetaw) |= FLAG(obj2.prof_bar_thetas);
-/*
-  FLAG(obj2.prof_arms_thetaw) |= FLAG(obj2.prof_arms_thetas)
-			| FLAG(obj2.prof_arms_theta2000)
-			| FLAG(obj2.prof_arms_theta1950);
-*/
-  FLAG(obj2.prof_arms_scalew) |= FLAG(obj2.prof_arms_startw)
-			| FLAG(obj2.prof_arms_scaleerrw)
-			| FLAG(obj2.prof_arms_starterrw);
-
-  FLAG(obj2.prof_bar_lengthw) |= FLAG(obj2.prof_bar_aspectw)
-			| FLAG(obj2.prof_bar_thetaw)
-			| FLAG(obj2.prof_bar_lengtherrw)
-			| FLAG(obj2.prof_bar_aspecterrw)
-			| FLAG(obj2.prof_bar_thetaerrw);
-
-  FLAG(obj2.prof_disk_scalew) |= FLAG(obj2.prof_disk_aspectw)
-			| FLAG(obj2.prof_disk_thetaw)
-			| FLAG(obj2.prof_disk_scaleerrw)
-			| FLAG(obj2.prof_disk_aspecterrw)
-			| FLAG(obj2.prof_disk_thetaerrw)
-			| FLAG(obj2.prof_arms_scalew);
-  FLAG(obj2.prof_disk_fluxmean) |= FLAG(obj2.prof_disk_mumean);
-  FLAG(obj2.prof_disk_fluxeff) |= FLAG(obj2.prof_disk_mueff);
-  FLAG(obj2.prof_disk_peak) |= FLAG(obj2.prof_disk_mumax)
-				| FLAG(obj2.prof_disk_fluxeff)
-				| FLAG(obj2.prof_disk_fluxmean);
-
-  FLAG(obj2.prof_spheroid_reffw) |= FLAG(obj2.prof_spheroid_aspectw)
-			| FLAG(obj2.prof_spheroid_thetaw)
-			| FLAG(obj2.prof_spheroid_refferrw)
-			| FLAG(obj2.prof_spheroid_aspecterrw)
-			| FLAG(obj2.prof_spheroid_thetaerrw);
-
-  FLAG(obj2.prof_spheroid_fluxmean) |= FLAG(obj2.prof_spheroid_mumean);
-  FLAG(obj2.prof_spheroid_fluxeff) |= FLAG(obj2.prof_spheroid_mueff);
-  FLAG(obj2.prof_spheroid_peak) |= FLAG(obj2.prof_spheroid_mumax)
-				| FLAG(obj2.prof_spheroid_fluxeff)
-				| FLAG(obj2.prof_spheroid_fluxmean);
-
-  FLAG(obj2.prof_flagw) |= FLAG(obj2.prof_spheroid_reffw)
-			| FLAG(obj2.prof_disk_scalew)
-			| FLAG(obj2.prof_bar_lengthw)
-			| FLAG(obj2.prof_arms_scalew)
-			| FLAG(obj2.prof_mx2w);
-
-  FLAG(obj2.prof_e1err) |= FLAG(obj2.prof_e2err) | FLAG(obj2.prof_e12corr)
-			| FLAG(obj2.prof_e1errw);
-			
-  FLAG(obj2.prof_e1) |= FLAG(obj2.prof_e2)
-			| FLAG(obj2.prof_e1err) | FLAG(obj2.prof_e1w);
-  FLAG(obj2.prof_pol1err) |= FLAG(obj2.prof_pol2err)
-			| FLAG(obj2.prof_pol12corr) | FLAG(obj2.prof_pol1errw);
-  FLAG(obj2.prof_pol1) |= FLAG(obj2.prof_pol2)
-			| FLAG(obj2.prof_pol1err) | FLAG(obj2.prof_pol1w);
-  FLAG(obj2.prof_a) |= FLAG(obj2.prof_b) | FLAG(obj2.prof_theta)
-			| FLAG(obj2.prof_aw);
-  FLAG(obj2.prof_cxx) |= FLAG(obj2.prof_cyy)
-			| FLAG(obj2.prof_cxy) | FLAG(obj2.prof_cxxw);
-  FLAG(obj2.prof_mx2) |= FLAG(obj2.prof_my2) | FLAG(obj2.prof_mxy)
-			| FLAG(obj2.prof_e1) | FLAG(obj2.prof_pol1)
-			| FLAG(obj2.prof_a) | FLAG(obj2.prof_cxx)
-			| FLAG(obj2.prof_mx2w);
-  FLAG(obj2.prof_conva) |= FLAG(obj2.prof_convb) | FLAG(obj2.prof_convtheta);
-  FLAG(obj2.prof_convcxx) |= FLAG(obj2.prof_convcyy)
-			/*| FLAG(obj2.fluxcor_prof) */;
-  FLAG(obj2.prof_convmx2) |= FLAG(obj2.prof_convcxx) | FLAG(obj2.prof_conva);
-  FLAG(obj2.fluxmean_prof) |= FLAG(obj2.mumean_prof);
-  FLAG(obj2.peak_prof) |= FLAG(obj2.mumax_prof);
-  FLAG(obj2.fluxeff_prof) |= FLAG(obj2.mueff_prof)
-			| FLAG(obj2.fluxmean_prof) | FLAG(obj2.peak_prof);
-
-  FLAG(obj2.prof_arms_flux) |= FLAG(obj2.prof_arms_fluxerr)
-			| FLAG(obj2.prof_arms_mag)
-			| FLAG(obj2.prof_arms_fluxratio)
-			| FLAG(obj2.prof_arms_scalew)
-			| FLAG(obj2.prof_arms_scale)
-			| FLAG(obj2.prof_arms_posang)
-			| FLAG(obj2.prof_arms_pitch)
-			| FLAG(obj2.prof_arms_start)
-			| FLAG(obj2.prof_arms_quadfrac);
-  FLAG(obj2.prof_bar_theta) |= FLAG(obj2.prof_bar_lengthw);
-  FLAG(obj2.prof_bar_flux) |= FLAG(obj2.prof_bar_fluxerr)
-			| FLAG(obj2.prof_bar_mag)
-			| FLAG(obj2.prof_bar_fluxratio)
-			| FLAG(obj2.prof_bar_lengthw)
-			| FLAG(obj2.prof_bar_length)
-			| FLAG(obj2.prof_bar_aspect)
-			| FLAG(obj2.prof_bar_posang)
-			| FLAG(obj2.prof_bar_theta)
-			| FLAG(obj2.prof_arms_flux);
-  FLAG(obj2.prof_disk_flux) |= FLAG(obj2.prof_disk_fluxerr)
-			| FLAG(obj2.prof_disk_mag)
-			| FLAG(obj2.prof_disk_fluxratio)
-			| FLAG(obj2.prof_disk_scalew)
-			| FLAG(obj2.prof_disk_scale)
-			| FLAG(obj2.prof_disk_aspect)
-			| FLAG(obj2.prof_disk_inclination)
-			| FLAG(obj2.prof_disk_theta)
-			| FLAG(obj2.prof_disk_peak)
-			| FLAG(obj2.prof_bar_flux);
-  FLAG(obj2.prof_spheroid_flux) |= FLAG(obj2.prof_spheroid_fluxerr)
-			| FLAG(obj2.prof_spheroid_mag)
-			| FLAG(obj2.prof_spheroid_fluxratio)
-			| FLAG(obj2.prof_spheroid_reffw)
-			| FLAG(obj2.prof_spheroid_reff)
-			| FLAG(obj2.prof_spheroid_aspect)
-			| FLAG(obj2.prof_spheroid_theta)
-			| FLAG(obj2.prof_spheroid_sersicn)
-			| FLAG(obj2.prof_spheroid_peak);
-  FLAG(obj2.prof_dirac_flux) |= FLAG(obj2.prof_dirac_fluxerr)
-			| FLAG(obj2.prof_dirac_mag)
-			| FLAG(obj2.prof_dirac_fluxratio);
-  FLAG(obj2.prof_offset_flux) |= FLAG(obj2.prof_offset_fluxerr);
-  FLAG(obj2.fluxerr_dprof) |= FLAG(obj2.magerr_dprof);
-  FLAG(obj2.flux_dprof) |= FLAG(obj2.mag_dprof)
-			| FLAG(obj2.fluxerr_dprof);
+  resolveparamdeps();
+
+/*------------------------------ Model-fitting ------------------------------*/
   prefs.dprof_flag |= FLAG(obj2.dprof_chi2)
 			| FLAG(obj2.dprof_flag)
 			| FLAG(obj2.dprof_niter)
 			| FLAG(obj2.flux_dprof);
 
-  FLAG(obj2.fluxerr_prof) |= FLAG(obj2.magerr_prof)
-			| FLAG(obj2.prof_concentrationerr)
-			| FLAG(obj2.fluxcorerr_prof)
-			| FLAG(obj2.prof_arms_fluxratio)
-			| FLAG(obj2.prof_bar_fluxratio)
-			| FLAG(obj2.prof_disk_fluxratio)
-			| FLAG(obj2.prof_spheroid_fluxratio)
-			| FLAG(obj2.prof_dirac_fluxratio);
-  FLAG(obj2.flux_prof) |= FLAG(obj2.mag_prof)
-			| FLAG(obj2.fluxerr_prof)
-			| FLAG(obj2.fluxcor_prof);
-
   prefs.prof_flag |= FLAG(obj2.prof_chi2) | FLAG(obj2.prof_niter)
 			| FLAG(obj2.prof_vector) | FLAG(obj2.prof_errvector)
 			| FLAG(obj2.prof_errmatrix)
@@ -457,230 +269,50 @@ void	updateparamflags()
 			| FLAG(obj2.prof_offset_flux)
 			| prefs.dprof_flag;
 
-
-/* If only global parameters are requested, fit a Sersic model */
-  if (prefs.prof_flag && !(FLAG(obj2.prof_spheroid_flux)
+  if (prefs.prof_flag)
+    {
+/*-- If only global parameters are requested, fit a Sersic model */
+    if (!(FLAG(obj2.prof_spheroid_flux)
 			| FLAG(obj2.prof_disk_flux)
 			| FLAG(obj2.prof_dirac_flux)
 			| FLAG(obj2.prof_offset_flux)))
-    {
-    FLAG(obj2.prof_spheroid_flux) |= prefs.prof_flag;
-    FLAG(obj2.prof_spheroid_sersicn) |= prefs.prof_flag;
+      FLAG(obj2.prof_spheroid_flux) = FLAG(obj2.prof_spheroid_sersicn) = 1;
+/*-- Model-fitting is initialized with the half-light radius */
+    FLAG(obj2.hl_radius) = 1;
+    resolveparamdeps();
     }
 
+  return; 
+  }
 
-/*------------------------------ Astrometry ---------------------------------*/
-  FLAG(obj2.win_aw) |= FLAG(obj2.win_bw) | FLAG(obj2.win_polarw);
-  FLAG(obj2.win_cxxw) |= FLAG(obj2.win_cyyw) | FLAG(obj2.win_cxyw);
-  FLAG(obj2.win_thetas) |= FLAG(obj2.win_theta1950)
-			| FLAG(obj2.win_theta2000);
-  FLAG(obj2.win_thetaw) |= FLAG(obj2.win_thetas);
-
-  FLAG(obj2.win_mx2w) |= FLAG(obj2.win_my2w)
-			| FLAG(obj2.win_mxyw)
-			| FLAG(obj2.win_thetaw) | FLAG(obj2.win_aw)
-			| FLAG(obj2.win_cxxw);
-
-  FLAG(obj2.win_a) |= FLAG(obj2.win_b) | FLAG(obj2.win_theta)
-			| FLAG(obj2.win_polar) | FLAG(obj2.win_aw);
-  FLAG(obj2.win_cxx) |= FLAG(obj2.win_cyy)
-			| FLAG(obj2.win_cxy) | FLAG(obj2.win_cxxw);
-  FLAG(obj2.win_mx2) |= FLAG(obj2.win_my2)
-			| FLAG(obj2.win_mxy)
-			| FLAG(obj2.win_a) | FLAG(obj2.win_cxx)
-			| FLAG(obj2.win_mx2w);
-
-  FLAG(obj2.winposerr_aw) |= FLAG(obj2.winposerr_bw);
-  FLAG(obj2.winposerr_cxxw) |= FLAG(obj2.winposerr_cyyw)
-			| FLAG(obj2.winposerr_cxyw);
-  FLAG(obj2.winposerr_thetas) |= FLAG(obj2.winposerr_theta1950)
-			| FLAG(obj2.winposerr_theta2000);
-  FLAG(obj2.winposerr_thetaw) |= FLAG(obj2.winposerr_thetas);
-
-  FLAG(obj2.winposerr_mx2w) |= FLAG(obj2.winposerr_my2w)
-			| FLAG(obj2.winposerr_mxyw)
-			| FLAG(obj2.winposerr_thetaw) | FLAG(obj2.winposerr_aw)
-			| FLAG(obj2.winposerr_cxxw);
-
-  FLAG(obj2.winposerr_a) |= FLAG(obj2.winposerr_b) | FLAG(obj2.winposerr_theta);
-  FLAG(obj2.winposerr_cxx) |= FLAG(obj2.winposerr_cyy)
-			| FLAG(obj2.winposerr_cxy);
-  FLAG(obj2.winposerr_mx2) |= FLAG(obj2.winposerr_my2)
-			| FLAG(obj2.winposerr_mxy)
-			| FLAG(obj2.winposerr_a) | FLAG(obj2.winposerr_cxx)
-			| FLAG(obj2.winposerr_mx2w);
-
-  FLAG(obj2.winpos_alpha1950) |= FLAG(obj2.winpos_delta1950)
-			| FLAG(obj2.win_theta1950)
-			| FLAG(obj2.winposerr_theta1950);
-  FLAG(obj2.winpos_alpha2000) |= FLAG(obj2.winpos_delta2000)
-			| FLAG(obj2.winpos_alpha1950)
-			| FLAG(obj2.win_theta2000)
-			| FLAG(obj2.winposerr_theta2000);
-  FLAG(obj2.winpos_alphas) |= FLAG(obj2.winpos_deltas)
-			| FLAG(obj2.winpos_alpha2000);
-  FLAG(obj2.winpos_xf) |= FLAG(obj2.winpos_yf);
-  FLAG(obj2.winpos_xw) |= FLAG(obj2.winpos_yw)
-			| FLAG(obj2.winpos_alphas);
-
-  FLAG(obj2.poserr_aw) |= FLAG(obj2.poserr_bw);
-  FLAG(obj2.poserr_cxxw) |= FLAG(obj2.poserr_cyyw) | FLAG(obj2.poserr_cxyw);
-  FLAG(obj2.poserr_thetas) |= FLAG(obj2.poserr_theta1950)
-				| FLAG(obj2.poserr_theta2000);
-  FLAG(obj2.poserr_thetaw) |= FLAG(obj2.poserr_thetas);
-
-  FLAG(obj2.poserr_mx2w) |= FLAG(obj2.poserr_my2w) | FLAG(obj2.poserr_mxyw)
-			| FLAG(obj2.poserr_thetaw) | FLAG(obj2.poserr_aw)
-			| FLAG(obj2.poserr_cxxw);
-
-  FLAG(obj2.poserr_a) |= FLAG(obj2.poserr_b) | FLAG(obj2.poserr_theta)
-			| FLAG(obj2.winposerr_a);
-  FLAG(obj2.poserr_cxx) |= FLAG(obj2.poserr_cyy) | FLAG(obj2.poserr_cxy);
-  FLAG(obj.poserr_mx2) |= FLAG(obj.poserr_my2) | FLAG(obj.poserr_mxy)
-			| FLAG(obj2.poserr_a) | FLAG(obj2.poserr_cxx)
-			| FLAG(obj2.poserr_mx2w) | FLAG(obj2.winposerr_mx2);
-
-  FLAG(obj2.peakalpha1950) |= FLAG(obj2.peakdelta1950);
-  FLAG(obj2.alpha1950) |= FLAG(obj2.delta1950) |  FLAG(obj2.theta1950)
-			| FLAG(obj2.poserr_theta1950) | FLAG(obj2.dtheta1950);
-;
-  FLAG(obj2.peakalpha2000) |= FLAG(obj2.peakdelta2000)
-			| FLAG(obj2.peakalpha1950);
-  FLAG(obj2.alpha2000) |= FLAG(obj2.delta2000) | FLAG(obj2.alpha1950)
-			| FLAG(obj2.dtheta2000);
-  FLAG(obj2.peakalphas) |= FLAG(obj2.peakdeltas) | FLAG(obj2.peakalpha2000);
-  FLAG(obj2.alphas) |= FLAG(obj2.deltas) | FLAG(obj2.alpha2000);
-  FLAG(obj2.thetas) |= FLAG(obj2.theta1950) | FLAG(obj2.theta2000);
-  FLAG(obj2.thetaw) |= FLAG(obj2.thetas);
-  FLAG(obj2.aw) |= FLAG(obj2.bw) | FLAG(obj2.polarw);
-  FLAG(obj2.cxxw) |= FLAG(obj2.cyyw) | FLAG(obj2.cxyw);
-
-  FLAG(obj2.mx2w) |= FLAG(obj2.my2w) | FLAG(obj2.mxyw)
-			| FLAG(obj2.thetaw) | FLAG(obj2.aw) | FLAG(obj2.cxxw);
-  
-  FLAG(obj2.peakxw) |= FLAG(obj2.peakyf);
-  FLAG(obj2.peakxw) |= FLAG(obj2.peakyw) | FLAG(obj2.peakalphas);
-  FLAG(obj.peakx) |= FLAG(obj.peaky) | FLAG(obj2.peakxw) | FLAG(obj2.peakxf);
-
-  FLAG(obj2.mxf) |= FLAG(obj2.myf);
-
-  FLAG(obj2.mxw) |= FLAG(obj2.myw) | FLAG(obj2.mx2w) | FLAG(obj2.alphas)
-		| FLAG(obj2.poserr_mx2w)
-		| ((FLAG(obj2.assoc) | FLAG(obj2.assoc_number))
-			&& (prefs.assoccoord_type==ASSOCCOORD_WORLD));
-  FLAG(obj2.mamaposx) |= FLAG(obj2.mamaposy);
-  FLAG(obj2.fluxerr_win) |= FLAG(obj2.snr_win);
-  FLAG(obj2.flux_win) |= FLAG(obj2.mag_win)|FLAG(obj2.magerr_win)
-			| FLAG(obj2.flux_win) | FLAG(obj2.fluxerr_win);
-  FLAG(obj2.winpos_dgeox) |= FLAG(obj2.winpos_dgeoy);
-  FLAG(obj2.winpos_x) |= FLAG(obj2.winpos_y) | FLAG(obj2.winpos_dgeox)
-			| FLAG(obj2.winposerr_mx2) | FLAG(obj2.win_mx2)
-			| FLAG(obj2.winpos_xw) | FLAG(obj2.winpos_xf)
-			| FLAG(obj2.win_flag)
-			| FLAG(obj2.flux_win) |FLAG(obj2.winpos_niter);
-
-  FLAG(obj2.area_flagw) |= FLAG(obj2.npixw) | FLAG(obj2.fdnpixw)
-			| FLAG(obj2.fwhmw)
-			| FLAG(obj2.maxmu) | FLAG(obj2.threshmu)
-			| FLAG(obj2.prof_spheroid_mumax)
-			| FLAG(obj2.prof_disk_mumax)
-			| FLAG(obj2.mumax_prof);
-
-/*------------------------------ Photometry ---------------------------------*/
-
-  FLAG(obj2.fluxerr_best) |= FLAG(obj2.magerr_best);
-
-  FLAG(obj2.flux_best) |= FLAG(obj2.mag_best) | FLAG(obj2.fluxerr_best);
-
-  FLAG(obj2.hl_radius) |= FLAG(obj2.winpos_x) | prefs.prof_flag;
-
-  FLAG(obj2.flux_auto)  |= FLAG(obj2.mag_auto) | FLAG(obj2.magerr_auto)
-			| FLAG(obj2.fluxerr_auto)
-			| FLAG(obj2.kronfactor)
-			| FLAG(obj2.flux_best)
-			| FLAG(obj2.flux_radius)
-			| FLAG(obj2.hl_radius)
-			| FLAG(obj2.fluxcor_prof);
-  FLAG(obj2.flux_petro) |= FLAG(obj2.mag_petro) | FLAG(obj2.magerr_petro)
-			| FLAG(obj2.fluxerr_petro)
-			| FLAG(obj2.petrofactor);
-
-  FLAG(obj2.fluxerr_isocor) |= FLAG(obj2.magerr_isocor)
-				| FLAG(obj2.fluxerr_best);
-
-  FLAG(obj2.flux_isocor) |= FLAG(obj2.mag_isocor) | FLAG(obj2.fluxerr_isocor)
-			 | FLAG(obj2.flux_best);
-
-  FLAG(obj2.flux_aper) |= FLAG(obj2.mag_aper)|FLAG(obj2.magerr_aper)
-			    | FLAG(obj2.fluxerr_aper);
-
-  FLAG(obj2.flux_galfit) |= FLAG(obj2.mag_galfit) | FLAG(obj2.magerr_galfit)
-			    | FLAG(obj2.fluxerr_galfit);
-
-/*---------------------------- External flags -------------------------------*/
-  VECFLAG(obj.imaflag) |= VECFLAG(obj.imanflag);
-
-/*------------------------------ PSF-fitting --------------------------------*/
-  FLAG(obj2.fwhm_psf) |= FLAG(obj2.fwhmw_psf);
-  FLAG(obj2.poserraw_psf) |= FLAG(obj2.poserrbw_psf);
-  FLAG(obj2.poserrcxxw_psf) |= FLAG(obj2.poserrcyyw_psf)
-			| FLAG(obj2.poserrcxyw_psf);
-  FLAG(obj2.poserrthetas_psf) |= FLAG(obj2.poserrtheta1950_psf)
-				| FLAG(obj2.poserrtheta2000_psf);
-  FLAG(obj2.poserrthetaw_psf) |= FLAG(obj2.poserrthetas_psf);
-
-  FLAG(obj2.poserrmx2w_psf) |= FLAG(obj2.poserrmy2w_psf)
-			| FLAG(obj2.poserrmxyw_psf)
-			| FLAG(obj2.poserrthetaw_psf) | FLAG(obj2.poserraw_psf)
-			| FLAG(obj2.poserrcxxw_psf);
-
-  FLAG(obj2.poserra_psf) |= FLAG(obj2.poserrb_psf)
-			| FLAG(obj2.poserrtheta_psf);
-  FLAG(obj2.poserrcxx_psf) |= FLAG(obj2.poserrcyy_psf)
-			| FLAG(obj2.poserrcxy_psf);
-  FLAG(obj2.poserrmx2_psf) |= FLAG(obj2.poserrmy2_psf)
-			| FLAG(obj2.poserrmxy_psf)
-			| FLAG(obj2.poserra_psf) | FLAG(obj2.poserrcxx_psf)
-			| FLAG(obj2.poserrmx2w_psf);
-
-  FLAG(obj2.alpha1950_psf) |= FLAG(obj2.delta1950_psf)
-			| FLAG(obj2.poserrtheta1950_psf);
-  FLAG(obj2.alpha2000_psf) |= FLAG(obj2.delta2000_psf)
-			| FLAG(obj2.alpha1950_psf)
-			| FLAG(obj2.poserrtheta2000_psf);
-  FLAG(obj2.alphas_psf) |= FLAG(obj2.deltas_psf) | FLAG(obj2.alpha2000_psf);
-
-  FLAG(obj2.xw_psf) |= FLAG(obj2.yw_psf) | FLAG(obj2.poserrmx2w_psf)
-			| FLAG(obj2.alphas_psf);
-
-  FLAG(obj2.fluxerr_psf) |= FLAG(obj2.poserrmx2_psf) | FLAG(obj2.magerr_psf);
-
-  FLAG(obj2.mx2_pc) |= FLAG(obj2.my2_pc) | FLAG(obj2.mxy_pc)
-			| FLAG(obj2.a_pc) | FLAG(obj2.b_pc)
-			| FLAG(obj2.theta_pc) | FLAG(obj2.vector_pc)
-			| FLAG(obj2.gdposang) | FLAG(obj2.gdscale)
-			| FLAG(obj2.gdaspect) | FLAG(obj2.flux_galfit)
-			| FLAG(obj2.gde1) | FLAG(obj2.gde2)
-			| FLAG(obj2.gbposang) | FLAG(obj2.gbscale)
-			| FLAG(obj2.gbaspect) | FLAG(obj2.gbratio);
-
-  FLAG(obj2.flux_psf) |= FLAG(obj2.mag_psf) | FLAG(obj2.x_psf)
-			| FLAG(obj2.y_psf) | FLAG(obj2.xw_psf)
-			| FLAG(obj2.fluxerr_psf)
-			| FLAG(obj2.niter_psf)
-			| FLAG(obj2.chi2_psf)
-			| FLAG(obj2.mx2_pc);
-
-/*-------------------------------- Others -----------------------------------*/
-  FLAG(obj.fwhm) |= FLAG(obj2.fwhmw);
-
-  FLAG(obj.iso[0]) |= FLAG(obj2.sprob);
-  for (i=0; i<NISO; i++)
-    FLAG(obj.iso[0]) |= FLAG(obj.iso[i]);
 
-  FLAG(obj.wflag) |= FLAG(obj.nzwpix) | FLAG(obj.nzdwpix);
+/***************************** resolveparamdeps ******************************/
+/*
+Propagate measurement flags through the dependency graph (paramdep.h) until
+every measurement required, directly or not, by a flagged one is flagged.
+*/
+static void	resolveparamdeps(void)
 
-  return; 
+  {
+   paramdepstruct	*dep;
+   char			**by;
+   int			changeflag;
+
+  do
+    {
+    changeflag = 0;
+    for (dep=paramdep; dep->flag; dep++)
+      if (!*dep->flag)
+        for (by=dep->by; *by; by++)
+          if (**by)
+            {
+            *dep->flag = (char)'\1';
+            changeflag = 1;
+            break;
+            }
+    } while (changeflag);
+
+  return;
   }
 
 
@@ -717,7 +349,9 @@ void	initcat(void)
     return;
 
   update_tab(objtab);
-  if (prefs.cat_type == ASCII_HEAD || prefs.cat_type == ASCII ||
+  if (prefs.cat_type == CAT_MEMORY)
+    initmemcat();
+  else if (prefs.cat_type == ASCII_HEAD || prefs.cat_type == ASCII ||
 	prefs.cat_type == ASCII_SKYCAT || prefs.cat_type == ASCII_VO)
     {
     if (prefs.pipe_flag)
@@ -861,7 +495,8 @@ void	reinitcat(picstruct *field)
     return;
 
   if (prefs.cat_type != ASCII_HEAD && prefs.cat_type != ASCII &&
-	prefs.cat_type != ASCII_SKYCAT && prefs.cat_type != ASCII_VO)
+	prefs.cat_type != ASCII_SKYCAT && prefs.cat_type != ASCII_VO
+	&& prefs.cat_type != CAT_MEMORY)
     {
     update_tab(objtab);
     switch(prefs.cat_type)
@@ -971,6 +606,10 @@ void	writecat(int n, objliststruct *objlist)
       voprint_obj(ascfile, objtab);
       break;
 
+    case CAT_MEMORY:
+      writememcat();
+      break;
+
     case CAT_NONE:
       break;
 
@@ -1040,7 +679,10 @@ void	endcat(char *error)
   key = objtab->key;
   for (i=objtab->nkey; i--; key=key->nextkey)
     if (key->naxis && key->allocflag)
+      {
       free(key->ptr);
+      key->allocflag = 0;
+      }
 
   objtab->key = NULL;
   objtab->nkey = 0;
@@ -1051,6 +693,91 @@ void	endcat(char *error)
   }
 
 
+/******************************** initmemcat *********************************/
+/*
+Set up an in-memory catalog with one column per measurement parameter.
+*/
+static void	initmemcat(void)
+  {
+   keystruct		*key;
+   sexlibcolstruct	*col;
+   int			i;
+
+  if (memcat)
+    sexlib_freecat(memcat);
+  QCALLOC(memcat, sexlibcatstruct, 1);
+  memcat->ncol = objtab->nkey;
+  QCALLOC(memcat->col, sexlibcolstruct, memcat->ncol);
+  memcat_nobjmax = 0;
+  key = objtab->key;
+  for (i=memcat->ncol, col=memcat->col; i--; key=key->nextkey, col++)
+    {
+    strcpy(col->name, key->name);
+    strcpy(col->unit, key->unit);
+    switch(key->ttype)
+      {
+      case T_BYTE:	col->type = SEXLIB_BYTE; break;
+      case T_SHORT:	col->type = SEXLIB_SHORT; break;
+      case T_LONG:	col->type = SEXLIB_INT; break;
+      case T_LONGLONG:	col->type = SEXLIB_LONGLONG; break;
+      case T_FLOAT:	col->type = SEXLIB_FLOAT; break;
+      case T_DOUBLE:	col->type = SEXLIB_DOUBLE; break;
+      case T_STRING:	col->type = SEXLIB_STRING; break;
+      default:		error(EXIT_FAILURE,
+			"*Internal Error*: Unknown datatype in ",
+			"initmemcat()");
+      }
+    col->nbytes = key->nbytes;
+    col->nelem = key->nbytes/t_size[key->ttype];
+    }
+
+  return;
+  }
+
+
+/******************************** writememcat ********************************/
+/*
+Append the current object to the in-memory catalog.
+*/
+static void	writememcat(void)
+  {
+   keystruct		*key;
+   sexlibcolstruct	*col;
+   int			i;
+
+  if (memcat->nobj >= memcat_nobjmax)
+    {
+    memcat_nobjmax = memcat_nobjmax? 2*memcat_nobjmax : MEMCAT_NOBJ;
+    for (i=memcat->ncol, col=memcat->col; i--; col++)
+      QREALLOC(col->data, char, (size_t)memcat_nobjmax*col->nbytes);
+    }
+
+  key = objtab->key;
+  for (i=memcat->ncol, col=memcat->col; i--; key=key->nextkey, col++)
+    memcpy((char *)col->data + (size_t)memcat->nobj*col->nbytes, key->ptr,
+		col->nbytes);
+  memcat->nobj++;
+
+  return;
+  }
+
+
+/********************************* getmemcat *********************************/
+/*
+Return the in-memory catalog built by the last run, which then belongs to the
+caller.
+*/
+sexlibcatstruct	*getmemcat(void)
+  {
+   sexlibcatstruct	*cat;
+
+  cat = memcat;
+  memcat = NULL;
+
+  return cat;
+  }
+
+
 /******************************** reendcat ***********************************/
 /*
 Terminate the catalog output.
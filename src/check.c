@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		25/02/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -41,6 +41,8 @@
 #include	"fitswcs.h"
 #include	"check.h"
 
+static void	*alloc_checkpix(checkstruct *check);
+
 /********************************* addcheck **********************************/
 /*
 Add a PSF to a CHECK-image (with a multiplicative factor).
@@ -478,7 +480,7 @@ void	reinitcheck(picstruct *field, checkstruct *check)
       tab->naxisn[1] = check->height = field->height;
       check->npix = field->npix;
       check->overlay = 30*field->backsig;
-      QCALLOC(check->pix, PIXTYPE, check->npix);
+      check->pix = alloc_checkpix(check);
       save_head(cat, cat->tab);
       break;
 
@@ -489,7 +491,7 @@ void	reinitcheck(picstruct *field, checkstruct *check)
       tab->naxisn[0] = check->width = field->width;
       tab->naxisn[1] = check->height = field->height;
       check->npix = field->npix;
-      QCALLOC(check->pix, ULONG, check->npix);
+      check->pix = alloc_checkpix(check);
       save_head(cat, cat->tab);
       break;
 
@@ -514,7 +516,7 @@ void	reinitcheck(picstruct *field, checkstruct *check)
       tab->naxisn[0] = check->width = field->width;
       tab->naxisn[1] = check->height = field->height;
       check->npix = field->npix;
-      QMALLOC(check->pix, PIXTYPE, check->npix);
+      check->pix = alloc_checkpix(check);
 /*---- Initialize the pixmap to IEEE NaN */
       memset(check->pix, 0xFF, check->npix*sizeof(LONG));
       save_head(cat, cat->tab);
@@ -566,8 +568,8 @@ void	reinitcheck(picstruct *field, checkstruct *check)
       tab->naxisn[0] = check->width = field->width;
       tab->naxisn[1] = check->height = field->height;
       check->npix = field->npix;
-      QMALLOC(ptrf, PIXTYPE, check->npix);
-      check->pix = (void *)ptrf;
+      check->pix = alloc_checkpix(check);
+      ptrf = (PIXTYPE *)check->pix;
       for (i=check->npix; i--;)
         *(ptrf++) = -10.0;
       save_head(cat, cat->tab);
@@ -580,7 +582,7 @@ void	reinitcheck(picstruct *field, checkstruct *check)
       tab->naxisn[0] = check->width;
       tab->naxisn[1] = check->height;
       check->npix = check->width*check->height;
-      QCALLOC(check->pix, PIXTYPE, check->npix);
+      check->pix = alloc_checkpix(check);
       save_head(cat, cat->tab);
       break;
 
@@ -686,13 +688,15 @@ void	reendcheck(picstruct *field, checkstruct *check)
     case CHECK_PATTERNS:
     case CHECK_MAPSOM:
     case CHECK_OTHER:
+      prefetch_vmem(check->pix, check->npix*sizeof(PIXTYPE), check->swapname);
       write_body(cat->tab, check->pix, check->npix);
-      free(check->pix);
+      free_vmem(check->pix, check->npix*sizeof(PIXTYPE), check->swapname);
       break;
 
     case CHECK_SEGMENTATION:
+      prefetch_vmem(check->pix, check->npix*sizeof(ULONG), check->swapname);
       write_ibody(cat->tab, check->pix, check->npix);
-      free(check->pix);
+      free_vmem(check->pix, check->npix*sizeof(ULONG), check->swapname);
       break;
 
     case CHECK_MASK:
@@ -728,6 +732,24 @@ void	reendcheck(picstruct *field, checkstruct *check)
   return;
   }
 
+/******************************* alloc_checkpix ******************************/
+/*
+Allocate a zero-filled, full-frame check-image pixmap, in RAM or in a swap
+file beyond MEM_MAX.
+*/
+static void	*alloc_checkpix(checkstruct *check)
+
+  {
+   void		*pix;
+
+  if (!(pix = alloc_vmem(check->npix*sizeof(PIXTYPE), check->swapname)))
+    error(EXIT_FAILURE, "*Error*: not enough memory or swap space for ",
+	check->cat->filename);
+
+  return pix;
+  }
+
+
 /********************************* endcheck **********************************/
 /*
 close check-image.
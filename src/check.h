@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		26/02/2013
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -53,6 +53,7 @@ typedef struct structcheck
   PIXTYPE	overlay;		/* intensity of the overlayed plots */
   void		*line;			/* buffered image line */
   checkenum	type;			/* CHECKIMAGE_TYPE */
+  char		swapname[MAXCHAR];	/* swap file of the pixmap, if any */
   }	checkstruct;
 
 /*------------------------------- functions ---------------------------------*/
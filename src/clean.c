@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -41,11 +41,15 @@
 #include	"clean.h"
 #include	"flag.h"
 #include	"image.h"
+#include	"psf.h"
+#include	"profit.h"
 
 /*------------------------------- variables ---------------------------------*/
 
 static LONG		*cleanvictim;
 
+extern profitstruct	*theprofit;
+
 objliststruct	*cleanobjlist;
 
 /******************************* initclean **********************************
@@ -96,7 +100,7 @@ INPUT   Object number,
 OUTPUT  0 if the object was CLEANed, 1 otherwise.
 NOTES   -.
 AUTHOR  E. Bertin (IAP, Leiden & ESO)
-VERSION 08/02/2001
+VERSION 19/10/2026
  ***/
 int	clean(picstruct *field, picstruct *dfield, int objnb,
 		objliststruct *objlistin)
@@ -185,6 +189,11 @@ int	clean(picstruct *field, picstruct *dfield, int objnb,
         free(obj->dblank);
         }
       }
+#ifdef USE_MODEL
+/*-- The victim will never be measured: release its joint model fits */
+    if (prefs.prof_flag && prefs.model_blendflag)
+      profit_blenddrop(theprofit, obj);
+#endif
     subcleanobj(k);
     }
 
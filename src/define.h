@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		07/09/2022
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -64,7 +64,9 @@
 #define	MAXPICSIZE		1048576		/* max. image size */
 #define	NISO			8		/* number of isophotes */
 #define	OUTPUT			stderr		/* where all msgs are sent */
+#define	PREFETCH_SIZE		4194304		/* read-ahead per image stream */
 #define PSF_NPSFMAX		9		/* Max number of fitted PSFs */
+#define	STREAM_MAXRAM		268435456	/* max. RAM for streamed images */
 
 #ifndef PI
 #define	PI			3.1415926535898	/* never met before? */
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -179,6 +179,15 @@ int	lutz(objliststruct *objlistroot, int nroot, objstruct *objparent,
 
     for (xl=stx; xl<=enx; xl++)
       {
+/*---- Outside segments, skip unmarked pixels below threshold in one go */
+      if (cs == NONOBJECT)
+        {
+        for (xl2=xl; xl2<enx && !marker[xl2]
+		&& ((inewsymbol=iscan[xl2-xl]) < 0
+		|| PLISTPIX(plistin+inewsymbol, cdvalue) <= thresh); xl2++);
+        iscan += xl2-xl;
+        xl = xl2;
+        }
       newmarker = marker[xl];
       marker[xl] = 0;
       if ((inewsymbol = (xl!=enx)?*(iscan++):-1) < 0)
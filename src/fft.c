@@ -24,7 +24,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		19/06/2017
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -47,8 +47,8 @@
 #include "threads.h"
 #endif
 
- fftwf_plan	fplan, bplan;
- int    	firsttimeflag;
+ fftwf_plan	fplan, bplan, fmplan, bmplan;
+ int    	firsttimeflag, nfmplan, nbmplan;
 
 #ifdef USE_THREADS
  pthread_mutex_t	fftmutex;
@@ -112,7 +112,7 @@ INPUT	-.
 OUTPUT	-.
 NOTES	-.
 AUTHOR	E. Bertin (IAP)
-VERSION	08/10/2009
+VERSION	19/10/2026
  ***/
 void    fft_reset(void)
  {
@@ -123,7 +123,12 @@ void    fft_reset(void)
     }
   if (bplan)
     fftwf_destroy_plan(bplan);
-  fplan = bplan = NULL;
+  if (fmplan)
+    fftwf_destroy_plan(fmplan);
+  if (bmplan)
+    fftwf_destroy_plan(bmplan);
+  fplan = bplan = fmplan = bmplan = NULL;
+  nfmplan = nbmplan = 0;
 
   return;
   }
@@ -189,6 +194,85 @@ void    fft_conv(float *data1, float *fdata2, int *size)
   }
 
 
+/****** fft_rtfmany ********************************************************
+PROTO	void fft_rtfmany(float *data, float *fdata, int n, int *size)
+PURPOSE	Batched 2-dimensional forward FFTs using the FFTW library.
+INPUT	ptr to the n contiguous images,
+	ptr to the n contiguous compressed Fourier transforms (output),
+	number of images,
+	image size vector.
+OUTPUT	-.
+NOTES	Each transform takes (size[0]/2+1)*size[1] complex elements. Both
+	arrays should have been allocated with fftwf_malloc().
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	fft_rtfmany(float *data, float *fdata, int n, int *size)
+  {
+   int		dims[2], npix,npix2;
+
+  npix = size[0]*size[1];
+  npix2 = ((size[0]/2) + 1) * size[1];
+  if (fmplan && nfmplan != n)
+    {
+    fftwf_destroy_plan(fmplan);
+    fmplan = NULL;
+    }
+  if (!fmplan)
+    {
+    dims[0] = size[1];
+    dims[1] = size[0];
+    fmplan = fftwf_plan_many_dft_r2c(2, dims, n, data, NULL, 1, npix,
+	(fftwf_complex *)fdata, NULL, 1, npix2, FFTW_ESTIMATE);
+    nfmplan = n;
+    }
+
+  fftwf_execute_dft_r2c(fmplan, data, (fftwf_complex *)fdata);
+
+  return;
+  }
+
+
+/****** fft_ftrmany ********************************************************
+PROTO	void fft_ftrmany(float *fdata, float *data, int n, int *size)
+PURPOSE	Batched 2-dimensional backward FFTs using the FFTW library.
+INPUT	ptr to the n contiguous compressed Fourier transforms,
+	ptr to the n contiguous images (output),
+	number of images,
+	image size vector.
+OUTPUT	-.
+NOTES	The transforms are not normalized, and the input Fourier transforms
+	are destroyed. Both arrays should have been allocated with
+	fftwf_malloc().
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	fft_ftrmany(float *fdata, float *data, int n, int *size)
+  {
+   int		dims[2], npix,npix2;
+
+  npix = size[0]*size[1];
+  npix2 = ((size[0]/2) + 1) * size[1];
+  if (bmplan && nbmplan != n)
+    {
+    fftwf_destroy_plan(bmplan);
+    bmplan = NULL;
+    }
+  if (!bmplan)
+    {
+    dims[0] = size[1];
+    dims[1] = size[0];
+    bmplan = fftwf_plan_many_dft_c2r(2, dims, n, (fftwf_complex *)fdata,
+	NULL, 1, npix2, data, NULL, 1, npix, FFTW_ESTIMATE);
+    nbmplan = n;
+    }
+
+  fftwf_execute_dft_c2r(bmplan, (fftwf_complex *)fdata, data);
+
+  return;
+  }
+
+
 /****** fft_rtf ************************************************************
 PROTO	float *fft_rtf(float *data, int *size)
 PURPOSE	Optimized 2-dimensional FFT "in place" using the FFTW library.
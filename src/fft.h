@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		07/09/2022
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -52,7 +52,9 @@
 /*---------------------------------- protos --------------------------------*/
 extern void	fft_conv(float *data1, float *fdata2, int *size),
 		fft_end(void),
+		fft_ftrmany(float *fdata, float *data, int n, int *size),
 		fft_init(int nthreads),
-		fft_reset(void);
+		fft_reset(void),
+		fft_rtfmany(float *data, float *fdata, int n, int *size);
 
 extern float	*fft_rtf(float *data, int *size);
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		25/02/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -34,6 +34,7 @@
 #include	<stdio.h>
 #include	<stdlib.h>
 #include	<string.h>
+#include	<sys/stat.h>
 
 #include	"define.h"
 #include	"globals.h"
@@ -47,6 +48,12 @@
 #include	"fitswcs.h"
 #include	"header.h"
 #include	"interpolate.h"
+#include	"plist.h"
+
+static int		load_memimage(char *filename);
+
+static memimagestruct	*memimage;
+static int		nmemimage, nmemimagemax;
 
 /********************************* newfield **********************************/
 /*
@@ -59,9 +66,9 @@ picstruct	*newfield(char *filename, int flags, int ext)
    catstruct	*cat;
    tabstruct	*tab;
    char		*pstr;
-   int		ext2, nok, ntab, margin;
+   int		ext2, nok, ntab;
 
-  if (!(cat = read_cat(filename)))
+  if (!(cat = read_imacat(filename)))
     error(EXIT_FAILURE, "*Error*: cannot open ", filename);
 
 /* First allocate memory for the new field (and nullify pointers) */
@@ -190,6 +197,21 @@ picstruct	*newfield(char *filename, int flags, int ext)
       field->back_type = BACK_ABSOLUTE;
     }
 
+  setstripheight(field);
+
+  return field;
+  }
+
+
+/****************************** setstripheight *******************************/
+/*
+Set the height of the image buffer of a field from MEMORY_BUFSIZE.
+*/
+void	setstripheight(picstruct *field)
+
+  {
+   int		margin;
+
 /* Add a comfortable margin for local background estimates */
   margin = (prefs.pback_type == LOCAL)? prefs.pback_size + prefs.mem_bufsize/4
 					: 0;
@@ -211,7 +233,84 @@ picstruct	*newfield(char *filename, int flags, int ext)
       field->stripmargin = margin;
     }
 
-  return field;
+  return;
+  }
+
+
+/******************************* budgetfields ********************************/
+/*
+Share MEMORY_LIMIT between the image buffers of all fields, the pixel stack
+and the object stack, given the height of the largest objects expected (in
+pixels). Exit with an error if MEMORY_LIMIT cannot hold the streamed images,
+the background maps, the buffers and minimal stacks. Without MEMORY_LIMIT, only the memory used by
+image buffers is estimated.
+*/
+void	budgetfields(picstruct **fields, int nfield, int objsize)
+
+  {
+   picstruct	*field;
+   double	budget, linesize, stacksize, pixmax;
+   int		i, bufsize, npix, nobj;
+
+/* Memory taken by streamed images, background maps and by one line of all */
+/* image buffers */
+  thecat.memfield = linesize = 0.0;
+  for (i=0; i<nmemimage; i++)
+    thecat.memfield += (double)memimage[i].size;
+  for (i=0; i<nfield; i++)
+    {
+    field = fields[i];
+    thecat.memfield += (double)field->nback*4*sizeof(float);
+    linesize += (double)field->width*((field->flags&DGEO_FIELD)?
+		2*sizeof(PIXTYPE)
+		: ((field->flags&FLAG_FIELD)? sizeof(FLAGTYPE):sizeof(PIXTYPE)));
+    }
+
+  field = fields[0];
+  if (prefs.mem_limit > 0.0)
+    {
+    budget = prefs.mem_limit*1024.0*1024.0 - thecat.memfield;
+/*-- Give up to half of the budget to image buffers, as long as they contain */
+/*-- the largest objects */
+    bufsize = (int)(budget/2.0/linesize);
+    if (prefs.pback_type == LOCAL)
+      bufsize = (bufsize - prefs.pback_size)*4/5;
+    if (bufsize > field->height)
+      bufsize = field->height;
+    if (bufsize < objsize)
+      bufsize = objsize;
+    if (bufsize < 8)
+      bufsize = 8;
+    else if (bufsize > 65534)
+      bufsize = 65534;
+    prefs.mem_bufsize = bufsize;
+    for (i=0; i<nfield; i++)
+      setstripheight(fields[i]);
+/*-- The remainder goes to the pixel stack and the object stack */
+    init_plist();
+    stacksize = budget - field->stripheight*linesize;
+    pixmax = (double)field->width*field->height;
+    if (pixmax > (double)(0x7fffffff/plistsize))
+      pixmax = (double)(0x7fffffff/plistsize);
+    npix = (int)(stacksize*0.75/plistsize < pixmax?
+		stacksize*0.75/plistsize : pixmax);
+    nobj = (int)(stacksize*0.25/sizeof(objstruct));
+    if (npix < 1000 || nobj < 16)
+      {
+      sprintf(gstr, "%.0f MB", (field->stripheight*linesize + thecat.memfield
+	+ 1000.0*plistsize + 16.0*sizeof(objstruct))/(1024.0*1024.0) + 1.0);
+      error(EXIT_FAILURE,
+	"*Error*: MEMORY_LIMIT is too low for this image: needs at least ",
+	gstr);
+      }
+    prefs.mem_pixstackmax = npix;
+    prefs.clean_stacksize = nobj>65536? 65536 : nobj;
+    }
+
+  thecat.stripheight = field->stripheight;
+  thecat.memfield += field->stripheight*linesize;
+
+  return;
   }
 
 
@@ -237,6 +336,8 @@ picstruct	*inheritfield(picstruct *infield, int flags)
   field->strip = NULL;
   field->fstrip = NULL;
   field->dgeostrip[0] = field->dgeostrip[1] = NULL;
+  field->backnode = field->backxcoef = NULL;
+  field->backxstart = NULL;
   field->reffield = infield;
   field->file = NULL;
 
@@ -269,3 +370,157 @@ void	endfield(picstruct *field)
   return;
   }
 
+
+/******************************** add_memimage *******************************/
+/*
+Register a FITS file held in memory under a given name; the buffer is freed by
+free_memimages().
+*/
+void	add_memimage(char *name, char *buf, size_t size)
+
+  {
+  if (nmemimage>=nmemimagemax)
+    {
+    nmemimagemax = nmemimagemax? 2*nmemimagemax : 4;
+    QREALLOC(memimage, memimagestruct, nmemimagemax);
+    }
+  strcpy(memimage[nmemimage].name, name);
+  memimage[nmemimage].buf = buf;
+  memimage[nmemimage++].size = size;
+
+  return;
+  }
+
+
+/******************************** free_memimages *****************************/
+/*
+Free all the FITS files held in memory.
+*/
+void	free_memimages(void)
+
+  {
+  for (; nmemimage--;)
+    free(memimage[nmemimage].buf);
+  free(memimage);
+  memimage = NULL;
+  nmemimage = nmemimagemax = 0;
+
+  return;
+  }
+
+
+/******************************** is_memimage *******************************/
+/*
+Tell whether a FITS image is held in memory.
+*/
+int	is_memimage(char *filename)
+
+  {
+   int	i;
+
+  for (i=0; i<nmemimage; i++)
+    if (!strcmp(filename, memimage[i].name))
+      return 1;
+
+  return 0;
+  }
+
+
+/******************************* load_memimage *******************************/
+/*
+Read a FITS image from the standard input ("-"), a named pipe or a character
+device, and register it as an in-memory file. The memory budget for streams
+(MEMORY_LIMIT, MEM_MAX or STREAM_MAXRAM, in this order) is shared with the
+streams already loaded; exit with an error if it is exceeded.
+*/
+static int	load_memimage(char *filename)
+
+  {
+   struct stat	st;
+   FILE		*file;
+   char		*buf;
+   double	budget;
+   size_t	size, sizemax, nmax, n;
+   int		i;
+
+  if (!strcmp(filename, "-"))
+    file = stdin;
+  else if (stat(filename, &st)
+	|| !(S_ISFIFO(st.st_mode) || S_ISCHR(st.st_mode))
+	|| !(file = fopen(filename, "rb")))
+    return RETURN_ERROR;
+
+  sprintf(gstr, "Reading %s stream", file==stdin? "standard input" : filename);
+  NFPRINTF(OUTPUT, gstr);
+  if (prefs.mem_limit > 0.0)
+    budget = prefs.mem_limit*1024.0*1024.0;
+  else if (prefs.mem_max)
+    budget = (double)prefs.mem_max*1024.0*1024.0;
+  else
+    budget = (double)STREAM_MAXRAM;
+  for (i=0; i<nmemimage; i++)
+    budget -= (double)memimage[i].size;
+  if (budget < 2880.0)
+    error(EXIT_FAILURE, "*Error*: no memory left in the budget for stream ",
+	filename);
+  sizemax = (size_t)budget;
+  nmax = sizemax < DATA_BUFSIZE? sizemax : DATA_BUFSIZE;
+  QMALLOC(buf, char, nmax);
+  size = 0;
+  while ((n = fread(buf+size, 1, nmax-size, file)))
+    if ((size+=n) == nmax)
+      {
+      if (nmax < sizemax)
+        nmax = nmax < sizemax/2? 2*nmax : sizemax;
+      else if (getc(file) == EOF)
+        break;
+      else
+        error(EXIT_FAILURE, "*Error*: stream too large for the memory budget"
+		" (see MEMORY_LIMIT): ", filename);
+      QREALLOC(buf, char, nmax);
+      }
+
+/* Only the stream content is charged to the budget */
+  if (size && size<nmax)
+    QREALLOC(buf, char, size);
+  add_memimage(filename, buf, size);
+
+  if (file != stdin)
+    fclose(file);
+
+  return RETURN_OK;
+  }
+
+
+/********************************* read_imacat *******************************/
+/*
+Open a FITS image file, or a stream on a registered in-memory FITS file with the
+same name. Non-seekable files are first loaded to memory.
+*/
+catstruct	*read_imacat(char *filename)
+
+  {
+   catstruct	*cat;
+   int		i;
+
+  for (i=0; i<nmemimage; i++)
+    if (!strcmp(filename, memimage[i].name))
+      {
+      if (!(cat = new_cat(1)))
+        error (EXIT_FAILURE, "Not enough memory to read ", filename);
+      strcpy(cat->filename, filename);
+      if (!(cat->file = fmemopen(memimage[i].buf, memimage[i].size, "rb"))
+		|| map_cat(cat) != RETURN_OK)
+        {
+        free_cat(&cat, 1);
+        return NULL;
+        }
+      cat->access_type = READ_ONLY;
+      return cat;
+      }
+
+  if (load_memimage(filename) == RETURN_OK)
+    return read_imacat(filename);
+
+  return read_cat(filename);
+  }
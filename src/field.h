@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		08/01/2015
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -37,3 +37,11 @@
 #define		BACKRMS_FIELD	0x0040	/* Weighting from a backrms matrix */
 #define		INTERP_FIELD	0x0080	/* Purely interpolated data */
 #define		DGEO_FIELD	0x0100	/* Differential geometry map */
+
+/*--------------------------------- typedefs --------------------------------*/
+typedef struct
+  {
+  char		name[MAXCHAR];		/* registered image name */
+  char		*buf;			/* FITS file content */
+  size_t	size;			/* FITS file size in bytes */
+  }	memimagestruct;
@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -46,6 +46,9 @@
 
 filterstruct	*thefilter;
 
+static void	neurfilter_batch(PIXTYPE *mscan, float sig, int *xbatch,
+			float *resp, int nb);
+
 /******************************** convolve ***********************************/
 /*
 Convolve a scan line with an array.
@@ -245,7 +248,8 @@ int	getneurfilter(char *filename)
   FILTEST(fitsread(ftab->headbuf, "RENAXIS1", &thefilter->convw ,H_INT,T_LONG));
   FILTEST(fitsread(ftab->headbuf, "RENAXIS2", &thefilter->convh ,H_INT,T_LONG));
   thefilter->nconv = thefilter->convw*thefilter->convh;
-  QMALLOC(thefilter->conv, float, thefilter->nconv);
+/* Room for a whole batch of retina inputs */
+  QMALLOC(thefilter->conv, float, thefilter->nconv*BPANN_NBATCH);
   thefilter->bpann = loadtab_bpann(ftab, filename);
 
   close_cat(fcat);
@@ -293,14 +297,17 @@ void	filter(picstruct *field, PIXTYPE *mscan, int y)
 
 /******************************** neurfilter *********************************/
 /*
-Filter a scan line using an artificial retina.
+Filter a scan line using an artificial retina. Retina inputs are collected
+for up to BPANN_NBATCH pixels, which then go through the ANN together.
 */
 void	neurfilter(picstruct *field, PIXTYPE *mscan, int y)
 
   {
    PIXTYPE	cval;
-   float	*pix, resp, sig, threshlow, threshhigh;
-   int		i,x, tflag;
+   float	resp[BPANN_NBATCH],
+		*pix, sig, threshlow, threshhigh;
+   int		xbatch[BPANN_NBATCH],
+		i,x, nb, tflag;
 
   sig = field->backsig;
   if ((tflag = (prefs.nfilter_thresh>0)))
@@ -312,31 +319,60 @@ void	neurfilter(picstruct *field, PIXTYPE *mscan, int y)
   else
     threshlow = threshhigh = 0.0;	/* To avoid gcc -Wall warnings */
 
-  for (x=0;x<field->width;x++)
+  nb = 0;
+  for (x=0; x<field->width; x++)
     {
     if (tflag)
       {
       cval = PIX(field, x, y);
       if (cval<threshlow || cval>threshhigh)
         {
-        *(mscan++) = cval;
+        mscan[x] = cval;
         continue;
 	}
       }
 /*-- Copy the surrounding image area to the retina */
-    copyimage(field, thefilter->conv, thefilter->convw, thefilter->convh,
-		x, y);
-    pix = thefilter->conv;
+    pix = thefilter->conv + nb*thefilter->nconv;
+    copyimage(field, pix, thefilter->convw, thefilter->convh, x, y);
 /*-- Apply a transform of the intensity scale */
     for (i=thefilter->nconv; i--; pix++)
       *pix = *pix>0.0?log(1+*pix/sig):-log(1-*pix/sig);
-    play_bpann(thefilter->bpann, thefilter->conv, &resp);
-    if (resp>70.0)
-      resp = 70.0;
-    else if (resp<-70.0)
-      resp = -70.0;
+    xbatch[nb++] = x;
+    if (nb==BPANN_NBATCH)
+      {
+      neurfilter_batch(mscan, sig, xbatch, resp, nb);
+      nb = 0;
+      }
+    }
+
+  if (nb)
+    neurfilter_batch(mscan, sig, xbatch, resp, nb);
+
+  return;
+  }
+
+
+/***************************** neurfilter_batch ******************************/
+/*
+Run the retina on a batch of nb pixels and store the filtered values.
+*/
+static void	neurfilter_batch(PIXTYPE *mscan, float sig, int *xbatch,
+			float *resp, int nb)
+
+  {
+   float	r;
+   int		b;
+
+  play_bpannbatch(thefilter->bpann, thefilter->conv, nb, resp);
+  for (b=0; b<nb; b++)
+    {
+    r = resp[b];
+    if (r>70.0)
+      r = 70.0;
+    else if (r<-70.0)
+      r = -70.0;
 /*-- Recover the linear intensity scale */
-    *(mscan++) = resp>0.0?sig*(exp(resp)-1):sig*(exp(-resp)-1);
+    mscan[xbatch[b]] = r>0.0?sig*(exp(r)-1):sig*(exp(-r)-1);
     }
 
   return;
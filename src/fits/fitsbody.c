@@ -23,7 +23,7 @@
 *	along with AstrOmatic software.
 *	If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		25/02/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -34,6 +34,7 @@
 #include	<stdio.h>
 #include	<stdlib.h>
 #include	<string.h>
+#include	<fcntl.h>
 #include	<unistd.h>
 #include	<sys/types.h>
 
@@ -55,6 +56,8 @@ int	body_vmnumber;
 
 char	body_swapdirname[MAXCHARS] = BODY_DEFSWAPDIR;
 
+static void	*map_swapfile(size_t size, char *swapname);
+
 /******* alloc_body ***********************************************************
 PROTO	PIXTYPE *alloc_body(tabstruct *tab,
 		void (*func)(PIXTYPE *ptr, int npix))
@@ -64,13 +67,11 @@ INPUT	Table (tab) structure.
 OUTPUT	Pointer to the mapped data if OK, or NULL otherwise.
 NOTES	The file pointer must be positioned at the beginning of the data.
 AUTHOR	E. Bertin (IAP)
-VERSION	02/10/2017
+VERSION	19/10/2026
  ***/
 PIXTYPE	*alloc_body(tabstruct *tab, void (*func)(PIXTYPE *ptr, int npix))
   {
-   FILE		*file;
-   PIXTYPE	*buffer;
-   size_t	npix, size, sizeleft, spoonful;
+   size_t	npix, size;
 
   if (!body_ramflag)
     {
@@ -118,44 +119,22 @@ PIXTYPE	*alloc_body(tabstruct *tab, void (*func)(PIXTYPE *ptr, int npix))
 
   if (size < body_vramleft)
     {
-/*-- Convert and copy the data to a swap file, and mmap() it */
-    if (!(buffer = malloc(DATA_BUFSIZE)))
+/*-- Map a swap file, and convert the data directly into it */
+    if (!(tab->bodybuf = map_swapfile(size, tab->swapname)))
       return NULL;
-    sprintf(tab->swapname, "%s/vm%05ld_%05x.tmp",
-		body_swapdirname, (long)getpid(),
-		(unsigned int)++body_vmnumber) ;
-    if (!(file=fopen(tab->swapname, "wb+")))
-      error(EXIT_FAILURE, "*Error*: cannot create swap-file ", tab->swapname);
-    add_cleanupfilename(tab->swapname);
-    spoonful = (size%DATA_BUFSIZE);
-    if (!spoonful)
-      spoonful = DATA_BUFSIZE;
     QFSEEK(tab->cat->file, tab->bodypos, SEEK_SET, tab->cat->filename);
 #ifdef	HAVE_CFITSIO
     tab->currentElement = 1;
 #endif
-    read_body(tab, buffer, spoonful/sizeof(PIXTYPE));
+    read_body(tab, (PIXTYPE *)tab->bodybuf, npix);
 /*-- Apply pixel processing */
     if (func)
-      (*func)(buffer, spoonful/sizeof(PIXTYPE));
-    QFWRITE(buffer, spoonful, file, tab->swapname);
-    for (sizeleft = size; sizeleft -= spoonful;)
-      {
-      read_body(tab, buffer, (spoonful=DATA_BUFSIZE)/sizeof(PIXTYPE));
-/*--- Apply pixel processing */
-      if (func)
-        (*func)(buffer, spoonful/sizeof(PIXTYPE));
-      QFWRITE(buffer, spoonful, file, tab->swapname);
-      }
-    free(buffer);
-    tab->bodybuf = mmap(NULL,size,PROT_READ,MAP_SHARED,fileno(file),(off_t)0);
-    fclose(file);
+      (*func)((PIXTYPE *)tab->bodybuf, npix);
+/*-- The body is read-only from now on */
+    mprotect(tab->bodybuf, size, PROT_READ);
     tab->swapflag = 1;
     body_vramleft -= size;
 
-/*-- Memory mapping problem */
-    if (tab->bodybuf == (void *)-1)
-      return NULL;
     return (PIXTYPE *)tab->bodybuf;
     }
 
@@ -173,14 +152,12 @@ INPUT	Table (tab) structure.
 OUTPUT	Pointer to the mapped data if OK, or NULL otherwise.
 NOTES	The file pointer must be positioned at the beginning of the data.
 AUTHOR	E. Bertin (IAP)
-VERSION	02/10/2017
+VERSION	19/10/2026
  ***/
 FLAGTYPE	*alloc_ibody(tabstruct *tab,
 			void (*func)(FLAGTYPE *ptr, int npix))
   {
-   FILE		*file;
-   FLAGTYPE	*buffer;
-   size_t	npix, size, sizeleft, spoonful;
+   size_t	npix, size;
 
   if (!body_ramflag)
     {
@@ -224,44 +201,22 @@ FLAGTYPE	*alloc_ibody(tabstruct *tab,
 
   if (size < body_vramleft)
     {
-/*-- Convert and copy the data to a swap file, and mmap() it */
-    if (!(buffer = malloc(DATA_BUFSIZE)))
+/*-- Map a swap file, and convert the data directly into it */
+    if (!(tab->bodybuf = map_swapfile(size, tab->swapname)))
       return NULL;
-    sprintf(tab->swapname, "%s/vm%05ld_%05x.tmp",
-		body_swapdirname, (long)getpid(),
-		(unsigned int)++body_vmnumber) ;
-    if (!(file=fopen(tab->swapname, "wb+")))
-      error(EXIT_FAILURE, "*Error*: cannot create swap-file ", tab->swapname);
-    add_cleanupfilename(tab->swapname);
-    spoonful = (size%DATA_BUFSIZE);
-    if (!spoonful)
-      spoonful = DATA_BUFSIZE;
     QFSEEK(tab->cat->file, tab->bodypos, SEEK_SET, tab->cat->filename);
 #ifdef	HAVE_CFITSIO
     tab->currentElement = 1;
 #endif
-    read_ibody(tab, buffer, spoonful/sizeof(FLAGTYPE));
+    read_ibody(tab, (FLAGTYPE *)tab->bodybuf, npix);
 /*-- Apply pixel processing */
     if (func)
-      (*func)(buffer, spoonful/sizeof(FLAGTYPE));
-    QFWRITE(buffer, spoonful, file, tab->swapname);
-    for (sizeleft = size; sizeleft -= spoonful;)
-      {
-      read_ibody(tab, buffer, (spoonful=DATA_BUFSIZE)/sizeof(FLAGTYPE));
-/*--- Apply pixel processing */
-      if (func)
-        (*func)(buffer, spoonful/sizeof(FLAGTYPE));
-      QFWRITE(buffer, spoonful, file, tab->swapname);
-      }
-    free(buffer);
-    tab->bodybuf = mmap(NULL,size,PROT_READ,MAP_SHARED,fileno(file),(off_t)0);
-    fclose(file);
+      (*func)((FLAGTYPE *)tab->bodybuf, npix);
+/*-- The body is read-only from now on */
+    mprotect(tab->bodybuf, size, PROT_READ);
     tab->swapflag = 1;
     body_vramleft -= size;
 
-/*-- Memory mapping problem */
-    if (tab->bodybuf == (void *)-1)
-      return NULL;
     return (FLAGTYPE *)tab->bodybuf;
     }
 
@@ -314,6 +269,153 @@ void	free_body(tabstruct *tab)
   return;
   }
 
+/******* alloc_vmem ***********************************************************
+PROTO	void *alloc_vmem(size_t size, char *swapname)
+PURPOSE	Allocate a zero-filled buffer, in RAM or, if not enough RAM is
+	available, in a swap file.
+INPUT	Buffer size in bytes,
+	pointer to the returned swap file name (MAXCHARS characters at least).
+OUTPUT	Pointer to the buffer if OK, or NULL otherwise.
+NOTES	The swap file name is empty for buffers in RAM.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	*alloc_vmem(size_t size, char *swapname)
+  {
+   void	*buf;
+
+  if (!body_ramflag)
+    {
+    body_ramleft = body_maxram;
+    body_vramleft = body_maxvram;
+    body_ramflag = 1;
+    }
+
+  *swapname = '\0';
+  if (size < body_ramleft && (buf = calloc(size, 1)))
+    {
+    body_ramleft -= size;
+    return buf;
+    }
+
+  if (size < body_vramleft && (buf = map_swapfile(size, swapname)))
+    {
+    body_vramleft -= size;
+    return buf;
+    }
+
+  return NULL;
+  }
+
+
+/******* prefetch_vmem ********************************************************
+PROTO	void prefetch_vmem(void *buf, size_t size, char *swapname)
+PURPOSE	Tell the system that a buffer from alloc_vmem() is about to be read.
+INPUT	Pointer to the buffer,
+	buffer size in bytes,
+	swap file name returned by alloc_vmem().
+OUTPUT	-.
+NOTES	Does nothing for buffers in RAM.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	prefetch_vmem(void *buf, size_t size, char *swapname)
+  {
+#ifdef	MADV_WILLNEED
+  if (*swapname)
+    madvise(buf, size, MADV_WILLNEED);
+#endif
+
+  return;
+  }
+
+
+/******* free_vmem ************************************************************
+PROTO	void free_vmem(void *buf, size_t size, char *swapname)
+PURPOSE	Free a buffer from alloc_vmem().
+INPUT	Pointer to the buffer,
+	buffer size in bytes,
+	swap file name returned by alloc_vmem().
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	free_vmem(void *buf, size_t size, char *swapname)
+  {
+  if (!buf)
+    return;
+
+  if (*swapname)
+    {
+    if (munmap(buf, size))
+      warning("Can't unmap ", swapname);
+    body_vramleft += size;
+    if (unlink(swapname))
+      warning("Can't delete ", swapname);
+    remove_cleanupfilename(swapname);
+    *swapname = '\0';
+    }
+  else
+    {
+    free(buf);
+    body_ramleft += size;
+    }
+
+  return;
+  }
+
+
+/******* map_swapfile *********************************************************
+PROTO	void *map_swapfile(size_t size, char *swapname)
+PURPOSE	Create a zero-filled swap file and map it to memory.
+INPUT	File size in bytes,
+	pointer to the returned swap file name (MAXCHARS characters at least).
+OUTPUT	Pointer to the mapped file if OK, or NULL otherwise.
+NOTES	Disk blocks are reserved with posix_fallocate() before the file is
+	mapped, so that a full disk is reported here rather than through a
+	SIGBUS on a later page write. Accesses are expected to be sequential
+	(strip after strip).
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	*map_swapfile(size_t size, char *swapname)
+  {
+   void	*buf;
+   int	fd;
+
+  if (snprintf(swapname, MAXCHARS, "%s/vm%05ld_%05x.tmp",
+		body_swapdirname, (long)getpid(),
+		(unsigned int)++body_vmnumber) >= MAXCHARS)
+    error(EXIT_FAILURE, "*Error*: swap-file path too long in ",
+		body_swapdirname);
+  if ((fd=open(swapname, O_RDWR|O_CREAT|O_TRUNC, 0600)) == -1)
+    error(EXIT_FAILURE, "*Error*: cannot create swap-file ", swapname);
+  add_cleanupfilename(swapname);
+  if (posix_fallocate(fd, (off_t)0, (off_t)size))
+    {
+    close(fd);
+    error(EXIT_FAILURE, "*Error*: not enough space for swap-file ", swapname);
+    }
+  buf = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, (off_t)0);
+  close(fd);
+/* Memory mapping problem */
+  if (buf == MAP_FAILED)
+    {
+    unlink(swapname);
+    remove_cleanupfilename(swapname);
+    *swapname = '\0';
+    return NULL;
+    }
+
+#ifdef	MADV_SEQUENTIAL
+  madvise(buf, size, MADV_SEQUENTIAL);
+#endif
+
+  return buf;
+  }
+
+
 #ifdef	HAVE_CFITSIO
 /******* readTileCompressed ***************************************************
  *
@@ -393,9 +495,9 @@ INPUT	A pointer to the tab structure,
 	a pointer to the array in memory,
 	the number of elements to be read.
 OUTPUT	-.
-NOTES	.
+NOTES	Uncompressed data are converted with vector kernels when available.
 AUTHOR	E. Bertin (CFHT/IAP/CNRS/SorbonneU)
-VERSION	25/02/2023
+VERSION	19/10/2026
  ***/
 void	read_body(tabstruct *tab, PIXTYPE *ptr, size_t size)
   {
@@ -446,6 +548,17 @@ void	read_body(tabstruct *tab, PIXTYPE *ptr, size_t size)
 #else
         QFREAD(bufdata, spoonful*tab->bytepix, cat->file, cat->filename);
 #endif // HAVE_CFITSIO
+/*------ Try first the vectorized swap/blank/scale/convert kernels */
+#ifdef	HAVE_CFITSIO
+        if (vec_readbody(tab, bufdata, ptr, spoonful,
+		!tab->isTileCompressed && bswapflag) == RETURN_OK)
+#else
+        if (vec_readbody(tab, bufdata, ptr, spoonful, bswapflag) == RETURN_OK)
+#endif
+          {
+          ptr += spoonful;
+          continue;
+          }
         switch(tab->bitpix)
           {
           case BP_BYTE:
@@ -953,9 +1066,9 @@ INPUT	A pointer to the tab structure,
 	a pointer to the array in memory,
 	the number of elements to be written.
 OUTPUT	-.
-NOTES	.
+NOTES	Uncompressed data are converted with vector kernels when available.
 AUTHOR	E. Bertin (IAP)
-VERSION	26/08/2020
+VERSION	19/10/2026
  ***/
 void	write_body(tabstruct *tab, PIXTYPE *ptr, size_t size)
   {
@@ -988,7 +1101,16 @@ void	write_body(tabstruct *tab, PIXTYPE *ptr, size_t size)
         {
         if (spoonful>size)
           spoonful = size;
-        switch(tab->bitpix)
+/*------ Use the vectorized convert/round/swap kernels if available */
+#ifdef	HAVE_CFITSIO
+        if (!tab->infptr && vec_writebody(tab, ptr, cbufdata0, spoonful,
+		bswapflag) == RETURN_OK)
+#else
+        if (vec_writebody(tab, ptr, cbufdata0, spoonful, bswapflag)
+		== RETURN_OK)
+#endif
+          ptr += spoonful;
+        else switch(tab->bitpix)
           {
           case BP_BYTE:
             if (tab->bitsgn)
@@ -1387,14 +1509,14 @@ PURPOSE	Set the path name of the directory that will be used for storing
 	memory swap files.
 INPUT	The pointer to the path string.
 OUTPUT	RETURN_OK if path appropriate, RETURN_ERROR otherwise.
-NOTES	.
+NOTES	Paths longer than BODY_MAXSWAPDIR characters are rejected.
 AUTHOR	E. Bertin (IAP)
-VERSION	19/12/99
+VERSION	19/10/2026
  ***/
 int set_swapdir(char *dirname)
   {
 
-  if (!dirname)
+  if (!dirname || strlen(dirname) > BODY_MAXSWAPDIR)
     return RETURN_ERROR;
 
   strcpy(body_swapdirname, dirname);
@@ -24,7 +24,7 @@
 *	along with AstrOmatic software.
 *	If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		25/02/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -62,6 +62,18 @@
 #define		BP_FLOAT	(-32)
 #define		BP_DOUBLE	(-64)
 
+/*------------------------- Vector instruction sets -------------------------*/
+
+#define		VEC_NONE	0	/* No vector unit: use the scalar code */
+#define		VEC_LEVEL_AVX2	1	/* AVX2 integer and FP kernels */
+
+/* x86 kernels are built for AVX2 and selected at run time (vec_getlevel()) */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define		VEC_X86
+#include	<immintrin.h>
+#define		VEC_AVX2	__attribute__((target("avx2")))
+#endif
+
 /*-------------------------------- macros -----------------------------------*/
 
 /* Standard FITS name suffix*/
@@ -234,11 +246,13 @@ extern void	add_cleanupfilename(char *filename),
 		error_installfunc(void (*func)(const char *msg1, const char *msg2)),
 		fixexponent(char *s),
 		free_body(tabstruct *tab),
+		free_vmem(void *buf, size_t size, char *swapname),
 		free_cat(catstruct **cat, int ncat),
 		free_key(keystruct *key),
 		free_tab(tabstruct *tab),
 		init_writeobj(catstruct *cat, tabstruct *tab, char **pbuf),
 		install_cleanup(void (*func)(void)),
+		prefetch_vmem(void *buf, size_t size, char *swapname),
 		print_obj(FILE *stream, tabstruct *tab),
 		read_keys(tabstruct *tab, char **keynames, keystruct **keys,
 			int nkeys, unsigned char *mask),
@@ -332,6 +346,11 @@ extern int	about_cat(catstruct *cat, FILE *stream),
 		update_head(tabstruct *tab),
 		decomp_head(tabstruct *tab),
 		update_tab(tabstruct *tab),
+		vec_getlevel(void),
+		vec_readbody(tabstruct *tab, char *bufdata, PIXTYPE *ptr,
+			size_t n, int swapflag),
+		vec_writebody(tabstruct *tab, PIXTYPE *ptr, char *bufdata,
+			size_t n, int swapflag),
 		verify_checksum(tabstruct *tab),
 		write_obj(tabstruct *tab, char *buf),
 		wstrncmp(char *, char *, int);
@@ -342,4 +361,6 @@ extern PIXTYPE	*alloc_body(tabstruct *tab,
 extern FLAGTYPE	*alloc_ibody(tabstruct *tab,
 			void (*func)(FLAGTYPE *ptr, int npix));
 
+extern void	*alloc_vmem(size_t size, char *swapname);
+
 extern t_type	ttypeof(char *str);
@@ -24,7 +24,7 @@
 *	along with AstrOmatic software.
 *	If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -53,6 +53,7 @@
 #define	BODY_DEFRAM	(256*MBYTE)	/* a fair number by 1999 standards */
 #define	BODY_DEFVRAM	(1.9*GBYTE)	/* a fair number by 1999 standards */
 #define	BODY_DEFSWAPDIR	"/tmp"		/* OK at least for Unix systems */
+#define	BODY_MAXSWAPDIR	(MAXCHARS-32)	/* room left for swap file names */
 
 #define	BIG		1e+30		/* a huge number */
 #define	TINY		(1.0/BIG)	/* a tiny number */
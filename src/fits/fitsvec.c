@@ -0,0 +1,582 @@
+/*
+*				fitsvec.c
+*
+* Vectorized conversion of FITS pixel data.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	AstrOmatic FITS/LDAC library
+*
+*	Copyright:		(C) 2026 CFHT/IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	AstrOmatic software is free software: you can redistribute it and/or
+*	modify it under the terms of the GNU General Public License as
+*	published by the Free Software Foundation, either version 3 of the
+*	License, or (at your option) any later version.
+*	AstrOmatic software is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with AstrOmatic software.
+*	If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifdef HAVE_CONFIG_H
+#include	"config.h"
+#endif
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"fitscat_defs.h"
+#include	"fitscat.h"
+
+static int	vec_level = -1;
+
+/****** vec_getlevel **********************************************************
+PROTO	int vec_getlevel(void)
+PURPOSE	Return the vector instruction set available at run time.
+INPUT	-.
+OUTPUT	VEC_NONE or VEC_LEVEL_AVX2.
+NOTES	The detection is done once; the FITSVEC_DISABLE environment variable
+	forces the scalar code (e.g. for validation).
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	vec_getlevel(void)
+  {
+  if (vec_level<0)
+    {
+    vec_level = VEC_NONE;
+#ifdef VEC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && !getenv("FITSVEC_DISABLE"))
+      vec_level = VEC_LEVEL_AVX2;
+#endif
+    }
+
+  return vec_level;
+  }
+
+
+#ifdef VEC_X86
+
+/*
+Note: all kernels reproduce exactly the arithmetic of the scalar loops in
+fitsbody.c: integer and single precision input values are scaled in double
+precision before rounding to PIXTYPE, and output values are scaled in
+single precision before truncation. FMA contraction is therefore avoided
+by not enabling the "fma" target.
+*/
+
+/****** vec_scale8_avx2 *******************************************************
+PROTO	__m256 vec_scale8_avx2(__m256i ival, __m256d bs, __m256d bz)
+PURPOSE	Convert 8 32-bit signed integers to floats using bscale and bzero.
+INPUT	Integer vector,
+	bscale vector,
+	bzero vector.
+OUTPUT	Vector of 8 floats.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static inline VEC_AVX2 __m256	vec_scale8_avx2(__m256i ival, __m256d bs,
+					__m256d bz)
+  {
+   __m256d	dlo, dhi;
+
+  dlo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(ival));
+  dhi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(ival, 1));
+  dlo = _mm256_add_pd(_mm256_mul_pd(dlo, bs), bz);
+  dhi = _mm256_add_pd(_mm256_mul_pd(dhi, bs), bz);
+
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(dlo)),
+		_mm256_cvtpd_ps(dhi), 1);
+  }
+
+
+/****** vec_uscale8_avx2 ******************************************************
+PROTO	__m256 vec_uscale8_avx2(__m256i ival, __m256d bs, __m256d bz)
+PURPOSE	Convert 8 32-bit unsigned integers to floats using bscale and bzero.
+INPUT	Integer vector,
+	bscale vector,
+	bzero vector.
+OUTPUT	Vector of 8 floats.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static inline VEC_AVX2 __m256	vec_uscale8_avx2(__m256i ival, __m256d bs,
+					__m256d bz)
+  {
+   __m256d	dlo, dhi, two32;
+   __m128i	ilo, ihi;
+
+  two32 = _mm256_set1_pd(4294967296.0);
+  ilo = _mm256_castsi256_si128(ival);
+  ihi = _mm256_extracti128_si256(ival, 1);
+/* Values above 2^31-1 come out negative: put them back in range */
+  dlo = _mm256_cvtepi32_pd(ilo);
+  dlo = _mm256_add_pd(dlo, _mm256_and_pd(two32,
+		_mm256_castsi256_pd(_mm256_cvtepi32_epi64(
+			_mm_srai_epi32(ilo, 31)))));
+  dhi = _mm256_cvtepi32_pd(ihi);
+  dhi = _mm256_add_pd(dhi, _mm256_and_pd(two32,
+		_mm256_castsi256_pd(_mm256_cvtepi32_epi64(
+			_mm_srai_epi32(ihi, 31)))));
+  dlo = _mm256_add_pd(_mm256_mul_pd(dlo, bs), bz);
+  dhi = _mm256_add_pd(_mm256_mul_pd(dhi, bs), bz);
+
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(dlo)),
+		_mm256_cvtpd_ps(dhi), 1);
+  }
+
+
+/****** vec_readbody_avx2 *****************************************************
+PROTO	int vec_readbody_avx2(tabstruct *tab, char *bufdata, PIXTYPE *ptr,
+		size_t n, int swapflag)
+PURPOSE	AVX2 version of the uncompressed read_body() conversion: byte-swapping,
+	BLANK detection, scaling and conversion to PIXTYPE in one pass.
+INPUT	A pointer to the tab structure,
+	a pointer to the raw input data,
+	a pointer to the output array,
+	the number of elements to be converted,
+	byte-swapping flag.
+OUTPUT	RETURN_OK if the data have been converted, RETURN_ERROR otherwise.
+NOTES	The raw data buffer is left untouched.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static VEC_AVX2 int	vec_readbody_avx2(tabstruct *tab, char *bufdata,
+				PIXTYPE *ptr, size_t n, int swapflag)
+  {
+   __m256d	bs, bz;
+   __m256i	ival, iblank, swap16, swap32, swap64, expmask;
+   __m256	fval, fblank, fmask;
+   __m128i	sval;
+   double	dbs, dbz;
+   size_t	i, nvec;
+   int		blankflag, bitsgn;
+
+  dbs = tab->bscale;
+  dbz = tab->bzero;
+  bs = _mm256_set1_pd(dbs);
+  bz = _mm256_set1_pd(dbz);
+  fblank = _mm256_set1_ps((float)-BIG);
+  blankflag = tab->blankflag;
+  bitsgn = tab->bitsgn;
+  nvec = n&~(size_t)7;
+  swap16 = _mm256_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14,
+			1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14);
+  swap32 = _mm256_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12,
+			3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+  swap64 = _mm256_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8,
+			7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+
+  switch(tab->bitpix)
+    {
+    case BP_BYTE:
+      iblank = _mm256_set1_epi32(bitsgn? (int)(char)tab->blank
+				: (int)(unsigned char)tab->blank);
+      for (i=0; i<nvec; i+=8, bufdata+=8, ptr+=8)
+        {
+        sval = _mm_loadl_epi64((__m128i *)bufdata);
+        ival = bitsgn? _mm256_cvtepi8_epi32(sval) : _mm256_cvtepu8_epi32(sval);
+        fval = vec_scale8_avx2(ival, bs, bz);
+        if (blankflag)
+          fval = _mm256_blendv_ps(fval, fblank,
+		_mm256_castsi256_ps(_mm256_cmpeq_epi32(ival, iblank)));
+        _mm256_storeu_ps(ptr, fval);
+        }
+      for (; i<n; i++, bufdata++)
+        {
+        if (bitsgn)
+          {
+          char cval = *bufdata;
+          *(ptr++) = (blankflag && cval == (char)tab->blank)?
+			-BIG : cval*dbs + dbz;
+          }
+        else
+          {
+          unsigned char cuval = *(unsigned char *)bufdata;
+          *(ptr++) = (blankflag && cuval == (unsigned char)tab->blank)?
+			-BIG : cuval*dbs + dbz;
+          }
+        }
+      break;
+
+    case BP_SHORT:
+      iblank = _mm256_set1_epi32(bitsgn? (int)(short)tab->blank
+				: (int)(unsigned short)tab->blank);
+      for (i=0; i<nvec; i+=8, bufdata+=16, ptr+=8)
+        {
+        sval = _mm_loadu_si128((__m128i *)bufdata);
+        if (swapflag)
+          sval = _mm_shuffle_epi8(sval, _mm256_castsi256_si128(swap16));
+        ival = bitsgn? _mm256_cvtepi16_epi32(sval)
+		: _mm256_cvtepu16_epi32(sval);
+        fval = vec_scale8_avx2(ival, bs, bz);
+        if (blankflag)
+          fval = _mm256_blendv_ps(fval, fblank,
+		_mm256_castsi256_ps(_mm256_cmpeq_epi32(ival, iblank)));
+        _mm256_storeu_ps(ptr, fval);
+        }
+      for (; i<n; i++, bufdata+=2)
+        {
+         unsigned short	suval;
+         short		sval;
+        memcpy(&suval, bufdata, 2);
+        if (swapflag)
+          suval = (unsigned short)((suval>>8) | (suval<<8));
+        sval = (short)suval;
+        if (bitsgn)
+          *(ptr++) = (blankflag && sval == (short)tab->blank)?
+			-BIG : sval*dbs + dbz;
+        else
+          *(ptr++) = (blankflag && suval == (unsigned short)tab->blank)?
+			-BIG : suval*dbs + dbz;
+        }
+      break;
+
+    case BP_LONG:
+      iblank = _mm256_set1_epi32(tab->blank);
+      for (i=0; i<nvec; i+=8, bufdata+=32, ptr+=8)
+        {
+        ival = _mm256_loadu_si256((__m256i *)bufdata);
+        if (swapflag)
+          ival = _mm256_shuffle_epi8(ival, swap32);
+        fval = bitsgn? vec_scale8_avx2(ival, bs, bz)
+		: vec_uscale8_avx2(ival, bs, bz);
+        if (blankflag)
+          fval = _mm256_blendv_ps(fval, fblank,
+		_mm256_castsi256_ps(_mm256_cmpeq_epi32(ival, iblank)));
+        _mm256_storeu_ps(ptr, fval);
+        }
+      for (; i<n; i++, bufdata+=4)
+        {
+         unsigned int	iuval;
+        memcpy(&iuval, bufdata, 4);
+        if (swapflag)
+          swapbytes(&iuval, 4, 1);
+        if (bitsgn)
+          *(ptr++) = (blankflag && (int)iuval == tab->blank)?
+			-BIG : (int)iuval*dbs + dbz;
+        else
+          *(ptr++) = (blankflag && iuval == (unsigned int)tab->blank)?
+			-BIG : iuval*dbs + dbz;
+        }
+      break;
+
+    case BP_FLOAT:
+      expmask = _mm256_set1_epi32(0x7f800000);
+      for (i=0; i<nvec; i+=8, bufdata+=32, ptr+=8)
+        {
+         __m256d	dlo, dhi;
+        ival = _mm256_loadu_si256((__m256i *)bufdata);
+        if (swapflag)
+          ival = _mm256_shuffle_epi8(ival, swap32);
+        fmask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+		_mm256_and_si256(ival, expmask), expmask));
+        fval = _mm256_castsi256_ps(ival);
+        dlo = _mm256_cvtps_pd(_mm256_castps256_ps128(fval));
+        dhi = _mm256_cvtps_pd(_mm256_extractf128_ps(fval, 1));
+        dlo = _mm256_add_pd(_mm256_mul_pd(dlo, bs), bz);
+        dhi = _mm256_add_pd(_mm256_mul_pd(dhi, bs), bz);
+        fval = _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm256_cvtpd_ps(dlo)),
+		_mm256_cvtpd_ps(dhi), 1);
+        _mm256_storeu_ps(ptr, _mm256_blendv_ps(fval, fblank, fmask));
+        }
+      for (; i<n; i++, bufdata+=4)
+        {
+         unsigned int	iuval;
+         float		fpval;
+        memcpy(&iuval, bufdata, 4);
+        if (swapflag)
+          swapbytes(&iuval, 4, 1);
+        memcpy(&fpval, &iuval, 4);
+        *(ptr++) = ((0x7f800000&iuval) == 0x7f800000)? -BIG : fpval*dbs + dbz;
+        }
+      break;
+
+    case BP_DOUBLE:
+      expmask = _mm256_set1_epi64x(0x7ff0000000000000LL);
+      for (i=0; i<nvec; i+=8, bufdata+=64, ptr+=8)
+        {
+         __m256d	dlo, dhi, dblank;
+         __m256i	ilo, ihi;
+        dblank = _mm256_set1_pd(-BIG);
+        ilo = _mm256_loadu_si256((__m256i *)bufdata);
+        ihi = _mm256_loadu_si256((__m256i *)(bufdata+32));
+        if (swapflag)
+          {
+          ilo = _mm256_shuffle_epi8(ilo, swap64);
+          ihi = _mm256_shuffle_epi8(ihi, swap64);
+          }
+        dlo = _mm256_add_pd(_mm256_mul_pd(_mm256_castsi256_pd(ilo), bs), bz);
+        dhi = _mm256_add_pd(_mm256_mul_pd(_mm256_castsi256_pd(ihi), bs), bz);
+        dlo = _mm256_blendv_pd(dlo, dblank, _mm256_castsi256_pd(
+		_mm256_cmpeq_epi64(_mm256_and_si256(ilo, expmask), expmask)));
+        dhi = _mm256_blendv_pd(dhi, dblank, _mm256_castsi256_pd(
+		_mm256_cmpeq_epi64(_mm256_and_si256(ihi, expmask), expmask)));
+        fval = _mm256_insertf128_ps(
+		_mm256_castps128_ps256(_mm256_cvtpd_ps(dlo)),
+		_mm256_cvtpd_ps(dhi), 1);
+        _mm256_storeu_ps(ptr, fval);
+        }
+      for (; i<n; i++, bufdata+=8)
+        {
+         unsigned char	raw[8];
+         unsigned int	hiword;
+         double		dval;
+        memcpy(raw, bufdata, 8);
+        if (swapflag)
+          swapbytes(raw, 8, 1);
+        memcpy(&dval, raw, 8);
+        memcpy(&hiword, raw+4, 4);
+        *(ptr++) = ((0x7ff00000 & hiword) == 0x7ff00000)? -BIG : dval*dbs+dbz;
+        }
+      break;
+
+    default:
+      return RETURN_ERROR;
+    }
+
+  return RETURN_OK;
+  }
+
+
+/****** vec_writebody_avx2 ****************************************************
+PROTO	int vec_writebody_avx2(tabstruct *tab, PIXTYPE *ptr, char *bufdata,
+		size_t n, int swapflag)
+PURPOSE	AVX2 version of the uncompressed write_body() conversion: scaling,
+	rounding, conversion to the FITS type and byte-swapping in one pass.
+INPUT	A pointer to the tab structure,
+	a pointer to the input array,
+	a pointer to the output raw data,
+	the number of elements to be converted,
+	byte-swapping flag.
+OUTPUT	RETURN_OK if the data have been converted, RETURN_ERROR otherwise.
+NOTES	Unsigned 32 bit output is left to the scalar code.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static VEC_AVX2 int	vec_writebody_avx2(tabstruct *tab, PIXTYPE *ptr,
+				char *bufdata, size_t n, int swapflag)
+  {
+   __m256	fbs, fbz, fval;
+   __m256d	half, dbs, dlo, dhi;
+   __m128i	ilo, ihi, pick8, pick16, swap32;
+   __m256i	swap64;
+   PIXTYPE	bs, bz;
+   size_t	i, nvec;
+   int		bitsgn;
+
+  bs = (PIXTYPE)tab->bscale;
+  bz = (PIXTYPE)tab->bzero;
+  bitsgn = tab->bitsgn;
+  fbs = _mm256_set1_ps(bs);
+  fbz = _mm256_set1_ps(bz);
+  dbs = _mm256_set1_pd((double)bs);
+  half = _mm256_set1_pd(0.49999);
+  nvec = n&~(size_t)7;
+  pick8 = _mm_setr_epi8(0,4,8,12, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1);
+  pick16 = swapflag?
+	_mm_setr_epi8(1,0,5,4,9,8,13,12, -1,-1,-1,-1, -1,-1,-1,-1)
+	: _mm_setr_epi8(0,1,4,5,8,9,12,13, -1,-1,-1,-1, -1,-1,-1,-1);
+  swap32 = _mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+  swap64 = _mm256_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8,
+			7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+
+/* Integer output types: (value-bzero)/bscale+0.49999, then truncation */
+#define	VEC_WRITE_ROUND							\
+        fval = _mm256_div_ps(_mm256_sub_ps(_mm256_loadu_ps(ptr), fbz), fbs);\
+        ilo = _mm256_cvttpd_epi32(_mm256_add_pd(			\
+		_mm256_cvtps_pd(_mm256_castps256_ps128(fval)), half));	\
+        ihi = _mm256_cvttpd_epi32(_mm256_add_pd(			\
+		_mm256_cvtps_pd(_mm256_extractf128_ps(fval, 1)), half))
+
+  switch(tab->bitpix)
+    {
+    case BP_BYTE:
+      for (i=0; i<nvec; i+=8, ptr+=8, bufdata+=8)
+        {
+        VEC_WRITE_ROUND;
+        _mm_storel_epi64((__m128i *)bufdata, _mm_unpacklo_epi32(
+		_mm_shuffle_epi8(ilo, pick8), _mm_shuffle_epi8(ihi, pick8)));
+        }
+      for (; i<n; i++)
+        {
+        if (bitsgn)
+          *(bufdata++) = (char)((*(ptr++)-bz)/bs+0.49999);
+        else
+          *((unsigned char *)bufdata++)=(unsigned char)((*(ptr++)-bz)/bs+0.49999);
+        }
+      break;
+
+    case BP_SHORT:
+      for (i=0; i<nvec; i+=8, ptr+=8, bufdata+=16)
+        {
+        VEC_WRITE_ROUND;
+        _mm_storeu_si128((__m128i *)bufdata, _mm_unpacklo_epi64(
+		_mm_shuffle_epi8(ilo, pick16), _mm_shuffle_epi8(ihi, pick16)));
+        }
+      for (; i<n; i++, bufdata+=2)
+        {
+         unsigned short	suval;
+        if (bitsgn)
+          suval = (unsigned short)(short)((*(ptr++)-bz)/bs+0.49999);
+        else
+          suval = (unsigned short)((*(ptr++)-bz)/bs+0.49999);
+        if (swapflag)
+          suval = (unsigned short)((suval>>8) | (suval<<8));
+        memcpy(bufdata, &suval, 2);
+        }
+      break;
+
+    case BP_LONG:
+      if (!bitsgn)
+        return RETURN_ERROR;
+      for (i=0; i<nvec; i+=8, ptr+=8, bufdata+=32)
+        {
+        VEC_WRITE_ROUND;
+        if (swapflag)
+          {
+          ilo = _mm_shuffle_epi8(ilo, swap32);
+          ihi = _mm_shuffle_epi8(ihi, swap32);
+          }
+        _mm_storeu_si128((__m128i *)bufdata, ilo);
+        _mm_storeu_si128((__m128i *)(bufdata+16), ihi);
+        }
+      for (; i<n; i++, bufdata+=4)
+        {
+         int	ival;
+        ival = (int)((*(ptr++)-bz)/bs+0.49999);
+        if (swapflag)
+          swapbytes(&ival, 4, 1);
+        memcpy(bufdata, &ival, 4);
+        }
+      break;
+
+    case BP_FLOAT:
+      for (i=0; i<nvec; i+=8, ptr+=8, bufdata+=32)
+        {
+         __m256i	ival;
+        fval = _mm256_div_ps(_mm256_sub_ps(_mm256_loadu_ps(ptr), fbz), fbs);
+        ival = _mm256_castps_si256(fval);
+        if (swapflag)
+          ival = _mm256_shuffle_epi8(ival, _mm256_broadcastsi128_si256(swap32));
+        _mm256_storeu_si256((__m256i *)bufdata, ival);
+        }
+      for (; i<n; i++, bufdata+=4)
+        {
+         float	fpval;
+        fpval = (*(ptr++)-bz)/bs;
+        if (swapflag)
+          swapbytes(&fpval, 4, 1);
+        memcpy(bufdata, &fpval, 4);
+        }
+      break;
+
+    case BP_DOUBLE:
+      for (i=0; i<nvec; i+=8, ptr+=8, bufdata+=64)
+        {
+         __m256i	iblo, ibhi;
+        fval = _mm256_sub_ps(_mm256_loadu_ps(ptr), fbz);
+        dlo = _mm256_div_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(fval)), dbs);
+        dhi = _mm256_div_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(fval, 1)),
+		dbs);
+        iblo = _mm256_castpd_si256(dlo);
+        ibhi = _mm256_castpd_si256(dhi);
+        if (swapflag)
+          {
+          iblo = _mm256_shuffle_epi8(iblo, swap64);
+          ibhi = _mm256_shuffle_epi8(ibhi, swap64);
+          }
+        _mm256_storeu_si256((__m256i *)bufdata, iblo);
+        _mm256_storeu_si256((__m256i *)(bufdata+32), ibhi);
+        }
+      for (; i<n; i++, bufdata+=8)
+        {
+         double	dval;
+        dval = (double)(*(ptr++)-bz)/bs;
+        if (swapflag)
+          swapbytes(&dval, 8, 1);
+        memcpy(bufdata, &dval, 8);
+        }
+      break;
+
+    default:
+      return RETURN_ERROR;
+    }
+
+#undef	VEC_WRITE_ROUND
+
+  return RETURN_OK;
+  }
+
+#endif	/* VEC_X86 */
+
+
+/****** vec_readbody **********************************************************
+PROTO	int vec_readbody(tabstruct *tab, char *bufdata, PIXTYPE *ptr,
+		size_t n, int swapflag)
+PURPOSE	Convert raw uncompressed FITS data to PIXTYPE with the best vector
+	kernel available.
+INPUT	A pointer to the tab structure,
+	a pointer to the raw input data,
+	a pointer to the output array,
+	the number of elements to be converted,
+	byte-swapping flag.
+OUTPUT	RETURN_OK if the data have been converted, RETURN_ERROR if the caller
+	must fall back to the scalar code.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	vec_readbody(tabstruct *tab, char *bufdata, PIXTYPE *ptr, size_t n,
+		int swapflag)
+  {
+#ifdef VEC_X86
+  if (vec_getlevel() >= VEC_LEVEL_AVX2)
+    return vec_readbody_avx2(tab, bufdata, ptr, n, swapflag);
+#endif
+
+  return RETURN_ERROR;
+  }
+
+
+/****** vec_writebody *********************************************************
+PROTO	int vec_writebody(tabstruct *tab, PIXTYPE *ptr, char *bufdata,
+		size_t n, int swapflag)
+PURPOSE	Convert PIXTYPE data to raw uncompressed FITS data with the best vector
+	kernel available.
+INPUT	A pointer to the tab structure,
+	a pointer to the input array,
+	a pointer to the output raw data,
+	the number of elements to be converted,
+	byte-swapping flag.
+OUTPUT	RETURN_OK if the data have been converted, RETURN_ERROR if the caller
+	must fall back to the scalar code.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	vec_writebody(tabstruct *tab, PIXTYPE *ptr, char *bufdata, size_t n,
+		int swapflag)
+  {
+#ifdef VEC_X86
+  if (vec_getlevel() >= VEC_LEVEL_AVX2)
+    return vec_writebody_avx2(tab, ptr, bufdata, n, swapflag);
+#endif
+
+  return RETURN_ERROR;
+  }
+
@@ -23,7 +23,7 @@
 *	along with AstrOmatic software.
 *	If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		08/03/2016
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -77,6 +77,7 @@ wcsstruct	*copy_wcs(wcsstruct *wcsin)
   wcs->tnx_lngcor = copy_tnxaxis(wcsin->tnx_lngcor);
   wcs->tnx_latcor = copy_tnxaxis(wcsin->tnx_latcor);
   wcs->inv_x = wcs->inv_y = NULL;
+  wcs->grid = NULL;
 
   QCALLOC(wcs->wcsprm, struct wcsprm, 1);
 /* Test if the WCS is recognized and a celestial pair is found */
@@ -753,7 +754,7 @@ INPUT	WCS structure.
 OUTPUT	-.
 NOTES	.
 AUTHOR	E. Bertin (IAP)
-VERSION	24/05/2000
+VERSION	19/10/2026
  ***/
 void	end_wcs(wcsstruct *wcs)
 
@@ -776,6 +777,7 @@ void	end_wcs(wcsstruct *wcs)
     free_tnxaxis(wcs->tnx_latcor);
     poly_end(wcs->inv_x);
     poly_end(wcs->inv_y);
+    end_wcsgrid(wcs);
     free(wcs->projp);
     free(wcs);
     }
@@ -1361,6 +1363,231 @@ int	raw_to_wcs(wcsstruct *wcs, double *pixpos, double *wcspos)
   }
 
 
+/******* grid_wcs *************************************************************
+PROTO	int grid_wcs(wcsstruct *wcs, double maxerr)
+PURPOSE	Tabulate the pixel-to-WCS transform on a regular grid of pixel
+	positions, for fast interpolation with raw_to_wcsgrid().
+INPUT	WCS structure,
+	maximum interpolation error allowed (in pixels).
+OUTPUT	RETURN_OK if the required accuracy was reached, RETURN_ERROR otherwise.
+NOTES	The grid step is halved from WCS_GRIDSTEPMAX to WCS_GRIDSTEPMIN until the
+	interpolation error, measured at the center of every grid cell, is
+	below maxerr. The grid extends one step beyond the image frame on each
+	side. If no grid qualifies, none is kept and raw_to_wcsgrid() falls
+	back to exact transforms. Only 2D celestial frames are handled.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	grid_wcs(wcsstruct *wcs, double maxerr)
+
+  {
+   wcsgridstruct	*grid;
+   double		raw[NAXIS], world[NAXIS], wint[NAXIS],
+			*nodex,*nodey,
+			dlng,dlat, err,errmax, invscale;
+   int			ix,iy, nx,ny, ncx,ncy, step, lng,lat, status;
+
+  end_wcsgrid(wcs);
+  lng = wcs->lng;
+  lat = wcs->lat;
+  if (wcs->naxis != 2 || lng == lat || maxerr <= 0.0 || wcs->pixscale <= 0.0)
+    return RETURN_ERROR;
+
+  invscale = 1.0/wcs->pixscale;
+  for (step=WCS_GRIDSTEPMAX; step>=WCS_GRIDSTEPMIN; step/=2)
+    {
+    ncx = (wcs->naxisn[0]+step-1)/step;
+    ncy = (wcs->naxisn[1]+step-1)/step;
+    nx = ncx+3;
+    ny = ncy+3;
+    QMALLOC(grid, wcsgridstruct, 1);
+    QMALLOC(grid->node[0], double, nx*ny);
+    QMALLOC(grid->node[1], double, nx*ny);
+    grid->x0[0] = grid->x0[1] = 0.5 - step;
+    grid->step = (double)step;
+    grid->invstep = 1.0/step;
+    grid->nnode[0] = nx;
+    grid->nnode[1] = ny;
+    grid->lngc = wcs->wcsscalepos[lng];
+    grid->maxerr = 0.0;
+    wcs->grid = grid;
+/*-- Tabulate exact transforms at grid nodes */
+    status = RETURN_OK;
+    nodex = grid->node[0];
+    nodey = grid->node[1];
+    for (iy=0; iy<ny && status==RETURN_OK; iy++)
+      {
+      raw[1] = grid->x0[1] + iy*grid->step;
+      for (ix=0; ix<nx; ix++)
+        {
+        raw[0] = grid->x0[0] + ix*grid->step;
+        if ((status = raw_to_wcs(wcs, raw, world)) != RETURN_OK)
+          break;
+        world[lng] = fmod_mmod_pmod(world[lng] - grid->lngc, 180.0);
+        *(nodex++) = world[0];
+        *(nodey++) = world[1];
+        }
+      }
+/*-- Check interpolation at the center of every cell covering the frame */
+    errmax = 0.0;
+    for (iy=1; iy<=ncy && status==RETURN_OK && errmax<=maxerr; iy++)
+      {
+      raw[1] = grid->x0[1] + (iy+0.5)*grid->step;
+      for (ix=1; ix<=ncx; ix++)
+        {
+        raw[0] = grid->x0[0] + (ix+0.5)*grid->step;
+        if ((status = raw_to_wcs(wcs, raw, world)) != RETURN_OK)
+          break;
+        raw_to_wcsgrid(wcs, raw, wint);
+        dlng = fmod_mmod_pmod(wint[lng] - world[lng], 180.0)
+		*cos(world[lat]*DEG);
+        dlat = wint[lat] - world[lat];
+        err = sqrt(dlng*dlng + dlat*dlat)*invscale;
+        if (err > errmax)
+          errmax = err;
+        }
+      }
+    if (status == RETURN_OK && errmax <= maxerr)
+      {
+      grid->maxerr = errmax;
+      return RETURN_OK;
+      }
+    end_wcsgrid(wcs);
+    }
+
+  return RETURN_ERROR;
+  }
+
+
+/******* end_wcsgrid **********************************************************
+PROTO	void end_wcsgrid(wcsstruct *wcs)
+PURPOSE	Free the interpolation grid of a WCS structure, if any.
+INPUT	WCS structure.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	end_wcsgrid(wcsstruct *wcs)
+
+  {
+  if (wcs->grid)
+    {
+    free(wcs->grid->node[0]);
+    free(wcs->grid->node[1]);
+    free(wcs->grid);
+    wcs->grid = NULL;
+    }
+
+  return;
+  }
+
+
+/******* raw_to_wcsgrid *******************************************************
+PROTO	int raw_to_wcsgrid(wcsstruct *wcs, double *pixpos, double *wcspos)
+PURPOSE	Convert raw (pixel) coordinates to WCS (World Coordinate System),
+	interpolating the grid of transforms set up by grid_wcs() if present.
+INPUT	WCS structure,
+	Pointer to the array of input coordinates,
+	Pointer to the array of output coordinates.
+OUTPUT	RETURN_OK if mapping successful, RETURN_ERROR otherwise.
+NOTES	Falls back to raw_to_wcs() if no grid is available or if the position
+	lies outside the grid.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	raw_to_wcsgrid(wcsstruct *wcs, double *pixpos, double *wcspos)
+
+  {
+  return raw_to_wcsn(wcs, pixpos, wcspos, 1);
+  }
+
+
+/******* raw_to_wcsn **********************************************************
+PROTO	int raw_to_wcsn(wcsstruct *wcs, double *pixpos, double *wcspos,
+			int npos)
+PURPOSE	Convert a series of raw (pixel) coordinates to WCS (World Coordinate
+	System), interpolating the grid of transforms set up by grid_wcs() if
+	present.
+INPUT	WCS structure,
+	Pointer to the array of input coordinates (npos*naxis),
+	Pointer to the array of output coordinates (npos*naxis),
+	Number of positions.
+OUTPUT	RETURN_OK if all mappings are successful, RETURN_ERROR otherwise.
+NOTES	Positions are interpolated with a bicubic (Catmull-Rom) kernel. Those
+	that lie outside the grid go through raw_to_wcs().
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	raw_to_wcsn(wcsstruct *wcs, double *pixpos, double *wcspos, int npos)
+
+  {
+   wcsgridstruct	*grid;
+   double		wx[4],wy[4],
+			*nodex,*nodey,
+			x,y, tx,ty, tx2,ty2, vx,vy, sx,sy;
+   int			p, i,j, ix,iy, nx, naxis, status;
+
+  naxis = wcs->naxis;
+  status = RETURN_OK;
+  if (!(grid = wcs->grid))
+    {
+    for (p=npos; p--; pixpos+=naxis, wcspos+=naxis)
+      if (raw_to_wcs(wcs, pixpos, wcspos) != RETURN_OK)
+        status = RETURN_ERROR;
+    return status;
+    }
+
+  nx = grid->nnode[0];
+  for (p=npos; p--; pixpos+=naxis, wcspos+=naxis)
+    {
+    x = (pixpos[0] - grid->x0[0])*grid->invstep;
+    y = (pixpos[1] - grid->x0[1])*grid->invstep;
+    ix = (int)floor(x);
+    iy = (int)floor(y);
+    if (x<1.0 || y<1.0 || ix>nx-3 || iy>grid->nnode[1]-3)
+      {
+      if (raw_to_wcs(wcs, pixpos, wcspos) != RETURN_OK)
+        status = RETURN_ERROR;
+      continue;
+      }
+/*-- Catmull-Rom weights */
+    tx = x - ix;
+    ty = y - iy;
+    tx2 = tx*tx;
+    ty2 = ty*ty;
+    wx[0] = 0.5*(tx2*(2.0-tx) - tx);
+    wx[1] = 0.5*(tx2*(3.0*tx-5.0) + 2.0);
+    wx[2] = 0.5*(tx2*(4.0-3.0*tx) + tx);
+    wx[3] = 0.5*tx2*(tx-1.0);
+    wy[0] = 0.5*(ty2*(2.0-ty) - ty);
+    wy[1] = 0.5*(ty2*(3.0*ty-5.0) + 2.0);
+    wy[2] = 0.5*(ty2*(4.0-3.0*ty) + ty);
+    wy[3] = 0.5*ty2*(ty-1.0);
+    nodex = grid->node[0] + (iy-1)*nx + ix-1;
+    nodey = grid->node[1] + (iy-1)*nx + ix-1;
+    vx = vy = 0.0;
+    for (j=0; j<4; j++, nodex+=nx, nodey+=nx)
+      {
+      sx = sy = 0.0;
+      for (i=0; i<4; i++)
+        {
+        sx += wx[i]*nodex[i];
+        sy += wx[i]*nodey[i];
+        }
+      vx += wy[j]*sx;
+      vy += wy[j]*sy;
+      }
+    wcspos[0] = vx;
+    wcspos[1] = vy;
+    vx = fmod(wcspos[wcs->lng] + grid->lngc, 360.0);
+    wcspos[wcs->lng] = vx<0.0? vx+360.0 : vx;
+    }
+
+  return status;
+  }
+
+
 /******* wcs_to_raw ***********************************************************
 PROTO	int wcs_to_raw(wcsstruct *, double *, double *)
 PURPOSE	Convert WCS (World Coordinate System) coords to raw (pixel) coords.
@@ -1638,29 +1865,28 @@ INPUT	WCS structure,
 OUTPUT	Determinant over spatial coordinates (=pixel area), or -1.0 if mapping
 	was unsuccesful.
 NOTES   Memory must have been allocated (naxis*naxis*sizeof(double)) for the
-        Jacobian array.
+        Jacobian array. The grid set up by grid_wcs() is used if present.
 AUTHOR	E. Bertin (IAP)
-VERSION	11/10/2007
+VERSION	19/10/2026
  ***/
 double	wcs_jacobian(wcsstruct *wcs, double *pixpos, double *jacob)
   {
-   double	pixpos0[NAXIS], wcspos0[NAXIS], wcspos[NAXIS],
-		dpos;
+   double	pixpos0[(NAXIS+1)*NAXIS], wcspos0[(NAXIS+1)*NAXIS],
+		*wcspos, dpos;
    int		i,j, lng,lat,naxis;
 
   lng = wcs->lng;
   lat = wcs->lat;
   naxis = wcs->naxis;
-  for (i=0; i<naxis; i++)
-    pixpos0[i] = pixpos[i];
-  if (raw_to_wcs(wcs, pixpos0, wcspos0) == RETURN_ERROR)
+/* Reference position followed by positions offset by 1 pixel on each axis */
+  for (i=0; i<=naxis; i++)
+    for (j=0; j<naxis; j++)
+      pixpos0[i*naxis+j] = pixpos[j] + ((i && j==i-1)? 1.0 : 0.0);
+  if (raw_to_wcsn(wcs, pixpos0, wcspos0, naxis+1) == RETURN_ERROR)
     return -1.0;
   for (i=0; i<naxis; i++)
     {
-    pixpos0[i] += 1.0;
-    if (raw_to_wcs(wcs, pixpos0, wcspos) == RETURN_ERROR)
-      return -1.0;
-    pixpos0[i] -= 1.0;
+    wcspos = wcspos0 + (i+1)*naxis;
     for (j=0; j<naxis; j++)
       {
       dpos = wcspos[j]-wcspos0[j];
@@ -24,7 +24,7 @@
 *	along with AstrOmatic software.
 *	If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		08/03/2016
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -54,6 +54,8 @@
 #define		WCS_INVMAXDEG	9	/* Maximum inversion polynom degree */
 #define		WCS_INVACCURACY	0.001	/* Maximum inversion error (pixels) */
 #define		WCS_NRANGEPOINTS 32	/* Number of WCS range points / axis */
+#define		WCS_GRIDSTEPMAX	256	/* Coarsest interpolation grid step */
+#define		WCS_GRIDSTEPMIN	8	/* Finest interpolation grid step */
 
 /*-------------------------------- typedefs ---------------------------------*/
 
@@ -62,6 +64,16 @@ typedef  enum {CELSYS_NATIVE, CELSYS_PIXEL, CELSYS_EQUATORIAL, CELSYS_GALACTIC,
 
 /*------------------------------- structures --------------------------------*/
 
+typedef struct wcsgrid
+  {
+  double	*node[NAXIS];		/* Tabulated WCS coords at grid nodes */
+  double	x0[NAXIS];		/* Pixel coordinates of the first node */
+  double	step, invstep;		/* Grid step (pixels) and its inverse */
+  int		nnode[NAXIS];		/* Number of nodes along each axis */
+  double	lngc;			/* Reference longitude of the nodes */
+  double	maxerr;			/* Measured max. interp. error (pixels)*/
+  }	wcsgridstruct;
+
 typedef struct wcs
   {
   int		naxis;			/* Number of image axes */
@@ -107,6 +119,7 @@ typedef struct wcs
   struct tnxaxis *tnx_lngcor;		/* IRAF's TNX longitude corrections */
   struct poly	*inv_x;			/* Proj. correction polynom in x */
   struct poly	*inv_y;			/* Proj. correction polynom in y */
+  wcsgridstruct	*grid;			/* Interpolation grid of raw_to_wcs()*/
   }	wcsstruct;
 
 /*------------------------------- functions ---------------------------------*/
@@ -135,10 +148,15 @@ extern int		celsys_to_eq(wcsstruct *wcs, double *wcspos),
 			eq_to_celsys(wcsstruct *wcs, double *wcspos),
 			fcmp_0_p360(double anglep, double anglem),
 			frame_wcs(wcsstruct *wcsin, wcsstruct *wcsout),
+			grid_wcs(wcsstruct *wcs, double maxerr),
 			raw_to_red(wcsstruct *wcs,
 				double *pixpos, double *redpos),
 			raw_to_wcs(wcsstruct *wcs,
 				double *pixpos, double *wcspos),
+			raw_to_wcsgrid(wcsstruct *wcs,
+				double *pixpos, double *wcspos),
+			raw_to_wcsn(wcsstruct *wcs,
+				double *pixpos, double *wcspos, int npos),
 			reaxe_wcs(wcsstruct *wcs, int lng, int lat),
 			red_to_raw(wcsstruct *wcs,
 				double *redpos, double *pixpos),
@@ -153,6 +171,7 @@ extern char		*degtosexal(double alpha, char *str),
 extern void		b2j(double yearobs, double alphain, double deltain,
 				double *alphaout, double *deltaout),
 			end_wcs(wcsstruct *wcs),
+			end_wcsgrid(wcsstruct *wcs),
 			init_wcs(wcsstruct *wcs),
 			init_wcscelsys(wcsstruct *wcs),
 			invert_wcs(wcsstruct *wcs),
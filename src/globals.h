@@ -23,11 +23,12 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		23/09/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
 #include	"types.h"
+#include	"sexlib.h"
 
 /*----------------------- miscellaneous variables ---------------------------*/
 
@@ -42,6 +43,7 @@ extern void	alloccatparams(void),
 		allocparcelout(void),
 		analyse(picstruct *, picstruct *, int, objliststruct *),
 		blankit(char *, int),
+		budgetfields(picstruct **fields, int nfield, int objsize),
                 endcat(char *error),
                 reendcat(void),
 		changecatparamarrays(char *keyword, int *axisn, int naxis),
@@ -59,12 +61,17 @@ extern void	alloccatparams(void),
 		initcat(void),
 		reinitcat(picstruct *),
 		initglob(void),
+		init_presel(void),
+		add_memimage(char *name, char *buf, size_t size),
+		free_memimages(void),
 		makeit(void),
+		makeit_end(void),
 		mergeobject(objstruct *, objstruct *),
 		neurinit(void),
 		neurclose(void),
 		neurresp(double *, double *),
 		preanalyse(int, objliststruct *, int),
+		prefetchstrips(picstruct **, int),
 		propagate_covar(double *vi, double *d, double *vo,
 				int ni, int no,	double *temp),
 		readcatparams(char *),
@@ -72,6 +79,8 @@ extern void	alloccatparams(void),
 		readidata(picstruct *, FLAGTYPE *, int),
 		readimagehead(picstruct *),
 		readprefs(char *, char **, char **, int),
+		resetcatparams(void),
+		setstripheight(picstruct *field),
 		scanimage(picstruct *, picstruct *, picstruct **, int,
 			picstruct *, picstruct *, picstruct *),
 		sexcircle(PIXTYPE *bmp, int, int, double, double, double,
@@ -92,6 +101,7 @@ extern double	counter_seconds(void);
 extern float	fqmedian(float *, int);
 
 extern int	addobj(int, objliststruct *, objliststruct *),
+		is_memimage(char *filename),
 		belong(int, objliststruct *, int, objliststruct *),
 		gatherup(objliststruct *, objliststruct *),
 		parcelout(objliststruct *, objliststruct *);
@@ -100,6 +110,10 @@ extern void	*loadstrip(picstruct *, picstruct *);
 
 extern char	*readfitshead(FILE *, char *, int *);
 
+extern catstruct	*read_imacat(char *filename);
+
+extern sexlibcatstruct	*getmemcat(void);
+
 extern picstruct	*inheritfield(picstruct *infield, int flags),
 			*newfield(char *, int , int);
 
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -39,6 +39,7 @@
 #include	"globals.h"
 #include	"prefs.h"
 #include	"growth.h"
+#include	"image.h"
 
 /*------------------------------- variables ---------------------------------*/
 
@@ -96,12 +97,14 @@ void	makeavergrowth(picstruct *field, picstruct *wfield, objstruct *obj)
    LONG			pos;
    PIXTYPE		*strip,*stript, *wstrip,*wstript,
 			pdbkg, wthresh;
+   measvigstruct	*vig, *wvig;
   
 
   if (wfield)
     wthresh = wfield->weight_thresh;
   else
     wthresh = 0.0;		/* To avoid gcc -Wall warnings */
+  wvig = NULL;
 
 /* Clear the growth-curve buffer */
   memset(growth, 0, (size_t)(GROWTH_NSTEP*sizeof(double)));
@@ -185,11 +188,14 @@ void	makeavergrowth(picstruct *field, picstruct *wfield, objstruct *obj)
   wstrip = wstript = NULL;		/* To avoid gcc -Wall warnings */
   if (wfield)
     wstrip = wfield->strip;
+  vig = measvig_get(field, strip, xmin,xmax, ymin,ymax);
+  if (wfield)
+    wvig = measvig_get(field, wstrip, xmin,xmax, ymin,ymax);
   for (y=ymin; y<ymax; y++)
     {
-    stript = strip + (pos = (y%h)*w + xmin);
+    stript = vig->pix + (y-vig->ymin)*vig->w + xmin-vig->xmin;
     if (wfield)
-      wstript = wstrip + pos;
+      wstript = wvig->pix + (y-wvig->ymin)*wvig->w + xmin-wvig->xmin;
     for (x=xmin; x<xmax; x++, stript++, wstript++)
       {
       dx = x - mx;
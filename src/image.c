@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		19/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -37,9 +37,22 @@
 #include	"define.h"
 #include	"globals.h"
 #include	"prefs.h"
+#include	"fits/fitscat.h"
 #include	"image.h"
 
-static float	interpm[INTERPW*INTERPW];
+#ifdef VEC_X86
+static VEC_AVX2 void	vignet_resamplex_avx2(float *pixin, int win, int nrow,
+			float *pixout, int nout, float *mask, int *nmask,
+			int *start),
+			vignet_resampley_avx2(float *pixin, int w,
+			float *pixout, int wout, int nout, float *mask,
+			int *nmask, int *start, float factor);
+#endif
+
+static float	interpm[INTERPW*INTERPW],
+		interptab[(INTERPTABRES+1)*INTERPW];
+static int	interptab_flag;
+static measvigstruct	measvig[MEASVIG_NPLANE];
 
 /********************************* copyimage *********************************/
 /*
@@ -468,6 +481,127 @@ void	pasteimage(picstruct *field, PIXTYPE *mask, int w,int h,
   }
 
 
+/******************************** measvig_get ********************************/
+/*
+Return a contiguous copy ("measurement vignette") of the strip pixels within
+[xmin,xmax[ x [ymin,ymax[, clipped to the rows available in the field. The
+vignette is kept until measvig_reset() is called, and grown if a later request
+does not fit, so that all measurements on the same object share one copy.
+Pixel (x,y) lies at pix[(y-ymin)*w + x-xmin], with the vignette's xmin, ymin
+and w. strip must follow the geometry of field.
+*/
+measvigstruct	*measvig_get(picstruct *field, PIXTYPE *strip,
+			int xmin, int xmax, int ymin, int ymax)
+  {
+   measvigstruct	*vig, *freevig;
+   PIXTYPE		*pixt;
+   int			i, y, w, h, size;
+
+  freevig = NULL;
+  for (i=0, vig=measvig; i<MEASVIG_NPLANE; i++, vig++)
+    if (vig->strip == strip)
+      break;
+    else if (!freevig && !vig->strip)
+      freevig = vig;
+  if (i==MEASVIG_NPLANE)
+    {
+    if (!freevig)
+      error(EXIT_FAILURE, "*Internal Error*: too many planes in ",
+		"measvig_get()");
+    vig = freevig;
+    vig->strip = strip;
+    vig->w = vig->h = 0;
+    }
+
+/* Check if the current vignette covers the request */
+  if (vig->w && xmin>=vig->xmin && xmax<=vig->xmin+vig->w
+	&& ymin>=vig->ymin && ymax<=vig->ymin+vig->h)
+    return vig;
+
+/* Merge with the current vignette and add a margin */
+  if (vig->w)
+    {
+    if (xmin>vig->xmin)
+      xmin = vig->xmin;
+    if (xmax<vig->xmin+vig->w)
+      xmax = vig->xmin+vig->w;
+    if (ymin>vig->ymin)
+      ymin = vig->ymin;
+    if (ymax<vig->ymin+vig->h)
+      ymax = vig->ymin+vig->h;
+    }
+  if ((xmin -= MEASVIG_MARGIN) < 0)
+    xmin = 0;
+  if ((xmax += MEASVIG_MARGIN) > field->width)
+    xmax = field->width;
+  if ((ymin -= MEASVIG_MARGIN) < field->ymin)
+    ymin = field->ymin;
+  if ((ymax += MEASVIG_MARGIN) > field->ymax)
+    ymax = field->ymax;
+  w = xmax - xmin;
+  h = ymax - ymin;
+  if (w<=0 || h<=0)
+    {
+    vig->w = vig->h = 0;
+    return vig;
+    }
+  if ((size = w*h) > vig->size)
+    {
+    free(vig->pix);
+    QMALLOC(vig->pix, PIXTYPE, size);
+    vig->size = size;
+    }
+
+/* Copy the strip rows */
+  pixt = vig->pix;
+  for (y=ymin; y<ymax; y++, pixt+=w)
+    memcpy(pixt, strip + (y%field->stripheight)*field->width + xmin,
+	w*sizeof(PIXTYPE));
+  vig->xmin = xmin;
+  vig->ymin = ymin;
+  vig->w = w;
+  vig->h = h;
+
+  return vig;
+  }
+
+
+/******************************* measvig_reset *******************************/
+/*
+Invalidate all measurement vignettes (e.g., when moving to another object).
+*/
+void	measvig_reset(void)
+  {
+   measvigstruct	*vig;
+   int			i;
+
+  for (i=MEASVIG_NPLANE, vig=measvig; i--; vig++)
+    {
+    vig->strip = NULL;
+    vig->w = vig->h = 0;
+    }
+
+  return;
+  }
+
+
+/******************************** measvig_end ********************************/
+/*
+Free memory allocated for measurement vignettes.
+*/
+void	measvig_end(void)
+  {
+   measvigstruct	*vig;
+   int			i;
+
+  for (i=MEASVIG_NPLANE, vig=measvig; i--; vig++)
+    free(vig->pix);
+  memset(measvig, 0, sizeof(measvig));
+
+  return;
+  }
+
+
 /****************************** vignet_resample ******************************/
 /*
 Scale and shift a small image through sinc interpolation.
@@ -477,10 +611,9 @@ int	vignet_resample(float *pix1, int w1, int h1,
 			float *pix2, int w2, int h2,
 			float dx, float dy, float step2)
   {
-   float	*mask,*maskt, xc1,xc2,yc1,yc2, xs1,ys1, x1,y1, x,y, dxm,dym,
-		val, norm,
-		*pix12, *pixin,*pixin0, *pixout,*pixout0;
-   int		i,j,k,n,t, *start,*startt, *nmask,*nmaskt,
+   float	kernel[INTERPW], *mask,*maskt, xc1,xc2,yc1,yc2, xs1,ys1, x1,y1,
+		norm, *pix12;
+   int		i,j,n,t, *start,*startt, *nmask,*nmaskt,
 		ixs2,iys2, ix2,iy2, dix2,diy2, nx2,ny2, iys1a, ny1, hmw,hmh,
 		ix,iy, ix1,iy1;
 
@@ -552,51 +685,37 @@ int	vignet_resample(float *pix1, int w1, int h1,
   maskt = mask;
   nmaskt = nmask;
   startt = start;
-  for (j=nx2; j--; x1+=step2)
+  for (j=nx2; j--; x1+=step2, maskt+=INTERPW)
     {
     ix = (ix1=(int)x1) - hmw;
-    dxm = ix1 - x1 - hmw;	/* starting point in the interpolation func */
+    make_interpkernel(x1 - ix1, kernel);
     if (ix < 0)
       {
       n = INTERPW+ix;
-      dxm -= (float)ix;
+      t = -ix;
       ix = 0;
       }
     else
+      {
       n = INTERPW;
-    if (n>(t=w1-ix))
-      n=t;
+      t = 0;
+      }
+    if (n>w1-ix)
+      n = w1-ix;
     *(startt++) = ix;
     *(nmaskt++) = n;
     norm = 0.0;
-    for (x=dxm, i=n; i--; x+=1.0)
-      norm += (*(maskt++) = INTERPF(x));
+    for (i=0; i<n; i++)
+      norm += (maskt[i] = kernel[t+i]);
     norm = norm>0.0? 1.0/norm : 1.0;
-    maskt -= n;
-    for (i=n; i--;)
-      *(maskt++) *= norm;
+    for (i=0; i<n; i++)
+      maskt[i] *= norm;
     }
 
   QCALLOC(pix12, float, nx2*ny1);	/* Intermediary frame-buffer */
 
-/* Make the interpolation in x (this includes transposition) */
-  pixin0 = pix1+iys1a*w1;
-  pixout0 = pix12;
-  for (k=ny1; k--; pixin0+=w1, pixout0++)
-    {
-    maskt = mask;
-    nmaskt = nmask;
-    startt = start;
-    pixout = pixout0;
-    for (j=nx2; j--; pixout+=ny1)
-      {
-      pixin = pixin0+*(startt++);
-      val = 0.0; 
-      for (i=*(nmaskt++); i--;)
-        val += *(maskt++)**(pixin++);
-      *pixout = val;
-      }
-    }
+/* Make the interpolation in x */
+  vignet_resamplex(pix1+iys1a*w1, w1, ny1, pix12, nx2, mask, nmask, start);
 
 /* Reallocate interpolant stuff for the y direction */
   QREALLOC(mask, float, ny2*INTERPW);	/* Interpolation masks */
@@ -609,49 +728,36 @@ int	vignet_resample(float *pix1, int w1, int h1,
   maskt = mask;
   nmaskt = nmask;
   startt = start;
-  for (j=ny2; j--; y1+=step2)
+  for (j=ny2; j--; y1+=step2, maskt+=INTERPW)
     {
     iy = (iy1=(int)y1) - hmh;
-    dym = iy1 - y1 - hmh;	/* starting point in the interpolation func */
+    make_interpkernel(y1 - iy1, kernel);
     if (iy < 0)
       {
       n = INTERPW+iy;
-      dym -= (float)iy;
+      t = -iy;
       iy = 0;
       }
     else
+      {
       n = INTERPW;
-    if (n>(t=ny1-iy))
-      n=t;
+      t = 0;
+      }
+    if (n>ny1-iy)
+      n = ny1-iy;
     *(startt++) = iy;
     *(nmaskt++) = n;
     norm = 0.0;
-    for (y=dym, i=n; i--; y+=1.0)
-      norm += (*(maskt++) = INTERPF(y));
+    for (i=0; i<n; i++)
+      norm += (maskt[i] = kernel[t+i]);
     norm = norm>0.0? 1.0/norm : 1.0;
-    maskt -= n;
-    for (i=n; i--;)
-      *(maskt++) *= norm;
+    for (i=0; i<n; i++)
+      maskt[i] *= norm;
     }
 
-/* Make the interpolation in y  and transpose once again */
-  pixin0 = pix12;
-  pixout0 = pix2+ixs2+iys2*w2;
-  for (k=nx2; k--; pixin0+=ny1, pixout0++)
-    {
-    maskt = mask;
-    nmaskt = nmask;
-    startt = start;
-    pixout = pixout0;
-    for (j=ny2; j--; pixout+=w2)
-      {
-      pixin = pixin0+*(startt++);
-      val = 0.0; 
-      for (i=*(nmaskt++); i--;)
-        val += *(maskt++)**(pixin++);
-      *pixout = val;
-      }
-    }
+/* Make the interpolation in y */
+  vignet_resampley(pix12, nx2, pix2+ixs2+iys2*w2, w2, ny2, mask, nmask, start,
+	1.0);
 
 /* Free memory */
   free(pix12);
@@ -663,6 +769,257 @@ int	vignet_resample(float *pix1, int w1, int h1,
   }
 
 
+/***************************** init_interpkernel *****************************/
+/*
+Tabulate the normalized INTERPW-tap Lanczos kernel used by make_interpkernel().
+Must be called before any measurement thread is started.
+*/
+void	init_interpkernel(void)
+  {
+   double	dval[INTERPW], norm, x;
+   float	*tab;
+   int		i,k;
+
+  if (interptab_flag)
+    return;
+
+  tab = interptab;
+  for (k=0; k<=INTERPTABRES; k++, tab+=INTERPW)
+    {
+    norm = 0.0;
+    for (i=0; i<INTERPW; i++)
+      {
+      x = (double)(i - INTERPW/2 + 1) - (double)k/INTERPTABRES;
+      norm += (dval[i] = INTERPF(x));
+      }
+    for (i=0; i<INTERPW; i++)
+      tab[i] = (float)(dval[i]/norm);
+    }
+  interptab_flag = 1;
+
+  return;
+  }
+
+
+/***************************** make_interpkernel *****************************/
+/*
+Compute the normalized INTERPW-tap Lanczos kernel at fractional position pos
+(0 <= pos <= 1) by linear interpolation of the kernel tabulated by
+init_interpkernel(). Other positions are computed directly.
+*/
+void	make_interpkernel(float pos, float *kernel)
+  {
+   double	dval[INTERPW], norm, x;
+   float	*tab, *tab2, t;
+   int		i,k;
+
+  if (pos>=0.0f && pos<=1.0f)
+    {
+    t = pos*INTERPTABRES;
+    if ((k=(int)t) >= INTERPTABRES)
+      k = INTERPTABRES-1;
+    t -= (float)k;
+    tab = interptab + k*INTERPW;
+    tab2 = tab + INTERPW;
+    for (i=0; i<INTERPW; i++)
+      kernel[i] = tab[i] + t*(tab2[i]-tab[i]);
+    }
+  else
+    {
+    norm = 0.0;
+    for (i=0; i<INTERPW; i++)
+      {
+      x = (double)(i - INTERPW/2 + 1) - pos;
+      norm += (dval[i] = INTERPF(x));
+      }
+    for (i=0; i<INTERPW; i++)
+      kernel[i] = (float)(dval[i]/norm);
+    }
+
+  return;
+  }
+
+
+/***************************** vignet_resamplex *****************************/
+/*
+Resample the nrow rows of a raster along x. mask holds INTERPW coefficients
+for each of the nout output pixels, of which the first nmask apply to input
+pixels starting at start.
+*/
+void	vignet_resamplex(float *pixin, int win, int nrow, float *pixout,
+			int nout, float *mask, int *nmask, int *start)
+  {
+   float	*pixint, *maskt, val;
+   int		i,j,k;
+
+#ifdef VEC_X86
+  if (vec_getlevel() >= VEC_LEVEL_AVX2)
+    {
+    vignet_resamplex_avx2(pixin, win, nrow, pixout, nout, mask, nmask, start);
+    return;
+    }
+#endif
+
+  for (k=nrow; k--; pixin+=win)
+    for (j=0, maskt=mask; j<nout; j++, maskt+=INTERPW)
+      {
+      pixint = pixin + start[j];
+      val = 0.0;
+      for (i=0; i<nmask[j]; i++)
+        val += maskt[i]*pixint[i];
+      *(pixout++) = val;
+      }
+
+  return;
+  }
+
+
+/***************************** vignet_resampley *****************************/
+/*
+Resample a raster of width w along y, writing the nout output rows with a
+stride of wout pixels and a multiplicative factor. Masks are organized as in
+vignet_resamplex().
+*/
+void	vignet_resampley(float *pixin, int w, float *pixout, int wout,
+			int nout, float *mask, int *nmask, int *start,
+			float factor)
+  {
+   float	*pixint, *maskt, val;
+   int		i,j,x;
+
+#ifdef VEC_X86
+  if (vec_getlevel() >= VEC_LEVEL_AVX2)
+    {
+    vignet_resampley_avx2(pixin, w, pixout, wout, nout, mask, nmask, start,
+	factor);
+    return;
+    }
+#endif
+
+  for (j=0, maskt=mask; j<nout; j++, maskt+=INTERPW, pixout+=wout)
+    for (x=0; x<w; x++)
+      {
+      pixint = pixin + start[j]*w + x;
+      val = 0.0;
+      for (i=0; i<nmask[j]; i++, pixint+=w)
+        val += maskt[i]**pixint;
+      pixout[x] = factor*val;
+      }
+
+  return;
+  }
+
+
+#ifdef VEC_X86
+/************************** vignet_resamplex_avx2 ***************************/
+/*
+AVX2 version of vignet_resamplex(). Blocks of 8 output pixels with full-width
+masks are computed with gathers; the summation order is that of the scalar
+code, hence results are identical.
+*/
+static VEC_AVX2 void	vignet_resamplex_avx2(float *pixin, int win, int nrow,
+			float *pixout, int nout, float *mask, int *nmask,
+			int *start)
+  {
+   __m256	vval;
+   __m256i	vstart, vi;
+   float	*maskv, *pixint, *maskt, val;
+   int		*full, i,j,k,l;
+
+/* Flag blocks where all masks are complete, and reorder their coefficients */
+  QMALLOC(full, int, nout/8+1);
+  QMALLOC(maskv, float, (nout/8+1)*8*INTERPW);
+  for (j=0; j+8<=nout; j+=8)
+    {
+    full[j/8] = 1;
+    for (l=0; l<8; l++)
+      {
+      if (nmask[j+l]!=INTERPW)
+        full[j/8] = 0;
+      for (i=0; i<INTERPW; i++)
+        maskv[j*INTERPW + i*8 + l] = mask[(j+l)*INTERPW + i];
+      }
+    }
+
+  for (k=nrow; k--; pixin+=win)
+    {
+    for (j=0; j+8<=nout; j+=8)
+      {
+      if (!full[j/8])
+        continue;
+      vstart = _mm256_loadu_si256((__m256i *)(start+j));
+      vval = _mm256_setzero_ps();
+      for (i=0; i<INTERPW; i++)
+        {
+        vi = _mm256_add_epi32(vstart, _mm256_set1_epi32(i));
+        vval = _mm256_add_ps(vval,
+		_mm256_mul_ps(_mm256_loadu_ps(maskv + j*INTERPW + i*8),
+			_mm256_i32gather_ps(pixin, vi, 4)));
+        }
+      _mm256_storeu_ps(pixout+j, vval);
+      }
+/*-- Incomplete blocks and leftovers */
+    for (j=0, maskt=mask; j<nout; j++, maskt+=INTERPW)
+      {
+      if (j<(nout/8)*8 && full[j/8])
+        continue;
+      pixint = pixin + start[j];
+      val = 0.0;
+      for (i=0; i<nmask[j]; i++)
+        val += maskt[i]*pixint[i];
+      pixout[j] = val;
+      }
+    pixout += nout;
+    }
+
+  free(full);
+  free(maskv);
+
+  return;
+  }
+
+
+/************************** vignet_resampley_avx2 ***************************/
+/*
+AVX2 version of vignet_resampley(). Output rows are accumulated 8 pixels at
+a time in the same order as in the scalar code.
+*/
+static VEC_AVX2 void	vignet_resampley_avx2(float *pixin, int w,
+			float *pixout, int wout, int nout, float *mask,
+			int *nmask, int *start, float factor)
+  {
+   __m256	vval, vfac;
+   float	*pixint, *maskt, val;
+   int		i,j,x;
+
+  vfac = _mm256_set1_ps(factor);
+  for (j=0, maskt=mask; j<nout; j++, maskt+=INTERPW, pixout+=wout)
+    {
+    for (x=0; x+8<=w; x+=8)
+      {
+      pixint = pixin + start[j]*w + x;
+      vval = _mm256_setzero_ps();
+      for (i=0; i<nmask[j]; i++, pixint+=w)
+        vval = _mm256_add_ps(vval,
+		_mm256_mul_ps(_mm256_set1_ps(maskt[i]),
+			_mm256_loadu_ps(pixint)));
+      _mm256_storeu_ps(pixout+x, _mm256_mul_ps(vfac, vval));
+      }
+    for (; x<w; x++)
+      {
+      pixint = pixin + start[j]*w + x;
+      val = 0.0;
+      for (i=0; i<nmask[j]; i++, pixint+=w)
+        val += maskt[i]**pixint;
+      pixout[x] = factor*val;
+      }
+    }
+
+  return;
+  }
+#endif
+
+
 /********************************* addtobig *********************************/
 /*
 Add an image to another (with a multiplicative factor).
@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		19/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -31,6 +31,9 @@
 
 #define INTERPW		8	/* Interpolation function range */
 #define	INTERPFAC	4.0	/* Interpolation envelope factor */
+#define	INTERPTABRES	1024	/* Interpolation kernel table steps per pixel */
+#define	MEASVIG_NPLANE	6	/* Max. number of cached measurement planes */
+#define	MEASVIG_MARGIN	4	/* Extra margin of measurement vignettes */
 
 #define	INTERPF(x)	(x<1e-5 && x>-1e-5? 1.0 \
 			:(x>INTERPFAC?0.0:(x<-INTERPFAC?0.0 \
@@ -39,6 +42,15 @@
 
 /*--------------------------- structure definitions -------------------------*/
 
+typedef struct measvig
+  {
+  PIXTYPE	*strip;			/* Source strip (NULL if unused) */
+  PIXTYPE	*pix;			/* Contiguous copy of strip pixels */
+  int		xmin,ymin;		/* Field coordinates of first pixel */
+  int		w,h;			/* Vignette dimensions (0 if invalid) */
+  int		size;			/* Allocated number of pixels */
+  }	measvigstruct;
+
 
 /*----------------------------- Global variables ----------------------------*/
 
@@ -54,7 +66,20 @@ extern void    	addimage(picstruct *field, float *psf,
 		addimage_center(picstruct *field, float *psf,
 			int w,int h, float x, float y, float amplitude),
 		blankimage(picstruct *, PIXTYPE *, int,int, int,int, PIXTYPE),
-		pasteimage(picstruct *, PIXTYPE *, int ,int, int, int);
+		init_interpkernel(void),
+		make_interpkernel(float pos, float *kernel),
+		measvig_end(void),
+		measvig_reset(void),
+		pasteimage(picstruct *, PIXTYPE *, int ,int, int, int),
+		vignet_resamplex(float *pixin, int win, int nrow,
+			float *pixout, int nout, float *mask, int *nmask,
+			int *start),
+		vignet_resampley(float *pixin, int w, float *pixout,
+			int wout, int nout, float *mask, int *nmask,
+			int *start, float factor);
+
+extern measvigstruct	*measvig_get(picstruct *field, PIXTYPE *strip,
+			int xmin, int xmax, int ymin, int ymax);
 
 extern int	copyimage(picstruct *, PIXTYPE *, int, int, int, int),
 		copyimage_center(picstruct *, PIXTYPE *, int,int, float,float),
@@ -7,7 +7,7 @@
 *
 *	This file part of:	SExtractor
 *
-*	Copyright:		(C) 2007-2020 IAP/CNRS/SorbonneU
+*	Copyright:		(C) 2007-2026 IAP/CNRS/SorbonneU
 *
 *	License:		GNU General Public License
 *
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/02/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -34,21 +34,73 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#ifdef USE_THREADS
+#include <pthread.h>
+#endif
 
 #include "ldactoasc.h"
 #include "fits/fitscat.h"
 
-#define		SYNTAX  "ldactoasc catalog\n"
+#define		SYNTAX  "ldactoasc catalog [-c column1[,column2,...]]\n" \
+		"          [-s cut1[,cut2,...]] [-t nthreads]\n" \
+		"Columns: NAME or NAME(element)\n" \
+		"Cuts: NAME[(element)] followed by <, <=, >, >=, == or != and a " \
+		"number\n"
 extern const char	notokstr[];
 
+static void	chunk_grow(chunkstruct *chunk, int n),
+		format_chunk(chunkstruct *chunk),
+		get_elem(char *ptr, int esize, char *elem);
+
+static double	elem_todouble(char *elem, keystruct *key);
+
+static int	parse_columns(tabstruct *tab, char *str, colstruct *col),
+		parse_cuts(tabstruct *tab, char *str, cutstruct *cut),
+		select_row(char *row);
+
+static keystruct	*find_column(tabstruct *tab, char *name, int *elem);
+
+#ifdef USE_THREADS
+static void	*pthread_format(void *arg);
+#endif
+
+/* Append one formatted value to the text buffer of a chunk */
+#define	CHUNK_PRINT(chunk, format, val) \
+	do {int n_; \
+	while ((size_t)(n_=snprintf((chunk)->text+(chunk)->ntext, \
+		(chunk)->ntextmax-(chunk)->ntext, format, val)) \
+		>= (chunk)->ntextmax-(chunk)->ntext) \
+	  chunk_grow(chunk, n_); \
+	(chunk)->ntext += n_;} while (0)
+
+/* Append one character to the text buffer of a chunk */
+#define	CHUNK_PUTC(chunk, c) \
+	do {if ((chunk)->ntext >= (chunk)->ntextmax) \
+	  chunk_grow(chunk, 1); \
+	(chunk)->text[(chunk)->ntext++] = (c);} while (0)
+
+static colstruct	column[MAXCOLUMN];
+static cutstruct	cut[MAXCOLUMN];
+static int		ncolumn, ncut, rowsize, bswapflag;
+
 /********************************** main ************************************/
 int	main(int argc, char *argv[])
 
   {
    catstruct		*cat;
    tabstruct		*tab;
-   char			catname[MAXCHAR];
-   int			a, t, opt,opt2, flag;
+   keystruct		*key;
+   chunkstruct		*chunk;
+#ifdef USE_THREADS
+   pthread_t		*thread;
+#endif
+   char			catname[MAXCHAR], *colstr, *cutstr;
+   unsigned short	ashort = 1;
+   size_t		nrowleft;
+   int			a, c, k, n, t, nc, opt,opt2, flag, nthreads, nchunkrow,
+			larray;
 
   if (argc<2)
     {
@@ -59,6 +111,8 @@ int	main(int argc, char *argv[])
     }
 
 /* Default parameters */
+  colstr = cutstr = NULL;
+  nthreads = 0;
   for (a=1; a<argc; a++)
     {
     if (*(argv[a]) == '-')
@@ -73,6 +127,24 @@ int	main(int argc, char *argv[])
         }
       switch(opt)
         {
+        case 'c':
+          if (a<(argc-1))
+            colstr = argv[++a];
+          else
+            error(EXIT_SUCCESS, "SYNTAX: ", SYNTAX);
+          break;
+        case 's':
+          if (a<(argc-1))
+            cutstr = argv[++a];
+          else
+            error(EXIT_SUCCESS, "SYNTAX: ", SYNTAX);
+          break;
+        case 't':
+          if (a<(argc-1))
+            nthreads = atoi(argv[++a]);
+          else
+            error(EXIT_SUCCESS, "SYNTAX: ", SYNTAX);
+          break;
         case 'v':
           printf("%s version %s (%s)\n", BANNER,MYVERSION,DATE);
           exit(EXIT_SUCCESS);
@@ -90,22 +162,384 @@ int	main(int argc, char *argv[])
       strcpy(catname, argv[a]);
     }
 
+#ifdef USE_THREADS
+  if (nthreads <= 0)
+    nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (nthreads > THREADS_NMAX)
+    nthreads = THREADS_NMAX;
+  QMALLOC(thread, pthread_t, nthreads);
+#endif
+  if (nthreads < 1)
+    nthreads = 1;
+  QCALLOC(chunk, chunkstruct, nthreads);
+  bswapflag = *((char *)&ashort);	// Byte-swapping flag
+
   flag = 1;	/* display banner of first extension */
-  if ((cat = read_cat(catname)))
+  if (!(cat = read_cat(catname)))
+    error(EXIT_FAILURE,"Cannot open ",catname);
+
+  tab = cat->tab;
+  for (t=cat->ntab; t--; tab=tab->nexttab)
     {
-    tab = cat->tab;
-    for (t=cat->ntab; t--; tab=tab->nexttab)
-      if (!strcmp("LDAC_OBJECTS", tab->extname)
-	  || !strcmp("OBJECTS", tab->extname))
+    if (strcmp("LDAC_OBJECTS", tab->extname)
+	&& strcmp("OBJECTS", tab->extname))
+      continue;
+    if ((tab->naxis != 2)
+	|| (tab->bitpix!=8)
+	|| (tab->tfields == 0)
+	|| strncmp(tab->xtension, "BINTABLE", 8))
+      error(EXIT_FAILURE, "*Error*: Not a binary table in ", cat->filename);
+/*-- Columns to print and selection cuts */
+    if (colstr)
+      ncolumn = parse_columns(tab, colstr, column);
+    else
+      {
+      key = tab->key;
+      for (ncolumn=0; ncolumn<tab->nkey && ncolumn<MAXCOLUMN;
+		ncolumn++, key=key->nextkey)
+        {
+        column[ncolumn].key = key;
+        column[ncolumn].elem = 0;
+        }
+      }
+    ncut = cutstr? parse_cuts(tab, cutstr, cut) : 0;
+/*-- Banner */
+    if (flag)
+      {
+      for (n=1, c=0; c<ncolumn; c++)
         {
-        show_keys(tab, NULL, NULL, 0, NULL, stdout, 1, flag, 0, SHOW_ASCII);
-        flag = 0;
+        key = column[c].key;
+        if (*key->unit)
+          printf("# %3d %-15.15s %-47.47s [%s]\n",
+		n, key->name, key->comment, key->unit);
+        else
+          printf("# %3d %-15.15s %.47s\n", n, key->name, key->comment);
+        n += column[c].elem? 1 : key->nbytes/t_size[key->ttype];
         }
-    free_cat(&cat, 1);
+      flag = 0;
+      }
+/*-- Read rows by chunks, and format chunks in parallel */
+    rowsize = larray = tab->naxisn[0];
+    if ((nchunkrow = CHUNK_SIZE/larray) < 1)
+      nchunkrow = 1;
+    for (c=0; c<nthreads; c++)
+      QREALLOC(chunk[c].row, char, (size_t)nchunkrow*larray);
+    open_cat(cat, READ_ONLY);
+    QFSEEK(cat->file, tab->bodypos, SEEK_SET, cat->filename);
+    for (nrowleft=tab->naxisn[1]; nrowleft;)
+      {
+      for (nc=0; nc<nthreads && nrowleft; nc++)
+        {
+        chunk[nc].nrow = nrowleft<nchunkrow? (int)nrowleft : nchunkrow;
+        QFREAD(chunk[nc].row, (size_t)chunk[nc].nrow*larray, cat->file,
+		cat->filename);
+        nrowleft -= chunk[nc].nrow;
+        }
+#ifdef USE_THREADS
+      if (nc>1)
+        {
+        for (c=0; c<nc; c++)
+          if (pthread_create(&thread[c], NULL, pthread_format, &chunk[c]))
+            error(EXIT_FAILURE, "*Error*: ", "cannot create thread");
+        for (c=0; c<nc; c++)
+          pthread_join(thread[c], NULL);
+        }
+      else
+#endif
+        for (c=0; c<nc; c++)
+          format_chunk(&chunk[c]);
+/*---- Output in the original row order */
+      for (c=0; c<nc; c++)
+        if (chunk[c].ntext)
+          QFWRITE(chunk[c].text, chunk[c].ntext, stdout, "standard output");
+      }
     }
-  else
-    error(EXIT_FAILURE,"Cannot open ",catname);
+
+  free_cat(&cat, 1);
+  for (k=0; k<nthreads; k++)
+    {
+    free(chunk[k].row);
+    free(chunk[k].text);
+    }
+  free(chunk);
+#ifdef USE_THREADS
+  free(thread);
+#endif
 
   return EXIT_SUCCESS;
   }
 
+
+#ifdef USE_THREADS
+/******************************* pthread_format ******************************/
+/*
+Thread entry point: format one chunk of rows.
+*/
+static void	*pthread_format(void *arg)
+
+  {
+  format_chunk((chunkstruct *)arg);
+
+  return NULL;
+  }
+#endif
+
+
+/******************************** format_chunk *******************************/
+/*
+Format the selected columns of the selected rows in a chunk as ASCII text.
+*/
+static void	format_chunk(chunkstruct *chunk)
+
+  {
+   keystruct	*key;
+   char		*row, *ptr, elem[8];
+   int		c, i, j, nelem, esize;
+
+  chunk->ntext = 0;
+  for (i=chunk->nrow, row=chunk->row; i--; row += rowsize)
+    {
+    if (ncut && !select_row(row))
+      continue;
+    for (c=0; c<ncolumn; c++)
+      {
+      key = column[c].key;
+      esize = t_size[key->ttype];
+      nelem = key->nbytes/esize;
+      ptr = row + key->pos;
+      for (j=0; j<nelem; j++, ptr += esize)
+        {
+        if (column[c].elem && column[c].elem != j+1)
+          continue;
+        get_elem(ptr, esize, elem);
+        switch(key->ttype)
+          {
+          case T_SHORT:
+            CHUNK_PRINT(chunk, *key->printf?key->printf:"%d", *(short *)elem);
+            break;
+          case T_LONG:
+            CHUNK_PRINT(chunk, *key->printf?key->printf:"%d", *(int *)elem);
+            break;
+          case T_LONGLONG:
+#ifdef HAVE_LONG_LONG_INT
+            CHUNK_PRINT(chunk, *key->printf?key->printf:"%lld",
+		*(SLONGLONG *)elem);
+#else
+            CHUNK_PRINT(chunk, *key->printf?key->printf:"%d", *(int *)elem);
+#endif
+            break;
+          case T_FLOAT:
+            CHUNK_PRINT(chunk, *key->printf?key->printf:"%g", *(float *)elem);
+            break;
+          case T_DOUBLE:
+            CHUNK_PRINT(chunk, *key->printf?key->printf:"%f",*(double *)elem);
+            break;
+          case T_BYTE:
+            if (key->htype==H_BOOL)
+              CHUNK_PUTC(chunk, *elem? 'T' : 'F');
+            else
+              CHUNK_PRINT(chunk, *key->printf?key->printf:"%d",
+			(int)*((unsigned char *)elem));
+            break;
+          case T_STRING:
+            if (!*elem)
+              j = nelem;
+            else
+              CHUNK_PUTC(chunk, *elem);
+            continue;
+          default:
+            error(EXIT_FAILURE, "*FATAL ERROR*: Unknown FITS type in ",
+		"format_chunk()");
+            break;
+          }
+/*------ Element separators (as in former versions for full catalogs) */
+        if (column[c].elem)
+          continue;
+        if ((key->ttype==T_BYTE)? (key->htype!=H_BOOL && j) : (j<nelem-1))
+          CHUNK_PUTC(chunk, ' ');
+        }
+      if (c < ncolumn-1)
+        CHUNK_PUTC(chunk, ' ');
+      }
+    CHUNK_PUTC(chunk, '\n');
+    }
+
+  return;
+  }
+
+
+/********************************* chunk_grow ********************************/
+/*
+Enlarge the text buffer of a chunk to fit at least n more characters.
+*/
+static void	chunk_grow(chunkstruct *chunk, int n)
+
+  {
+  chunk->ntextmax = 2*chunk->ntextmax + n + 1024;
+  QREALLOC(chunk->text, char, chunk->ntextmax);
+
+  return;
+  }
+
+
+/********************************* select_row ********************************/
+/*
+Apply the selection cuts to a row. Return 1 if the row passes all cuts.
+*/
+static int	select_row(char *row)
+
+  {
+   cutstruct	*pcut;
+   char		elem[8];
+   double	val;
+   int		c, esize;
+
+  for (c=ncut, pcut=cut; c--; pcut++)
+    {
+    esize = t_size[pcut->key->ttype];
+    get_elem(row + pcut->key->pos + (pcut->elem-1)*esize, esize, elem);
+    val = elem_todouble(elem, pcut->key);
+    switch(pcut->op)
+      {
+      case CUT_LT:	if (!(val < pcut->value)) return 0; break;
+      case CUT_LE:	if (!(val <= pcut->value)) return 0; break;
+      case CUT_GT:	if (!(val > pcut->value)) return 0; break;
+      case CUT_GE:	if (!(val >= pcut->value)) return 0; break;
+      case CUT_EQ:	if (!(val == pcut->value)) return 0; break;
+      case CUT_NE:	if (!(val != pcut->value)) return 0; break;
+      }
+    }
+
+  return 1;
+  }
+
+
+/********************************* get_elem **********************************/
+/*
+Copy one (big-endian) table element to native byte order.
+*/
+static void	get_elem(char *ptr, int esize, char *elem)
+
+  {
+   int	i;
+
+  if (bswapflag)
+    for (i=esize; i--;)
+      elem[i] = *(ptr++);
+  else
+    memcpy(elem, ptr, esize);
+
+  return;
+  }
+
+
+/******************************* elem_todouble *******************************/
+/*
+Convert one native table element to double.
+*/
+static double	elem_todouble(char *elem, keystruct *key)
+
+  {
+  switch(key->ttype)
+    {
+    case T_BYTE:	return (double)*((unsigned char *)elem);
+    case T_SHORT:	return (double)*((short *)elem);
+    case T_LONG:	return (double)*((int *)elem);
+#ifdef HAVE_LONG_LONG_INT
+    case T_LONGLONG:	return (double)*((SLONGLONG *)elem);
+#endif
+    case T_FLOAT:	return (double)*((float *)elem);
+    case T_DOUBLE:	return *((double *)elem);
+    default:
+      error(EXIT_FAILURE, "*Error*: cannot apply a cut to column ", key->name);
+    }
+
+  return 0.0;
+  }
+
+
+/******************************** find_column ********************************/
+/*
+Find a table column from a NAME or NAME(element) string.
+*/
+static keystruct	*find_column(tabstruct *tab, char *name, int *elem)
+
+  {
+   keystruct	*key;
+   char		str[MAXCHAR], *pstr;
+
+  strncpy(str, name, MAXCHAR-1);
+  str[MAXCHAR-1] = '\0';
+  *elem = 0;
+  if ((pstr = strchr(str, '(')))
+    {
+    *(pstr++) = '\0';
+    *elem = atoi(pstr);
+    }
+  if (!(key = name_to_key(tab, str)))
+    error(EXIT_FAILURE, "*Error*: no such column in catalog: ", str);
+  if (*elem<0 || *elem > key->nbytes/t_size[key->ttype])
+    error(EXIT_FAILURE, "*Error*: element out of range in ", name);
+
+  return key;
+  }
+
+
+/******************************* parse_columns *******************************/
+/*
+Parse a comma-separated list of columns. Return the number of columns.
+*/
+static int	parse_columns(tabstruct *tab, char *str, colstruct *col)
+
+  {
+   char		list[MAXCHAR*16], *name, *last;
+   int		n;
+
+  strncpy(list, str, sizeof(list)-1);
+  list[sizeof(list)-1] = '\0';
+  n = 0;
+  for (name=strtok_r(list, ",", &last); name && n<MAXCOLUMN;
+	name=strtok_r(NULL, ",", &last), n++)
+    col[n].key = find_column(tab, name, &col[n].elem);
+
+  return n;
+  }
+
+
+/********************************* parse_cuts ********************************/
+/*
+Parse a comma-separated list of selection cuts. Return the number of cuts.
+*/
+static int	parse_cuts(tabstruct *tab, char *str, cutstruct *cut)
+
+  {
+   static const char	*opstr[] = {"<", "<=", ">", ">=", "==", "!="};
+   char			list[MAXCHAR*16], *name, *last, *op, *end;
+   int			n, o;
+
+  strncpy(list, str, sizeof(list)-1);
+  list[sizeof(list)-1] = '\0';
+  n = 0;
+  for (name=strtok_r(list, ",", &last); name && n<MAXCOLUMN;
+	name=strtok_r(NULL, ",", &last), n++)
+    {
+    if (!(op = strpbrk(name, "<>=!")))
+      error(EXIT_FAILURE, "*Error*: no comparison operator in cut ", name);
+    for (o=CUT_NE; o>=CUT_LT; o--)
+      if (!strncmp(op, opstr[o], strlen(opstr[o])))
+        break;
+    if (o<CUT_LT)
+      error(EXIT_FAILURE, "*Error*: unknown comparison operator in cut ", name);
+    cut[n].op = (cutenum)o;
+    cut[n].value = strtod(op+strlen(opstr[o]), &end);
+    if (end == op+strlen(opstr[o]))
+      error(EXIT_FAILURE, "*Error*: no number in cut ", name);
+    *op = '\0';
+    cut[n].key = find_column(tab, name, &cut[n].elem);
+    if (!cut[n].elem)
+      cut[n].elem = 1;
+    }
+
+  return n;
+  }
+
@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -59,6 +59,8 @@
 #define		OUTPUT		stdout		/* where all msgs are sent */
 #define		MAXCHAR		512		/* max. number of characters */
 #define		MAXFILE		32768		/* max number of input files */
+#define		MAXCOLUMN	1024		/* max. number of columns/cuts */
+#define		CHUNK_SIZE	(4*1024*1024)	/* rows read at once (bytes) */
 
 /*------------ Set defines according to machine's specificities -------------*/
 
@@ -82,6 +84,32 @@
 #define		EXIT_FAILURE	-1
 #endif
 
+/*--------------------------------- typedefs --------------------------------*/
+
+typedef enum	{CUT_LT, CUT_LE, CUT_GT, CUT_GE, CUT_EQ, CUT_NE}	cutenum;
+
+typedef struct
+  {
+  struct structkey	*key;		/* table column */
+  int			elem;		/* element number (from 1), 0 = all */
+  }	colstruct;
+
+typedef struct
+  {
+  struct structkey	*key;		/* table column */
+  int			elem;		/* element number (from 1) */
+  cutenum		op;		/* comparison operator */
+  double		value;		/* threshold */
+  }	cutstruct;
+
+typedef struct
+  {
+  char		*row;			/* raw table rows */
+  int		nrow;			/* number of rows */
+  char		*text;			/* formatted rows */
+  size_t	ntext, ntextmax;	/* text length, allocated size */
+  }	chunkstruct;
+
 /*---------------------------- return messages ------------------------------*/
 
 #define		RETURN_OK		0
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		09/01/2018
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -34,6 +34,7 @@
 #include	<stdio.h>
 #include	<stdlib.h>
 #include	<string.h>
+#include	<unistd.h>
 
 #include	"define.h"
 #include	"globals.h"
@@ -43,16 +44,21 @@
 EXECUTABLE " <image> [<image2>][-c <configuration_file>][-<keyword> <value>]\n" \
 "> to dump a default configuration file:          " EXECUTABLE " -d \n" \
 "> to dump a default extended configuration file: " EXECUTABLE " -dd \n" \
-"> to dump a full list of measurement parameters: " EXECUTABLE " -dp \n"
+"> to dump a full list of measurement parameters: " EXECUTABLE " -dp \n" \
+"> to process a list of jobs, one per line:       " EXECUTABLE " -b <job_file|->\n"
 
 extern const char       notokstr[];
 extern keystruct	objkey[];
 
+static int		batchskip(int njob, char *msg1, char *msg2);
+
+static void		batchit(char **argkey, char **argval, int narg),
+			printdone(void);
+
 /********************************** main ************************************/
 int	main(int argc, char *argv[])
 
   {
-   double	tdiff, lines, dets;
    int		a, narg, nim, opt, opt2;
    char		str[MAXCHARL],
 		**argkey, **argval,
@@ -75,6 +81,7 @@ setlinebuf(stdout);
   prefs.command_line = argv;
   prefs.ncommand_line = argc;
   prefs.pipe_flag = 0;
+  prefs.batch_flag = 0;
   prefs.nimage_name = 1;
   strcpy(prefs.image_name[0], "image");
   strcpy(prefs.prefs_name, "default.sex");
@@ -82,7 +89,7 @@ setlinebuf(stdout);
 
   for (a=1; a<argc; a++)
     {
-    if (*(argv[a]) == '-')
+    if (*(argv[a]) == '-' && argv[a][1])
       {
       opt = (int)argv[a][1];
       if (strlen(argv[a])<4 || opt == '-')
@@ -95,6 +102,13 @@ setlinebuf(stdout);
           }
         switch(opt)
           {
+          case 'b':
+            if (a<(argc-1))
+              {
+              prefs.batch_flag = 1;
+              strcpy(prefs.batch_name, argv[++a]);
+              }
+            break;
           case 'c':
             if (a<(argc-1))
               strcpy(prefs.prefs_name, argv[++a]);
@@ -127,7 +141,7 @@ setlinebuf(stdout);
     else
       {
 /*---- The input image filename(s) */
-      for(; (a<argc) && (*argv[a]!='-'); a++)
+      for(; (a<argc) && (*argv[a]!='-' || !argv[a][1]); a++)
         {
         strncpy(str, argv[a], MAXCHARL-1);
         for (pstr=NULL;(pstr=strtok(pstr?NULL:str, notokstr)); nim++)
@@ -141,15 +155,157 @@ setlinebuf(stdout);
       }
     }
 
-  readprefs(prefs.prefs_name, argkey, argval, narg);
-  preprefs();
+  if (prefs.batch_flag)
+    batchit(argkey, argval, narg);
+  else
+    {
+    readprefs(prefs.prefs_name, argkey, argval, narg);
+    preprefs();
+    makeit();
+    endprefs();
+    printdone();
+    }
 
   free(argkey);
   free(argval);
 
-  makeit();
+  return EXIT_SUCCESS;
+  }
+
+
+/********************************** batchit *********************************/
+/*
+Process a list of jobs read from a file, a named pipe or the standard input
+("-"), one per line. Each line contains the input image name(s), optionally
+followed by -<keyword> <value> pairs that override the command-line settings.
+Filters, neural network weights, SOMs, PSFs and models are loaded once and
+kept in memory from one job to the next. Jobs with a syntax error, an unknown
+keyword or an unreadable input image are reported and skipped.
+*/
+static void	batchit(char **argkey, char **argval, int narg)
+
+  {
+   prefstruct	prefs0;
+   FILE		*infile;
+   char		line[MAXCHARL], str[MAXCHARL], name[MAXCHAR],
+		**jobkey, **jobval, **tok, *pstr, *pstr2;
+   int		i, n, nim, ntok, njob, badflag;
+
+  if (!strcmp(prefs.batch_name, "-"))
+    infile = stdin;
+  else if (!(infile = fopen(prefs.batch_name, "r")))
+    error(EXIT_FAILURE, "*Error*: cannot open job list ", prefs.batch_name);
+
+  QMALLOC(tok, char *, MAXCHARL/2);
+  QMALLOC(jobkey, char *, narg + MAXCHARL/2);
+  QMALLOC(jobval, char *, narg + MAXCHARL/2);
+  for (i=0; i<narg; i++)
+    {
+    jobkey[i] = argkey[i];
+    jobval[i] = argval[i];
+    }
+
+/* Keep a copy of the settings before the configuration file is read */
+  prefs0 = prefs;
+
+  njob = 0;
+  while (fgets(line, MAXCHARL, infile))
+    {
+    ntok = 0;
+    for (pstr=strtok(line, " \t\r\n"); pstr && *pstr!='#';
+		pstr=strtok(NULL, " \t\r\n"))
+      tok[ntok++] = pstr;
+    if (!ntok)
+      continue;
+    njob++;
+    prefs = prefs0;
+    n = narg;
+    nim = 0;
+    badflag = 0;
+    for (i=0; i<ntok && !badflag; i++)
+      if (*tok[i] == '-' && tok[i][1])
+        {
+        if (i == ntok-1)
+          badflag = batchskip(njob, "missing value for ", tok[i]);
+        else if (findprefkey(tok[i]+1) != RETURN_OK)
+          badflag = batchskip(njob, "unknown keyword ", tok[i]);
+        else
+          {
+          jobkey[n] = tok[i]+1;
+          jobval[n++] = tok[++i];
+          }
+        }
+      else
+        {
+        strncpy(str, tok[i], MAXCHARL-1);
+        for (pstr=NULL; !badflag && (pstr=strtok(pstr?NULL:str, notokstr));
+		nim++)
+          if (nim>=MAXIMAGE)
+            badflag = batchskip(njob, "too many input images: ", pstr);
+          else
+            {
+            strncpy(prefs.image_name[nim], pstr, MAXCHAR-1);
+/*---------- Ignore the extension number, if any */
+            strncpy(name, pstr, MAXCHAR-1);
+            if ((pstr2=strchr(name, '[')))
+              *pstr2 = '\0';
+            if (strcmp(name, "-") && access(name, R_OK))
+              badflag = batchskip(njob, "cannot read ", name);
+            }
+        }
+    if (badflag)
+      continue;
+    if (!nim)
+      {
+      batchskip(njob, "no input image", "");
+      continue;
+      }
+    prefs.nimage_name = nim;
+    readprefs(prefs.prefs_name, jobkey, jobval, n);
+    preprefs();
+    makeit();
+    endprefs();
+    printdone();
+    }
+
+  makeit_end();
+
+  if (infile != stdin)
+    fclose(infile);
+  free(tok);
+  free(jobkey);
+  free(jobval);
+
+  return;
+  }
+
+
+/********************************* batchskip ********************************/
+/*
+Report a job from the job list that cannot be processed, and return 1.
+*/
+static int	batchskip(int njob, char *msg1, char *msg2)
+
+  {
+   char	str[MAXCHAR];
+
+  snprintf(str, MAXCHAR, "skipping job #%d in %s: %s", njob, prefs.batch_name,
+	msg1);
+  warning(str, msg2);
+
+  return 1;
+  }
+
+
+/********************************* printdone ********************************/
+/*
+Print processing statistics.
+*/
+static void	printdone(void)
+
+  {
+   double	tdiff, lines, dets;
 
-  endprefs();
   NFPRINTF(OUTPUT, "");
   tdiff = prefs.time_diff>0.0? prefs.time_diff : 0.001;
   lines = (double)thefield1.height/tdiff;
@@ -158,6 +314,6 @@ setlinebuf(stdout);
 	"> All done (in %.1f s: %.1f line%s/s , %.1f detection%s/s)\n",
 	prefs.time_diff, lines, lines>1.0? "s":"", dets, dets>1.0? "s":"");
 
-  return EXIT_SUCCESS;
+  return;
   }
 
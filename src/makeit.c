@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		07/03/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -49,6 +49,7 @@
 #include	"field.h"
 #include	"filter.h"
 #include	"growth.h"
+#include	"image.h"
 #include	"interpolate.h"
 #include	"pattern.h"
 #include	"psf.h"
@@ -58,6 +59,12 @@
 #include	"xml.h"
 
 static int		selectext(char *filename);
+static psfstruct	*makeit_loadpsf(psfstruct *psf, int i, char *filename,
+				int ext);
+#ifdef USE_MODEL
+static void		makeit_endprofit(void),
+			makeit_initprofit(unsigned int modeltype);
+#endif
 
 time_t			thetimet, thetimet2;
 #ifdef USE_MODEL
@@ -72,6 +79,16 @@ sexcatstruct		thecat;
 picstruct		thefield1,thefield2, thewfield1,thewfield2;
 char			gstr[MAXCHAR];
 
+/* Names of the resources kept in memory from one batch job to the next */
+static char		loaded_filter[MAXCHAR], loaded_nnw[MAXCHAR],
+			loaded_som[MAXCHAR], loaded_psf[2][MAXCHAR];
+static psfstruct	*loaded_profpsf[2];
+static int		loaded_psfext[2];
+#ifdef USE_MODEL
+static unsigned int	loaded_modeltype;
+static int		loaded_fft;
+#endif
+
 
 /******************************** makeit *************************************/
 /*
@@ -82,7 +99,7 @@ void	makeit()
   {
    checkstruct		*check;
    picstruct		*dfield, *field,*pffield[MAXFLAG], *wfield,*dwfield,
-			*dgeofield;
+			*dgeofield, *bfield[MAXFLAG+5];
    catstruct		*imacat;
    tabstruct		*imatab;
    patternstruct	*pattern;
@@ -93,7 +110,7 @@ void	makeit()
    int			nflag[MAXFLAG], nparam2[2],
 			i, nok, ntab, next, ntabmax, forcextflag,
 			nima0,nima1, nweight0,nweight1, npsf0,npsf1, npat,npat0,
-			ndgeo;
+			ndgeo, nfield, objsize;
 
 /* Install error logging */
   error_installfunc(write_error);
@@ -120,8 +137,12 @@ void	makeit()
   initglob();
 
   NFPRINTF(OUTPUT, "Setting catalog parameters");
+  if (prefs.batch_flag)
+    resetcatparams();
   readcatparams(prefs.param_name);
   useprefs();			/* update things accor. to prefs parameters */
+  init_presel();			/* parse pre-measurement selection cuts */
+  init_interpkernel();		/* tabulate the resampling kernel */
 
 /* Check if a specific extension should be loaded */
   if ((nima0=selectext(prefs.image_name[0])) != RETURN_ERROR)
@@ -153,11 +174,14 @@ void	makeit()
     NFPRINTF(OUTPUT, "Reading PSF information");
     if (prefs.dpsf_flag)
       {
-      thedpsf = psf_load(prefs.psf_name[0],nima0<0? 1 :(npsf0<0? 1:npsf0)); 
-      thepsf = psf_load(prefs.psf_name[1], nima1<0? 1 :(npsf1<0? 1:npsf1));
+      thedpsf = makeit_loadpsf(thedpsf, 1, prefs.psf_name[0],
+		nima0<0? 1 :(npsf0<0? 1:npsf0));
+      thepsf = makeit_loadpsf(thepsf, 0, prefs.psf_name[1],
+		nima1<0? 1 :(npsf1<0? 1:npsf1));
       }
     else
-      thepsf = psf_load(prefs.psf_name[0], nima0<0? 1 :(npsf0<0? 1:npsf0)); 
+      thepsf = makeit_loadpsf(thepsf, 0, prefs.psf_name[0],
+		nima0<0? 1 :(npsf0<0? 1:npsf0));
  /*-- Need to check things up because of PSF context parameters */
     updateparamflags();
     useprefs();
@@ -166,7 +190,11 @@ void	makeit()
   if (prefs.prof_flag)
     {
 #ifdef USE_MODEL
-    fft_init(prefs.nthreads);
+    if (!loaded_fft)
+      {
+      fft_init(prefs.nthreads);
+      loaded_fft = 1;
+      }
 /* Create profiles at full resolution */
     NFPRINTF(OUTPUT, "Preparing profile models");
     modeltype = (FLAG(obj2.prof_offset_flux)? MODEL_BACK : MODEL_NONE)
@@ -177,13 +205,11 @@ void	makeit()
 	|(FLAG(obj2.prof_disk_flux)? MODEL_EXPONENTIAL : MODEL_NONE)
 	|(FLAG(obj2.prof_bar_flux)? MODEL_BAR : MODEL_NONE)
 	|(FLAG(obj2.prof_arms_flux)? MODEL_ARMS : MODEL_NONE);
-    theprofit = profit_init(thepsf, modeltype);
+    makeit_initprofit(modeltype);
     changecatparamarrays("VECTOR_MODEL", &theprofit->nparam, 1);
     changecatparamarrays("VECTOR_MODELERR", &theprofit->nparam, 1);
     nparam2[0] = nparam2[1] = theprofit->nparam;
     changecatparamarrays("MATRIX_MODELERR", nparam2, 2);
-    if (prefs.dprof_flag)
-      thedprofit = profit_init(thedpsf, modeltype);
     if (prefs.pattern_flag)
       {
       npat0 = prefs.prof_disk_patternvectorsize;
@@ -219,11 +245,6 @@ void	makeit()
       QPRINTF(OUTPUT, "%s", theprofit->prof[i]->name);
       }
     QPRINTF(OUTPUT, "\n");
-    if (FLAG(obj2.prof_concentration)|FLAG(obj2.prof_concentration))
-      {
-      thepprofit = profit_init(thepsf, MODEL_DIRAC);
-      theqprofit = profit_init(thepsf, MODEL_EXPONENTIAL);
-      }
 #else
     error(EXIT_FAILURE,
 		"*Error*: model-fitting is not supported in this build.\n",
@@ -231,25 +252,37 @@ void	makeit()
 #endif
     }
 
-  if (prefs.filter_flag)
+  if (prefs.filter_flag && strcmp(prefs.filter_name, loaded_filter))
     {
+    if (*loaded_filter)
+      endfilter();
     NFPRINTF(OUTPUT, "Reading detection filter");
     getfilter(prefs.filter_name);	/* get the detection filter */
+    strcpy(loaded_filter, prefs.filter_name);
     }
 
-  if (FLAG(obj2.sprob))
+  if (FLAG(obj2.sprob) && strcmp(prefs.nnw_name, loaded_nnw))
     {
+    if (*loaded_nnw)
+      neurclose();
     NFPRINTF(OUTPUT, "Initializing Neural Network");
     neurinit();
     NFPRINTF(OUTPUT, "Reading Neural Network Weights");
     getnnw(); 
+    strcpy(loaded_nnw, prefs.nnw_name);
     }
 
   if (prefs.somfit_flag)
     {
      int	margin;
 
-    thesom = som_load(prefs.som_name);
+    if (strcmp(prefs.som_name, loaded_som))
+      {
+      if (*loaded_som)
+        som_end(thesom);
+      thesom = som_load(prefs.som_name);
+      strcpy(loaded_som, prefs.som_name);
+      }
     if ((margin=(thesom->inputsize[1]+1)/2) > prefs.cleanmargin)
       prefs.cleanmargin = margin;
     if (prefs.somfit_vectorsize>thesom->neurdim)
@@ -268,7 +301,7 @@ void	makeit()
   alloccatparams();
   useprefs();
 
-  if (!(imacat = read_cat(prefs.image_name[0])))
+  if (!(imacat = read_imacat(prefs.image_name[0])))
     error(EXIT_FAILURE, "*Error*: cannot open ", prefs.image_name[0]);
   close_cat(imacat);
   imatab = imacat->tab;
@@ -480,6 +513,8 @@ void	makeit()
 /*-- Prepare learn and/or associations */
     if (prefs.assoc_flag)
       init_assoc(field);                  /* initialize assoc tasks */
+    if (prefs.prof_flag && prefs.modelinit_flag)
+      init_modelassoc(field);             /* initialize model warm-start */
 
 /*-- Update the CHECK-images */
     if (prefs.check_flag)
@@ -493,40 +528,27 @@ void	makeit()
         {
 /*------ Read other PSF extensions */
         NFPRINTF(OUTPUT, "Reading PSF information");
-        psf_end(thepsf, thepsfit);
+        psf_end(NULL, thepsfit);
         if (prefs.dpsf_flag)
           {
-          psf_end(thedpsf, thedpsfit);
-          thedpsf = psf_load(prefs.psf_name[0], nok);
-          thepsf = psf_load(prefs.psf_name[1], nok);
+          psf_end(NULL, thedpsfit);
+          thedpsf = makeit_loadpsf(thedpsf, 1, prefs.psf_name[0], nok);
+          thepsf = makeit_loadpsf(thepsf, 0, prefs.psf_name[1], nok);
           }
         else
-          thepsf = psf_load(prefs.psf_name[0], nok); 
+          thepsf = makeit_loadpsf(thepsf, 0, prefs.psf_name[0], nok);
         }
 
 #ifdef USE_MODEL
       if (prefs.prof_flag)
         {
 /*------ Create profiles at full resolution */
-        profit_end(theprofit);
-        theprofit = profit_init(thepsf, modeltype);
-        if (prefs.dprof_flag)
-          {
-          profit_end(thedprofit);
-          thedprofit = profit_init(thedpsf, modeltype);
-          }
+        makeit_initprofit(modeltype);
         if (prefs.pattern_flag)
           {
           pattern = pattern_init(theprofit, prefs.pattern_type, npat0);
           pattern_end(pattern);
           }
-        if (FLAG(obj2.prof_concentration)|FLAG(obj2.prof_concentration))
-          {
-          profit_end(thepprofit);
-          profit_end(theqprofit);
-          thepprofit = profit_init(thepsf, MODEL_DIRAC);
-          theqprofit = profit_init(thepsf, MODEL_EXPONENTIAL);
-          }
         }
 #endif
       }
@@ -543,6 +565,28 @@ void	makeit()
         }
       }
 
+/*-- Size image buffers and stacks within the memory budget */
+    nfield = 0;
+    bfield[nfield++] = field;
+    if (dfield)
+      bfield[nfield++] = dfield;
+    if (wfield)
+      bfield[nfield++] = wfield;
+    if (dwfield)
+      bfield[nfield++] = dwfield;
+    for (i=0; i<prefs.nimaflag; i++)
+      bfield[nfield++] = pffield[i];
+    if (dgeofield)
+      bfield[nfield++] = dgeofield;
+    objsize = prefs.backsize[1];
+    if (objsize < prefs.vignetsize[1])
+      objsize = prefs.vignetsize[1];
+/*-- PSF models are sampled with their own pixel step */
+    if (prefs.psf_flag
+	&& objsize < (int)(thepsf->masksize[1]*thepsf->pixstep + 0.999))
+      objsize = (int)(thepsf->masksize[1]*thepsf->pixstep + 0.999);
+    budgetfields(bfield, nfield, objsize);
+
 /*-- Copy field structures to static ones (for catalog info) */
     if (dfield)
       {
@@ -626,38 +670,22 @@ void	makeit()
       prefs.check[i] = NULL;
       }
 
-  if (prefs.filter_flag)
-    endfilter();
-
-  if (prefs.somfit_flag)
-    som_end(thesom);
-
   if (prefs.growth_flag)
     endgrowth();
 
-#ifdef USE_MODEL
-  if (prefs.prof_flag)
-    {
-    profit_end(theprofit);
-    if (prefs.dprof_flag)
-      profit_end(thedprofit);
-    if (FLAG(obj2.prof_concentration)|FLAG(obj2.prof_concentration))
-      {
-      profit_end(thepprofit);
-      profit_end(theqprofit);
-      }
-    fft_end();
-    }
-#endif
+  measvig_end();
+
+  free_memimages();
 
   if (prefs.psf_flag)
-    psf_end(thepsf, thepsfit);
+    psf_end(NULL, thepsfit);
 
   if (prefs.dpsf_flag)
-    psf_end(thedpsf, thedpsfit);
+    psf_end(NULL, thedpsfit);
 
-  if (FLAG(obj2.sprob))
-    neurclose();
+/* Filter, NNW, SOM, PSFs and models are kept in memory for the next job */
+  if (!prefs.batch_flag)
+    makeit_end();
 
 /* Processing end date and time */
   thetimet2 = time(NULL);
@@ -681,6 +709,127 @@ void	makeit()
   }
 
 
+/******************************** makeit_end *********************************/
+/*
+Free the filter, neural network, SOM, PSF and model-fitting data left in
+memory by makeit().
+*/
+void	makeit_end(void)
+  {
+   int	i;
+
+  if (*loaded_filter)
+    endfilter();
+  if (*loaded_nnw)
+    neurclose();
+  if (*loaded_som)
+    {
+    som_end(thesom);
+    thesom = NULL;
+    }
+  *loaded_filter = *loaded_nnw = *loaded_som = '\0';
+
+#ifdef USE_MODEL
+  makeit_endprofit();
+  if (loaded_fft)
+    {
+    fft_end();
+    loaded_fft = 0;
+    }
+#endif
+
+  psf_end(thepsf, NULL);
+  psf_end(thedpsf, NULL);
+  thepsf = thedpsf = NULL;
+  for (i=0; i<2; i++)
+    *loaded_psf[i] = '\0';
+
+  return;
+  }
+
+
+/******************************** makeit_loadpsf *****************************/
+/*
+Load extension ext of a PSF model file, unless it is already in memory
+(batch mode only). i is the PSF slot (0: measurement, 1: detection image).
+*/
+static psfstruct	*makeit_loadpsf(psfstruct *psf, int i, char *filename,
+				int ext)
+  {
+  if (prefs.batch_flag && psf && ext==loaded_psfext[i]
+	&& !strcmp(filename, loaded_psf[i]))
+    {
+/*-- Context parameters must be registered again in the new catalog */
+    psf_initcontext(psf);
+    return psf;
+    }
+
+  psf_end(psf, NULL);
+  psf = psf_load(filename, ext);
+  strcpy(loaded_psf[i], filename);
+  loaded_psfext[i] = ext;
+/* Models computed with the previous PSF cannot be reused */
+  loaded_profpsf[i] = NULL;
+
+  return psf;
+  }
+
+
+#ifdef USE_MODEL
+/******************************** makeit_initprofit **************************/
+/*
+Set up the model-fitting structures, unless those in memory were built from
+the same PSFs and model components (batch mode only).
+*/
+static void	makeit_initprofit(unsigned int modeltype)
+  {
+   int	concflag;
+
+  concflag = FLAG(obj2.prof_concentration);
+  if (prefs.batch_flag && theprofit && modeltype==loaded_modeltype
+	&& loaded_profpsf[0]==thepsf
+	&& (!prefs.dprof_flag || (thedprofit && loaded_profpsf[1]==thedpsf))
+	&& (!concflag || thepprofit))
+    return;
+
+  makeit_endprofit();
+  theprofit = profit_init(thepsf, modeltype);
+  if (prefs.dprof_flag)
+    thedprofit = profit_init(thedpsf, modeltype);
+  if (concflag)
+    {
+    thepprofit = profit_init(thepsf, MODEL_DIRAC);
+    theqprofit = profit_init(thepsf, MODEL_EXPONENTIAL);
+    }
+  loaded_modeltype = modeltype;
+  loaded_profpsf[0] = thepsf;
+  loaded_profpsf[1] = thedpsf;
+
+  return;
+  }
+
+
+/******************************** makeit_endprofit ***************************/
+/*
+Free the model-fitting structures.
+*/
+static void	makeit_endprofit(void)
+  {
+  if (theprofit)
+    profit_end(theprofit);
+  if (thedprofit)
+    profit_end(thedprofit);
+  if (thepprofit)
+    profit_end(thepprofit);
+  if (theqprofit)
+    profit_end(theqprofit);
+  theprofit = thedprofit = thepprofit = theqprofit = NULL;
+
+  return;
+  }
+#endif
+
+
 /******************************** initglob ***********************************/
 /*
 Initialize a few global variables
@@ -695,6 +844,8 @@ void	initglob()
     stg[i] = sin(i*PI/18);
     }
 
+/* Restart the random sequence used for deblending (for batch jobs) */
+  srand(1);
 
   return;
   }
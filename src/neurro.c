@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -71,22 +71,57 @@ Neural network response to an input vector.
 void	neurresp(double *input, double *output)
 
   {
-   int	i, j, l, lastlay = brain->layersnb-1;
-   double	neursum;
+  neurrespbatch(input, 1, output);
 
-  for (i=0; i<brain->nn[0]; i++)
-    brain->n[0][i] = input[i]*brain->inscale[i] + brain->inbias[i];
-  for (l=0; l<lastlay; l++)
-    for (j=0; j<brain->nn[l+1]; j++)
-      {
-      neursum = brain->b[l][j];
-      for (i=0; i<brain->nn[l]; i++)
-        neursum += brain->w[l][i][j] * brain->n[l][i];
-      brain->n[l+1][j] = f(neursum);
-      }
-  for (i=0; i<brain->nn[lastlay]; i++)
-    output[i] = (brain->n[lastlay][i]-brain->outbias[i])
-	/ brain->outscale[i];
+  return;
+  }
+
+
+/****************************** neurrespbatch *******************************/
+/*
+Neural network response to ninput input vectors, stored one after the other
+(same for the outputs). Vectors are processed in batches of up to NEURBATCH,
+with the batch index varying fastest in neuron arrays, and transposed weights:
+all inner loops have unit stride. The summation order is the same as for a
+single vector.
+*/
+void	neurrespbatch(double *input, int ninput, double *output)
+
+  {
+   double	*neursum, *neuron, *wt, w;
+   int		i, j, l, v, nv, nin, nout, lastlay = brain->layersnb-1;
+
+  nin = brain->nn[0];
+  nout = brain->nn[lastlay];
+  for (; ninput>0; ninput-=nv, input+=nv*nin, output+=nv*nout)
+    {
+    nv = ninput<NEURBATCH? ninput : NEURBATCH;
+    for (i=0; i<nin; i++)
+      for (v=0; v<nv; v++)
+        brain->nb[0][i][v] = input[v*nin+i]*brain->inscale[i]
+				+ brain->inbias[i];
+    for (l=0; l<lastlay; l++)
+      for (j=0; j<brain->nn[l+1]; j++)
+        {
+        neursum = brain->nb[l+1][j];
+        for (v=0; v<nv; v++)
+          neursum[v] = brain->b[l][j];
+        wt = brain->wt[l][j];
+        for (i=0; i<brain->nn[l]; i++)
+          {
+          w = wt[i];
+          neuron = brain->nb[l][i];
+          for (v=0; v<nv; v++)
+            neursum[v] += w*neuron[v];
+          }
+        for (v=0; v<nv; v++)
+          neursum[v] = f(neursum[v]);
+        }
+    for (i=0; i<nout; i++)
+      for (v=0; v<nv; v++)
+        output[v*nout+i] = (brain->nb[lastlay][i][v]-brain->outbias[i])
+		/ brain->outscale[i];
+    }
 
   return;
   }
@@ -111,7 +146,7 @@ void    getnnw()
 
   {
    FILE	*infile;
-   int	i, j, k, step;
+   int	i, j, k, l, step;
    char	str[MAXCHAR], *sstr, *null;
 
   if ((infile = fopen(prefs.nnw_name,"r")) == NULL)
@@ -195,6 +230,12 @@ void    getnnw()
 
   fclose(infile);
 
+/* Transpose weights for unit-stride access */
+  for (l=0; l<brain->layersnb-1; l++)
+    for (i=0; i<brain->nn[l]; i++)
+      for (j=0; j<brain->nn[l+1]; j++)
+        brain->wt[l][j][i] = brain->w[l][i][j];
+
   return;
   }
 
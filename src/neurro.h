@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		11/10/2010
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -31,6 +31,7 @@
 #define		LAYERS		3	/* max. number of hidden+i/o layers */
 #define		CONNEX		LAYERS-1
 #define		NEURONS		10	/* maximum number of neurons/layer */
+#define		NEURBATCH	16	/* max. number of inputs per batch */
 
 /*------------------------------- structures --------------------------------*/
 typedef	struct
@@ -45,9 +46,13 @@ typedef	struct
 	double	no[NEURONS];
 	double	n[LAYERS][NEURONS];
 	double	w[CONNEX][NEURONS][NEURONS];
+	double	wt[CONNEX][NEURONS][NEURONS];	/* transposed weights */
 	double	b[CONNEX][NEURONS];
+	double	nb[LAYERS][NEURONS][NEURBATCH];	/* neurons of a batch */
 	}	brainstruct;
 
 /*------------------------------- globals ----------------------------------*/
 
 extern double	f(double);
+
+extern void	neurrespbatch(double *input, int ninput, double *output);
@@ -0,0 +1,491 @@
+#pragma once
+/*
+*				paramdep.h
+*
+* Dependencies between measurement parameters.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 1993-2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/* Each entry is a node of the measurement dependency graph: the measurement
+flag is set if any of the flags of the measurements that depend on it is
+set. Entries may be listed in any order: see resolveparamdeps() */
+
+#define	PARAMDEP_NMAX	24	/* max. nb of dependent measurements per node */
+
+#define	DEP(x)		((char *)&flag##x)
+#define	VECDEP(x)	((char *)flag##x)
+
+/*--------------------------------- typedefs --------------------------------*/
+typedef struct
+  {
+  char		*flag;				/* measurement flag */
+  char		*by[PARAMDEP_NMAX];		/* flags that require it */
+  }	paramdepstruct;
+
+/*--------------------------------- initialization --------------------------*/
+paramdepstruct	paramdep[] = {
+/*----------------------------- Model-fitting -----------------------------*/
+  {DEP(obj2.prof_disk_scale),
+	{DEP(obj2.prof_disk_patternvector),
+	DEP(obj2.prof_disk_patternmodvector),
+	DEP(obj2.prof_disk_patternargvector),
+	DEP(obj2.prof_disk_patternspiral)}},
+  {DEP(obj2.prof_concentration),
+	{DEP(obj2.prof_concentrationerr)}},
+  {DEP(obj2.fluxcorerr_prof),
+	{DEP(obj2.magcorerr_prof)}},
+  {DEP(obj2.fluxcor_prof),
+	{DEP(obj2.magcor_prof), DEP(obj2.fluxcorerr_prof)}},
+  {DEP(obj2.poserraw_prof),
+	{DEP(obj2.poserrbw_prof)}},
+  {DEP(obj2.poserrcxxw_prof),
+	{DEP(obj2.poserrcyyw_prof), DEP(obj2.poserrcxyw_prof)}},
+  {DEP(obj2.poserrthetas_prof),
+	{DEP(obj2.poserrtheta1950_prof), DEP(obj2.poserrtheta2000_prof)}},
+  {DEP(obj2.poserrthetaw_prof),
+	{DEP(obj2.poserrthetas_prof)}},
+  {DEP(obj2.poserrmx2w_prof),
+	{DEP(obj2.poserrmy2w_prof), DEP(obj2.poserrmxyw_prof),
+	DEP(obj2.poserrthetaw_prof), DEP(obj2.poserraw_prof),
+	DEP(obj2.poserrcxxw_prof)}},
+  {DEP(obj2.poserra_prof),
+	{DEP(obj2.poserrb_prof), DEP(obj2.poserrtheta_prof),
+	DEP(obj2.poserraw_prof)}},
+  {DEP(obj2.poserrcxx_prof),
+	{DEP(obj2.poserrcyy_prof), DEP(obj2.poserrcxy_prof)}},
+  {DEP(obj2.poserrmx2_prof),
+	{DEP(obj2.poserrmy2_prof), DEP(obj2.poserrmxy_prof),
+	DEP(obj2.poserrmx2w_prof)}},
+  {DEP(obj2.alpha1950_prof),
+	{DEP(obj2.delta1950_prof), DEP(obj2.poserrtheta1950_prof)}},
+  {DEP(obj2.alpha2000_prof),
+	{DEP(obj2.delta2000_prof), DEP(obj2.alpha1950_prof),
+	DEP(obj2.poserrtheta2000_prof)}},
+  {DEP(obj2.alphas_prof),
+	{DEP(obj2.deltas_prof), DEP(obj2.alpha2000_prof)}},
+  {DEP(obj2.xw_prof),
+	{DEP(obj2.yw_prof), DEP(obj2.alphas_prof)}},
+  {DEP(obj2.xf_prof),
+	{DEP(obj2.yf_prof)}},
+  {DEP(obj2.x_prof),
+	{DEP(obj2.y_prof), DEP(obj2.xw_prof), DEP(obj2.xf_prof),
+	DEP(obj2.poserra_prof), DEP(obj2.poserrcxx_prof),
+	DEP(obj2.poserrmx2_prof), DEP(obj2.prof_concentration),
+	DEP(obj2.prof_class_star), DEP(obj2.fluxcor_prof)}},
+  {DEP(obj2.prof_dirac_fluxratio),
+	{DEP(obj2.prof_dirac_fluxratioerr)}},
+  {DEP(obj2.prof_dirac_mag),
+	{DEP(obj2.prof_dirac_magerr)}},
+  {DEP(obj2.prof_spheroid_fluxratio),
+	{DEP(obj2.prof_spheroid_fluxratioerr)}},
+  {DEP(obj2.prof_spheroid_mag),
+	{DEP(obj2.prof_spheroid_magerr)}},
+  {DEP(obj2.prof_spheroid_reff),
+	{DEP(obj2.prof_spheroid_refferr)}},
+  {DEP(obj2.prof_spheroid_aspect),
+	{DEP(obj2.prof_spheroid_aspecterr)}},
+  {DEP(obj2.prof_spheroid_theta),
+	{DEP(obj2.prof_spheroid_thetaerr)}},
+  {DEP(obj2.prof_spheroid_sersicn),
+	{DEP(obj2.prof_spheroid_sersicnerr)}},
+  {DEP(obj2.prof_disk_fluxratio),
+	{DEP(obj2.prof_disk_fluxratioerr)}},
+  {DEP(obj2.prof_disk_mag),
+	{DEP(obj2.prof_disk_magerr)}},
+  {DEP(obj2.prof_disk_scale),
+	{DEP(obj2.prof_disk_scaleerr)}},
+  {DEP(obj2.prof_disk_aspect),
+	{DEP(obj2.prof_disk_aspecterr)}},
+  {DEP(obj2.prof_disk_inclination),
+	{DEP(obj2.prof_disk_inclinationerr)}},
+  {DEP(obj2.prof_disk_theta),
+	{DEP(obj2.prof_disk_thetaerr)}},
+  {DEP(obj2.prof_bar_fluxratio),
+	{DEP(obj2.prof_bar_fluxratioerr)}},
+  {DEP(obj2.prof_bar_mag),
+	{DEP(obj2.prof_bar_magerr)}},
+  {DEP(obj2.prof_bar_length),
+	{DEP(obj2.prof_bar_lengtherr)}},
+  {DEP(obj2.prof_bar_aspect),
+	{DEP(obj2.prof_bar_aspecterr)}},
+  {DEP(obj2.prof_bar_theta),
+	{DEP(obj2.prof_bar_thetaerr)}},
+  {DEP(obj2.prof_arms_fluxratio),
+	{DEP(obj2.prof_arms_fluxratioerr)}},
+  {DEP(obj2.prof_arms_mag),
+	{DEP(obj2.prof_arms_magerr)}},
+  {DEP(obj2.prof_e1errw),
+	{DEP(obj2.prof_e2errw), DEP(obj2.prof_e12corrw)}},
+  {DEP(obj2.prof_e1w),
+	{DEP(obj2.prof_e2w), DEP(obj2.prof_e1errw)}},
+  {DEP(obj2.prof_pol1errw),
+	{DEP(obj2.prof_pol2errw), DEP(obj2.prof_pol12corrw)}},
+  {DEP(obj2.prof_pol1w),
+	{DEP(obj2.prof_pol2w), DEP(obj2.prof_pol1errw)}},
+  {DEP(obj2.prof_aw),
+	{DEP(obj2.prof_bw)}},
+  {DEP(obj2.prof_cxxw),
+	{DEP(obj2.prof_cyyw), DEP(obj2.prof_cxyw)}},
+  {DEP(obj2.prof_thetas),
+	{DEP(obj2.prof_theta1950), DEP(obj2.prof_theta2000)}},
+  {DEP(obj2.prof_thetaw),
+	{DEP(obj2.prof_thetas)}},
+  {DEP(obj2.prof_mx2w),
+	{DEP(obj2.prof_my2w), DEP(obj2.prof_mxyw), DEP(obj2.prof_thetaw),
+	DEP(obj2.prof_aw), DEP(obj2.prof_cxxw), DEP(obj2.prof_e1w),
+	DEP(obj2.prof_pol1w)}},
+  {DEP(obj2.dtheta1950),
+	{DEP(obj2.prof_theta1950), DEP(obj2.prof_spheroid_theta1950),
+	DEP(obj2.prof_disk_theta1950), DEP(obj2.prof_bar_theta1950),
+	DEP(obj2.poserrtheta1950_psf), DEP(obj2.win_theta1950),
+	DEP(obj2.winposerr_theta1950), DEP(obj2.poserr_theta1950),
+	DEP(obj2.theta1950), DEP(obj2.poserrtheta1950_prof)}},
+  {DEP(obj2.dtheta2000),
+	{DEP(obj2.prof_theta2000), DEP(obj2.prof_spheroid_theta2000),
+	DEP(obj2.prof_disk_theta2000), DEP(obj2.prof_bar_theta2000),
+	DEP(obj2.poserrtheta2000_psf), DEP(obj2.win_theta2000),
+	DEP(obj2.winposerr_theta2000), DEP(obj2.poserr_theta2000),
+	DEP(obj2.theta2000), DEP(obj2.poserrtheta2000_prof)}},
+  {DEP(obj2.prof_spheroid_thetas),
+	{DEP(obj2.prof_spheroid_theta2000), DEP(obj2.prof_spheroid_theta1950)}},
+  {DEP(obj2.prof_spheroid_thetaw),
+	{DEP(obj2.prof_spheroid_thetas)}},
+  {DEP(obj2.prof_disk_thetas),
+	{DEP(obj2.prof_disk_theta2000), DEP(obj2.prof_disk_theta1950)}},
+  {DEP(obj2.prof_disk_thetaw),
+	{DEP(obj2.prof_disk_thetas)}},
+  {DEP(obj2.prof_bar_thetas),
+	{DEP(obj2.prof_bar_theta2000), DEP(obj2.prof_bar_theta1950)}},
+  {DEP(obj2.prof_bar_thetaw),
+	{DEP(obj2.prof_bar_thetas)}},
+  {DEP(obj2.prof_arms_scalew),
+	{DEP(obj2.prof_arms_startw), DEP(obj2.prof_arms_scaleerrw),
+	DEP(obj2.prof_arms_starterrw)}},
+  {DEP(obj2.prof_bar_lengthw),
+	{DEP(obj2.prof_bar_aspectw), DEP(obj2.prof_bar_thetaw),
+	DEP(obj2.prof_bar_lengtherrw), DEP(obj2.prof_bar_aspecterrw),
+	DEP(obj2.prof_bar_thetaerrw)}},
+  {DEP(obj2.prof_disk_scalew),
+	{DEP(obj2.prof_disk_aspectw), DEP(obj2.prof_disk_thetaw),
+	DEP(obj2.prof_disk_scaleerrw), DEP(obj2.prof_disk_aspecterrw),
+	DEP(obj2.prof_disk_thetaerrw), DEP(obj2.prof_arms_scalew)}},
+  {DEP(obj2.prof_disk_fluxmean),
+	{DEP(obj2.prof_disk_mumean)}},
+  {DEP(obj2.prof_disk_fluxeff),
+	{DEP(obj2.prof_disk_mueff)}},
+  {DEP(obj2.prof_disk_peak),
+	{DEP(obj2.prof_disk_mumax), DEP(obj2.prof_disk_fluxeff),
+	DEP(obj2.prof_disk_fluxmean)}},
+  {DEP(obj2.prof_spheroid_reffw),
+	{DEP(obj2.prof_spheroid_aspectw), DEP(obj2.prof_spheroid_thetaw),
+	DEP(obj2.prof_spheroid_refferrw), DEP(obj2.prof_spheroid_aspecterrw),
+	DEP(obj2.prof_spheroid_thetaerrw)}},
+  {DEP(obj2.prof_spheroid_fluxmean),
+	{DEP(obj2.prof_spheroid_mumean)}},
+  {DEP(obj2.prof_spheroid_fluxeff),
+	{DEP(obj2.prof_spheroid_mueff)}},
+  {DEP(obj2.prof_spheroid_peak),
+	{DEP(obj2.prof_spheroid_mumax), DEP(obj2.prof_spheroid_fluxeff),
+	DEP(obj2.prof_spheroid_fluxmean)}},
+  {DEP(obj2.prof_flagw),
+	{DEP(obj2.prof_spheroid_reffw), DEP(obj2.prof_disk_scalew),
+	DEP(obj2.prof_bar_lengthw), DEP(obj2.prof_arms_scalew),
+	DEP(obj2.prof_mx2w)}},
+  {DEP(obj2.prof_e1err),
+	{DEP(obj2.prof_e2err), DEP(obj2.prof_e12corr), DEP(obj2.prof_e1errw)}},
+  {DEP(obj2.prof_e1),
+	{DEP(obj2.prof_e2), DEP(obj2.prof_e1err), DEP(obj2.prof_e1w)}},
+  {DEP(obj2.prof_pol1err),
+	{DEP(obj2.prof_pol2err), DEP(obj2.prof_pol12corr),
+	DEP(obj2.prof_pol1errw)}},
+  {DEP(obj2.prof_pol1),
+	{DEP(obj2.prof_pol2), DEP(obj2.prof_pol1err), DEP(obj2.prof_pol1w)}},
+  {DEP(obj2.prof_a),
+	{DEP(obj2.prof_b), DEP(obj2.prof_theta), DEP(obj2.prof_aw)}},
+  {DEP(obj2.prof_cxx),
+	{DEP(obj2.prof_cyy), DEP(obj2.prof_cxy), DEP(obj2.prof_cxxw)}},
+  {DEP(obj2.prof_mx2),
+	{DEP(obj2.prof_my2), DEP(obj2.prof_mxy), DEP(obj2.prof_e1),
+	DEP(obj2.prof_pol1), DEP(obj2.prof_a), DEP(obj2.prof_cxx),
+	DEP(obj2.prof_mx2w)}},
+  {DEP(obj2.prof_conva),
+	{DEP(obj2.prof_convb), DEP(obj2.prof_convtheta)}},
+  {DEP(obj2.prof_convcxx),
+	{DEP(obj2.prof_convcyy)}},
+  {DEP(obj2.prof_convmx2),
+	{DEP(obj2.prof_convcxx), DEP(obj2.prof_conva)}},
+  {DEP(obj2.fluxmean_prof),
+	{DEP(obj2.mumean_prof)}},
+  {DEP(obj2.peak_prof),
+	{DEP(obj2.mumax_prof)}},
+  {DEP(obj2.fluxeff_prof),
+	{DEP(obj2.mueff_prof), DEP(obj2.fluxmean_prof), DEP(obj2.peak_prof)}},
+  {DEP(obj2.prof_arms_flux),
+	{DEP(obj2.prof_arms_fluxerr), DEP(obj2.prof_arms_mag),
+	DEP(obj2.prof_arms_fluxratio), DEP(obj2.prof_arms_scalew),
+	DEP(obj2.prof_arms_scale), DEP(obj2.prof_arms_posang),
+	DEP(obj2.prof_arms_pitch), DEP(obj2.prof_arms_start),
+	DEP(obj2.prof_arms_quadfrac)}},
+  {DEP(obj2.prof_bar_theta),
+	{DEP(obj2.prof_bar_lengthw)}},
+  {DEP(obj2.prof_bar_flux),
+	{DEP(obj2.prof_bar_fluxerr), DEP(obj2.prof_bar_mag),
+	DEP(obj2.prof_bar_fluxratio), DEP(obj2.prof_bar_lengthw),
+	DEP(obj2.prof_bar_length), DEP(obj2.prof_bar_aspect),
+	DEP(obj2.prof_bar_posang), DEP(obj2.prof_bar_theta),
+	DEP(obj2.prof_arms_flux)}},
+  {DEP(obj2.prof_disk_flux),
+	{DEP(obj2.prof_disk_fluxerr), DEP(obj2.prof_disk_mag),
+	DEP(obj2.prof_disk_fluxratio), DEP(obj2.prof_disk_scalew),
+	DEP(obj2.prof_disk_scale), DEP(obj2.prof_disk_aspect),
+	DEP(obj2.prof_disk_inclination), DEP(obj2.prof_disk_theta),
+	DEP(obj2.prof_disk_peak), DEP(obj2.prof_bar_flux)}},
+  {DEP(obj2.prof_spheroid_flux),
+	{DEP(obj2.prof_spheroid_fluxerr), DEP(obj2.prof_spheroid_mag),
+	DEP(obj2.prof_spheroid_fluxratio), DEP(obj2.prof_spheroid_reffw),
+	DEP(obj2.prof_spheroid_reff), DEP(obj2.prof_spheroid_aspect),
+	DEP(obj2.prof_spheroid_theta), DEP(obj2.prof_spheroid_sersicn),
+	DEP(obj2.prof_spheroid_peak)}},
+  {DEP(obj2.prof_dirac_flux),
+	{DEP(obj2.prof_dirac_fluxerr), DEP(obj2.prof_dirac_mag),
+	DEP(obj2.prof_dirac_fluxratio)}},
+  {DEP(obj2.prof_offset_flux),
+	{DEP(obj2.prof_offset_fluxerr)}},
+  {DEP(obj2.fluxerr_dprof),
+	{DEP(obj2.magerr_dprof)}},
+  {DEP(obj2.flux_dprof),
+	{DEP(obj2.mag_dprof), DEP(obj2.fluxerr_dprof)}},
+  {DEP(obj2.fluxerr_prof),
+	{DEP(obj2.magerr_prof), DEP(obj2.prof_concentrationerr),
+	DEP(obj2.fluxcorerr_prof), DEP(obj2.prof_arms_fluxratio),
+	DEP(obj2.prof_bar_fluxratio), DEP(obj2.prof_disk_fluxratio),
+	DEP(obj2.prof_spheroid_fluxratio), DEP(obj2.prof_dirac_fluxratio)}},
+  {DEP(obj2.flux_prof),
+	{DEP(obj2.mag_prof), DEP(obj2.fluxerr_prof), DEP(obj2.fluxcor_prof)}},
+
+/*------------------------------ Astrometry ---------------------------------*/
+  {DEP(obj2.win_aw),
+	{DEP(obj2.win_bw), DEP(obj2.win_polarw)}},
+  {DEP(obj2.win_cxxw),
+	{DEP(obj2.win_cyyw), DEP(obj2.win_cxyw)}},
+  {DEP(obj2.win_thetas),
+	{DEP(obj2.win_theta1950), DEP(obj2.win_theta2000)}},
+  {DEP(obj2.win_thetaw),
+	{DEP(obj2.win_thetas)}},
+  {DEP(obj2.win_mx2w),
+	{DEP(obj2.win_my2w), DEP(obj2.win_mxyw), DEP(obj2.win_thetaw),
+	DEP(obj2.win_aw), DEP(obj2.win_cxxw)}},
+  {DEP(obj2.win_a),
+	{DEP(obj2.win_b), DEP(obj2.win_theta), DEP(obj2.win_polar),
+	DEP(obj2.win_aw)}},
+  {DEP(obj2.win_cxx),
+	{DEP(obj2.win_cyy), DEP(obj2.win_cxy), DEP(obj2.win_cxxw)}},
+  {DEP(obj2.win_mx2),
+	{DEP(obj2.win_my2), DEP(obj2.win_mxy), DEP(obj2.win_a),
+	DEP(obj2.win_cxx), DEP(obj2.win_mx2w)}},
+  {DEP(obj2.winposerr_aw),
+	{DEP(obj2.winposerr_bw)}},
+  {DEP(obj2.winposerr_cxxw),
+	{DEP(obj2.winposerr_cyyw), DEP(obj2.winposerr_cxyw)}},
+  {DEP(obj2.winposerr_thetas),
+	{DEP(obj2.winposerr_theta1950), DEP(obj2.winposerr_theta2000)}},
+  {DEP(obj2.winposerr_thetaw),
+	{DEP(obj2.winposerr_thetas)}},
+  {DEP(obj2.winposerr_mx2w),
+	{DEP(obj2.winposerr_my2w), DEP(obj2.winposerr_mxyw),
+	DEP(obj2.winposerr_thetaw), DEP(obj2.winposerr_aw),
+	DEP(obj2.winposerr_cxxw)}},
+  {DEP(obj2.winposerr_a),
+	{DEP(obj2.winposerr_b), DEP(obj2.winposerr_theta)}},
+  {DEP(obj2.winposerr_cxx),
+	{DEP(obj2.winposerr_cyy), DEP(obj2.winposerr_cxy)}},
+  {DEP(obj2.winposerr_mx2),
+	{DEP(obj2.winposerr_my2), DEP(obj2.winposerr_mxy),
+	DEP(obj2.winposerr_a), DEP(obj2.winposerr_cxx),
+	DEP(obj2.winposerr_mx2w)}},
+  {DEP(obj2.winpos_alpha1950),
+	{DEP(obj2.winpos_delta1950), DEP(obj2.win_theta1950),
+	DEP(obj2.winposerr_theta1950)}},
+  {DEP(obj2.winpos_alpha2000),
+	{DEP(obj2.winpos_delta2000), DEP(obj2.winpos_alpha1950),
+	DEP(obj2.win_theta2000), DEP(obj2.winposerr_theta2000)}},
+  {DEP(obj2.winpos_alphas),
+	{DEP(obj2.winpos_deltas), DEP(obj2.winpos_alpha2000)}},
+  {DEP(obj2.winpos_xf),
+	{DEP(obj2.winpos_yf)}},
+  {DEP(obj2.winpos_xw),
+	{DEP(obj2.winpos_yw), DEP(obj2.winpos_alphas)}},
+  {DEP(obj2.poserr_aw),
+	{DEP(obj2.poserr_bw)}},
+  {DEP(obj2.poserr_cxxw),
+	{DEP(obj2.poserr_cyyw), DEP(obj2.poserr_cxyw)}},
+  {DEP(obj2.poserr_thetas),
+	{DEP(obj2.poserr_theta1950), DEP(obj2.poserr_theta2000)}},
+  {DEP(obj2.poserr_thetaw),
+	{DEP(obj2.poserr_thetas)}},
+  {DEP(obj2.poserr_mx2w),
+	{DEP(obj2.poserr_my2w), DEP(obj2.poserr_mxyw),
+	DEP(obj2.poserr_thetaw), DEP(obj2.poserr_aw), DEP(obj2.poserr_cxxw)}},
+  {DEP(obj2.poserr_a),
+	{DEP(obj2.poserr_b), DEP(obj2.poserr_theta), DEP(obj2.winposerr_a)}},
+  {DEP(obj2.poserr_cxx),
+	{DEP(obj2.poserr_cyy), DEP(obj2.poserr_cxy)}},
+  {DEP(obj.poserr_mx2),
+	{DEP(obj.poserr_my2), DEP(obj.poserr_mxy), DEP(obj2.poserr_a),
+	DEP(obj2.poserr_cxx), DEP(obj2.poserr_mx2w), DEP(obj2.winposerr_mx2)}},
+  {DEP(obj2.peakalpha1950),
+	{DEP(obj2.peakdelta1950)}},
+  {DEP(obj2.alpha1950),
+	{DEP(obj2.delta1950), DEP(obj2.theta1950), DEP(obj2.poserr_theta1950),
+	DEP(obj2.dtheta1950)}},
+  {DEP(obj2.peakalpha2000),
+	{DEP(obj2.peakdelta2000), DEP(obj2.peakalpha1950)}},
+  {DEP(obj2.alpha2000),
+	{DEP(obj2.delta2000), DEP(obj2.alpha1950), DEP(obj2.dtheta2000)}},
+  {DEP(obj2.peakalphas),
+	{DEP(obj2.peakdeltas), DEP(obj2.peakalpha2000)}},
+  {DEP(obj2.alphas),
+	{DEP(obj2.deltas), DEP(obj2.alpha2000)}},
+  {DEP(obj2.thetas),
+	{DEP(obj2.theta1950), DEP(obj2.theta2000)}},
+  {DEP(obj2.thetaw),
+	{DEP(obj2.thetas)}},
+  {DEP(obj2.aw),
+	{DEP(obj2.bw), DEP(obj2.polarw)}},
+  {DEP(obj2.cxxw),
+	{DEP(obj2.cyyw), DEP(obj2.cxyw)}},
+  {DEP(obj2.mx2w),
+	{DEP(obj2.my2w), DEP(obj2.mxyw), DEP(obj2.thetaw), DEP(obj2.aw),
+	DEP(obj2.cxxw)}},
+  {DEP(obj2.peakxw),
+	{DEP(obj2.peakyf)}},
+  {DEP(obj2.peakxw),
+	{DEP(obj2.peakyw), DEP(obj2.peakalphas)}},
+  {DEP(obj.peakx),
+	{DEP(obj.peaky), DEP(obj2.peakxw), DEP(obj2.peakxf)}},
+  {DEP(obj2.mxf),
+	{DEP(obj2.myf)}},
+  {DEP(obj2.mxw),
+	{DEP(obj2.myw), DEP(obj2.mx2w), DEP(obj2.alphas),
+	DEP(obj2.poserr_mx2w)}},
+  {DEP(obj2.mamaposx),
+	{DEP(obj2.mamaposy)}},
+  {DEP(obj2.fluxerr_win),
+	{DEP(obj2.snr_win)}},
+  {DEP(obj2.flux_win),
+	{DEP(obj2.mag_win), DEP(obj2.magerr_win), DEP(obj2.fluxerr_win)}},
+  {DEP(obj2.winpos_dgeox),
+	{DEP(obj2.winpos_dgeoy)}},
+  {DEP(obj2.winpos_x),
+	{DEP(obj2.winpos_y), DEP(obj2.winpos_dgeox), DEP(obj2.winposerr_mx2),
+	DEP(obj2.win_mx2), DEP(obj2.winpos_xw), DEP(obj2.winpos_xf),
+	DEP(obj2.win_flag), DEP(obj2.flux_win), DEP(obj2.winpos_niter)}},
+  {DEP(obj2.area_flagw),
+	{DEP(obj2.npixw), DEP(obj2.fdnpixw), DEP(obj2.fwhmw), DEP(obj2.maxmu),
+	DEP(obj2.threshmu), DEP(obj2.prof_spheroid_mumax),
+	DEP(obj2.prof_disk_mumax), DEP(obj2.mumax_prof)}},
+
+/*------------------------------ Photometry ---------------------------------*/
+  {DEP(obj2.fluxerr_best),
+	{DEP(obj2.magerr_best)}},
+  {DEP(obj2.flux_best),
+	{DEP(obj2.mag_best), DEP(obj2.fluxerr_best)}},
+  {DEP(obj2.hl_radius),
+	{DEP(obj2.winpos_x)}},
+  {DEP(obj2.flux_auto),
+	{DEP(obj2.mag_auto), DEP(obj2.magerr_auto), DEP(obj2.fluxerr_auto),
+	DEP(obj2.kronfactor), DEP(obj2.flux_best), DEP(obj2.flux_radius),
+	DEP(obj2.hl_radius), DEP(obj2.fluxcor_prof)}},
+  {DEP(obj2.flux_petro),
+	{DEP(obj2.mag_petro), DEP(obj2.magerr_petro), DEP(obj2.fluxerr_petro),
+	DEP(obj2.petrofactor)}},
+  {DEP(obj2.fluxerr_isocor),
+	{DEP(obj2.magerr_isocor), DEP(obj2.fluxerr_best)}},
+  {DEP(obj2.flux_isocor),
+	{DEP(obj2.mag_isocor), DEP(obj2.fluxerr_isocor), DEP(obj2.flux_best)}},
+  {DEP(obj2.flux_aper),
+	{DEP(obj2.mag_aper), DEP(obj2.magerr_aper), DEP(obj2.fluxerr_aper)}},
+  {DEP(obj2.flux_galfit),
+	{DEP(obj2.mag_galfit), DEP(obj2.magerr_galfit),
+	DEP(obj2.fluxerr_galfit)}},
+
+/*---------------------------- External flags -------------------------------*/
+  {VECDEP(obj.imaflag),
+	{VECDEP(obj.imanflag)}},
+
+/*------------------------------ PSF-fitting --------------------------------*/
+  {DEP(obj2.fwhm_psf),
+	{DEP(obj2.fwhmw_psf)}},
+  {DEP(obj2.poserraw_psf),
+	{DEP(obj2.poserrbw_psf)}},
+  {DEP(obj2.poserrcxxw_psf),
+	{DEP(obj2.poserrcyyw_psf), DEP(obj2.poserrcxyw_psf)}},
+  {DEP(obj2.poserrthetas_psf),
+	{DEP(obj2.poserrtheta1950_psf), DEP(obj2.poserrtheta2000_psf)}},
+  {DEP(obj2.poserrthetaw_psf),
+	{DEP(obj2.poserrthetas_psf)}},
+  {DEP(obj2.poserrmx2w_psf),
+	{DEP(obj2.poserrmy2w_psf), DEP(obj2.poserrmxyw_psf),
+	DEP(obj2.poserrthetaw_psf), DEP(obj2.poserraw_psf),
+	DEP(obj2.poserrcxxw_psf)}},
+  {DEP(obj2.poserra_psf),
+	{DEP(obj2.poserrb_psf), DEP(obj2.poserrtheta_psf)}},
+  {DEP(obj2.poserrcxx_psf),
+	{DEP(obj2.poserrcyy_psf), DEP(obj2.poserrcxy_psf)}},
+  {DEP(obj2.poserrmx2_psf),
+	{DEP(obj2.poserrmy2_psf), DEP(obj2.poserrmxy_psf),
+	DEP(obj2.poserra_psf), DEP(obj2.poserrcxx_psf),
+	DEP(obj2.poserrmx2w_psf)}},
+  {DEP(obj2.alpha1950_psf),
+	{DEP(obj2.delta1950_psf), DEP(obj2.poserrtheta1950_psf)}},
+  {DEP(obj2.alpha2000_psf),
+	{DEP(obj2.delta2000_psf), DEP(obj2.alpha1950_psf),
+	DEP(obj2.poserrtheta2000_psf)}},
+  {DEP(obj2.alphas_psf),
+	{DEP(obj2.deltas_psf), DEP(obj2.alpha2000_psf)}},
+  {DEP(obj2.xw_psf),
+	{DEP(obj2.yw_psf), DEP(obj2.poserrmx2w_psf), DEP(obj2.alphas_psf)}},
+  {DEP(obj2.fluxerr_psf),
+	{DEP(obj2.poserrmx2_psf), DEP(obj2.magerr_psf)}},
+  {DEP(obj2.mx2_pc),
+	{DEP(obj2.my2_pc), DEP(obj2.mxy_pc), DEP(obj2.a_pc), DEP(obj2.b_pc),
+	DEP(obj2.theta_pc), DEP(obj2.vector_pc), DEP(obj2.gdposang),
+	DEP(obj2.gdscale), DEP(obj2.gdaspect), DEP(obj2.flux_galfit),
+	DEP(obj2.gde1), DEP(obj2.gde2), DEP(obj2.gbposang), DEP(obj2.gbscale),
+	DEP(obj2.gbaspect), DEP(obj2.gbratio)}},
+  {DEP(obj2.flux_psf),
+	{DEP(obj2.mag_psf), DEP(obj2.x_psf), DEP(obj2.y_psf),
+	DEP(obj2.xw_psf), DEP(obj2.fluxerr_psf), DEP(obj2.niter_psf),
+	DEP(obj2.chi2_psf), DEP(obj2.mx2_pc)}},
+
+/*-------------------------------- Others -----------------------------------*/
+  {DEP(obj.fwhm),
+	{DEP(obj2.fwhmw)}},
+  {DEP(obj.iso[0]),
+	{DEP(obj2.sprob)}},
+  {DEP(obj.wflag),
+	{DEP(obj.nzwpix), DEP(obj.nzdwpix)}},
+  {NULL}
+  };
+
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		08/11/2011
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -36,6 +36,7 @@
 #include	"define.h"
 #include	"globals.h"
 #include	"prefs.h"
+#include	"image.h"
 #include	"photom.h"
 #include	"plist.h"
 
@@ -58,10 +59,12 @@ void  computeaperflux(picstruct *field, picstruct *wfield,
    long			pos;
    PIXTYPE		*strip,*stript, *wstrip,*wstript,
 			wthresh = 0.0;
+   measvigstruct	*vig, *wvig;
 
   if (wfield)
     wthresh = wfield->weight_thresh;
   wstrip = wstript = NULL;
+  wvig = NULL;
   mx = obj->mx;
   my = obj->my;
   w = field->width;
@@ -117,11 +120,14 @@ void  computeaperflux(picstruct *field, picstruct *wfield,
   strip = field->strip;
   if (wfield)
     wstrip = wfield->strip;
+  vig = measvig_get(field, strip, xmin,xmax, ymin,ymax);
+  if (wfield)
+    wvig = measvig_get(field, wstrip, xmin,xmax, ymin,ymax);
   for (y=ymin; y<ymax; y++)
     {
-    stript = strip + (pos = (y%h)*w + xmin);
+    stript = vig->pix + (y-vig->ymin)*vig->w + xmin-vig->xmin;
     if (wfield)
-      wstript = wstrip + pos;
+      wstript = wvig->pix + (y-wvig->ymin)*wvig->w + xmin-wvig->xmin;
     for (x=xmin; x<xmax; x++, stript++, wstript++)
       {
       dx = x - mx;
@@ -227,6 +233,7 @@ void  computepetroflux(picstruct *field, picstruct *dfield, picstruct *wfield,
    PIXTYPE		*strip,*stript, *dstrip,*dstript, *wstrip,*wstript,
 			*dwstrip,*dwstript,
 			pix, wthresh=0.0, dwthresh=0.0;
+   measvigstruct	*vig, *wvig, *dvig, *dwvig;
 
 
 /* Let's initialize some variables */
@@ -238,6 +245,7 @@ void  computepetroflux(picstruct *field, picstruct *dfield, picstruct *wfield,
   if (wfield)
     wthresh = wfield->weight_thresh;
   wstript = dwstript = NULL;
+  wvig = dwvig = NULL;
   w = field->width;
   h = field->stripheight;
   fymin = field->ymin;
@@ -299,6 +307,9 @@ void  computepetroflux(picstruct *field, picstruct *dfield, picstruct *wfield,
   dstrip = dfield->strip;
   if (dwfield)
     dwstrip = dwfield->strip;
+  dvig = measvig_get(field, dstrip, xmin,xmax, ymin,ymax);
+  if (dwfield)
+    dwvig = measvig_get(field, dwstrip, xmin,xmax, ymin,ymax);
   klim = sqrt(klim2);
   kstep = klim/20.0;
   area = areab = areanum = areaden = 0;
@@ -315,9 +326,10 @@ void  computepetroflux(picstruct *field, picstruct *dfield, picstruct *wfield,
     munum = muden = 0.0;
     for (y=ymin; y<ymax; y++)
       {
-      dstript = dstrip + (pos = xmin + (y%h)*w);
+      dstript = dvig->pix + (y-dvig->ymin)*dvig->w + xmin-dvig->xmin;
       if (dwfield)
-        dwstript = dwstrip + pos;
+        dwstript = dwvig->pix + (y-dwvig->ymin)*dwvig->w
+		+ xmin-dwvig->xmin;
       for (x=xmin; x<xmax; x++, dstript++, dwstript++)
       {
       dx = x - mx;
@@ -419,11 +431,14 @@ void  computepetroflux(picstruct *field, picstruct *dfield, picstruct *wfield,
     strip = field->strip;
     if (wfield)
       wstrip = wfield->strip;
+    vig = measvig_get(field, strip, xmin,xmax, ymin,ymax);
+    if (wfield)
+      wvig = measvig_get(field, wstrip, xmin,xmax, ymin,ymax);
     for (y=ymin; y<ymax; y++)
       {
-      stript = strip + (pos = xmin + (y%h)*w);
+      stript = vig->pix + (y-vig->ymin)*vig->w + xmin-vig->xmin;
       if (wfield)
-        wstript = wstrip + pos;
+        wstript = wvig->pix + (y-wvig->ymin)*wvig->w + xmin-wvig->xmin;
       for (x=xmin; x<xmax; x++, stript++, wstript++)
         {
         dx = x - mx;
@@ -526,6 +541,7 @@ void  computeautoflux(picstruct *field, picstruct *dfield, picstruct *wfield,
    PIXTYPE		*strip,*stript, *dstrip,*dstript, *wstrip,*wstript,
 			*dwstrip,*dwstript,
 			pix, wthresh=0.0, dwthresh=0.0;
+   measvigstruct	*vig, *wvig, *dvig, *dwvig;
 
 
 /* Let's initialize some variables */
@@ -537,6 +553,7 @@ void  computeautoflux(picstruct *field, picstruct *dfield, picstruct *wfield,
   if (wfield)
     wthresh = wfield->weight_thresh;
   wstript = dwstript = NULL;
+  wvig = dwvig = NULL;
   w = field->width;
   h = field->stripheight;
   fymin = field->ymin;
@@ -600,11 +617,15 @@ void  computeautoflux(picstruct *field, picstruct *dfield, picstruct *wfield,
   dstrip = dfield->strip;
   if (dwfield)
     dwstrip = dwfield->strip;
+  dvig = measvig_get(field, dstrip, xmin,xmax, ymin,ymax);
+  if (dwfield)
+    dwvig = measvig_get(field, dwstrip, xmin,xmax, ymin,ymax);
   for (y=ymin; y<ymax; y++)
     {
-    dstript = dstrip + (pos = xmin + (y%h)*w);
+    dstript = dvig->pix + (y-dvig->ymin)*dvig->w + xmin-dvig->xmin;
     if (dwfield)
-      dwstript = dwstrip + pos;
+      dwstript = dwvig->pix + (y-dwvig->ymin)*dwvig->w
+		+ xmin-dwvig->xmin;
     for (x=xmin; x<xmax; x++, dstript++, dwstript++)
       {
       dx = x - mx;
@@ -690,11 +711,14 @@ void  computeautoflux(picstruct *field, picstruct *dfield, picstruct *wfield,
     strip = field->strip;
     if (wfield)
       wstrip = wfield->strip;
+    vig = measvig_get(field, strip, xmin,xmax, ymin,ymax);
+    if (wfield)
+      wvig = measvig_get(field, wstrip, xmin,xmax, ymin,ymax);
     for (y=ymin; y<ymax; y++)
       {
-      stript = strip + (pos = xmin + (y%h)*w);
+      stript = vig->pix + (y-vig->ymin)*vig->w + xmin-vig->xmin;
       if (wfield)
-        wstript = wstrip + pos;
+        wstript = wvig->pix + (y-wvig->ymin)*wvig->w + xmin-wvig->xmin;
       for (x=xmin; x<xmax; x++, stript++, wstript++)
         {
         dx = x - mx;
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -32,6 +32,7 @@
 
 #include	<stdio.h>
 #include	<stdlib.h>
+#include	<string.h>
 
 #include	"define.h"
 #include	"globals.h"
@@ -45,6 +46,8 @@ int	plistexist_value, plistexist_dvalue, plistexist_cdvalue,
 	plistoff_flag[MAXFLAG], plistoff_wflag, plistoff_dthresh, plistoff_var,
 	plistoff_dgeox, plistoff_dgeoy, plistsize;
 
+static plistsoastruct	plistsoa;
+
 
 /******************************** createblank *******************************
 PROTO   int createblank(int no, objliststruct *objlist)
@@ -244,3 +247,153 @@ void	init_plist(void)
   return;
   }
 
+
+
+/****************************** compact_plist *********************************
+PROTO	plistsoastruct *compact_plist(objliststruct *objlist, int no)
+PURPOSE	Copy the pixels of an object to contiguous arrays.
+INPUT	objlist pointer,
+	objlist number.
+OUTPUT	Pointer to the compacted pixel arrays.
+NOTES	Pixels are stored in pixel-list order, so that sums computed from the
+	arrays are identical to those computed by walking the list. Missing
+	components point to the ones PLISTPIX() falls back to. A single object
+	is kept at a time; it stays valid until reset_compactplist() is called.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+plistsoastruct	*compact_plist(objliststruct *objlist, int no)
+
+  {
+   plistsoastruct	*soa;
+   pliststruct		*pixel, *pixt;
+   int			n, nmax;
+
+  soa = &plistsoa;
+  pixel = objlist->plist;
+  n = 0;
+  for (pixt=pixel+objlist->obj[no].firstpix; pixt>=pixel;
+	pixt=pixel+PLIST(pixt,nextpix))
+    {
+    if (n >= soa->npixmax)
+      {
+      nmax = soa->npixmax? 2*soa->npixmax : 1024;
+      QREALLOC(soa->x, int, nmax);
+      QREALLOC(soa->y, int, nmax);
+      QREALLOC(soa->value, PIXTYPE, nmax);
+      if (PLISTEXIST(dvalue))
+        QREALLOC(soa->dvalue, PIXTYPE, nmax);
+      if (PLISTEXIST(cdvalue))
+        QREALLOC(soa->cdvalue, PIXTYPE, nmax);
+      if (PLISTEXIST(var))
+        QREALLOC(soa->var, PIXTYPE, nmax);
+      if (PLISTEXIST(dthresh))
+        QREALLOC(soa->dthresh, PIXTYPE, nmax);
+      if (PLISTEXIST(dgeo))
+        {
+        QREALLOC(soa->dgeox, PIXTYPE, nmax);
+        QREALLOC(soa->dgeoy, PIXTYPE, nmax);
+        }
+      soa->npixmax = nmax;
+      }
+    soa->x[n] = PLIST(pixt,x);
+    soa->y[n] = PLIST(pixt,y);
+    soa->value[n] = PLIST(pixt,value);
+    if (PLISTEXIST(dvalue))
+      soa->dvalue[n] = PLISTPIX(pixt,dvalue);
+    if (PLISTEXIST(cdvalue))
+      soa->cdvalue[n] = PLISTPIX(pixt,cdvalue);
+    if (PLISTEXIST(var))
+      soa->var[n] = PLISTPIX(pixt,var);
+    if (PLISTEXIST(dthresh))
+      soa->dthresh[n] = PLISTPIX(pixt,dthresh);
+    if (PLISTEXIST(dgeo))
+      {
+      soa->dgeox[n] = PLISTPIX(pixt,dgeox);
+      soa->dgeoy[n] = PLISTPIX(pixt,dgeoy);
+      }
+    n++;
+    }
+
+/* Same fallbacks as the PLISTPIX() offsets */
+  soa->plist = pixel;
+  soa->firstpix = objlist->obj[no].firstpix;
+  soa->npix = n;
+  if (!PLISTEXIST(dvalue))
+    soa->dvalue = soa->value;
+  if (!PLISTEXIST(cdvalue))
+    soa->cdvalue = soa->dvalue;
+
+  return soa;
+  }
+
+
+/**************************** get_compactplist ********************************
+PROTO	plistsoastruct *get_compactplist(pliststruct *plist, objstruct *obj)
+PURPOSE	Return the compacted pixel arrays of an object, if available.
+INPUT	Pixel-list pointer,
+	object pointer.
+OUTPUT	Pointer to the compacted pixel arrays, or NULL if the object has not
+	been compacted.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+plistsoastruct	*get_compactplist(pliststruct *plist, objstruct *obj)
+
+  {
+  if (plistsoa.plist && plistsoa.plist==plist
+	&& plistsoa.firstpix==obj->firstpix)
+    return &plistsoa;
+
+  return NULL;
+  }
+
+
+/*************************** reset_compactplist *******************************
+PROTO	void reset_compactplist(void)
+PURPOSE	Invalidate the compacted pixel arrays.
+INPUT	-.
+OUTPUT	-.
+NOTES	Must be called before the pixel-list is modified or freed.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	reset_compactplist(void)
+
+  {
+  plistsoa.plist = NULL;
+  plistsoa.npix = 0;
+
+  return;
+  }
+
+
+/**************************** end_compactplist ********************************
+PROTO	void end_compactplist(void)
+PURPOSE	Free the compacted pixel arrays.
+INPUT	-.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	end_compactplist(void)
+
+  {
+  free(plistsoa.x);
+  free(plistsoa.y);
+  free(plistsoa.value);
+  if (PLISTEXIST(dvalue))
+    free(plistsoa.dvalue);
+  if (PLISTEXIST(cdvalue))
+    free(plistsoa.cdvalue);
+  free(plistsoa.var);
+  free(plistsoa.dthresh);
+  free(plistsoa.dgeox);
+  free(plistsoa.dgeoy);
+  memset(&plistsoa, 0, sizeof(plistsoastruct));
+
+  return;
+  }
+
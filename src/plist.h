@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -46,6 +46,18 @@ typedef struct
   PIXTYPE       value;
   }	pbliststruct;
 
+typedef struct
+  {
+  pliststruct	*plist;			/* pixel-list the object belongs to */
+  int		firstpix;		/* first pixel of the object */
+  int		npix;			/* number of pixels */
+  int		npixmax;		/* number of allocated pixels */
+  int		*x, *y;			/* pixel coordinates */
+  PIXTYPE	*value, *dvalue, *cdvalue;	/* pixel values */
+  PIXTYPE	*var, *dthresh;		/* variance and detection threshold */
+  PIXTYPE	*dgeox, *dgeoy;		/* differential geometry shifts */
+  }	plistsoastruct;
+
 /*-------------------------------- globals ----------------------------------*/
 
 extern int	plistexist_value, plistexist_dvalue, plistexist_cdvalue,
@@ -57,7 +69,12 @@ extern int	plistexist_value, plistexist_dvalue, plistexist_cdvalue,
 
 /*------------------------------- functions ---------------------------------*/
 
-void	init_plist(void);
+plistsoastruct	*compact_plist(objliststruct *objlist, int n),
+		*get_compactplist(pliststruct *plist, objstruct *obj);
+
+void	end_compactplist(void),
+	init_plist(void),
+	reset_compactplist(void);
 
 int	createblank(objliststruct *objlist, int n),
 	createsubmap(objliststruct *objlist, int n);
@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		07/03/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -57,10 +57,14 @@
    {"PIXEL","WORLD",""}},
   {"ASSOCSELEC_TYPE", P_KEY, &prefs.assocselec_type, 0,0, 0.0,0.0,
    {"ALL","MATCHED","-MATCHED",""}},
+  {"ASTROM_GRIDERR", P_FLOAT, &prefs.astrom_griderr, 0,0, 0.0, 1.0},
+  {"BACK_CACHE", P_BOOL, &prefs.backcache_flag},
+  {"BACK_CACHE_DIR", P_STRING, prefs.backcache_dir},
   {"BACK_FILTERSIZE", P_INTLIST, prefs.backfsize, 1,11, 0.0,0.0,
     {""}, 1,2, &prefs.nbackfsize},
   {"BACK_FILTTHRESH", P_FLOAT, &prefs.backfthresh, 0,0, 0.0,BIG},
   {"BACK_PEARSON", P_FLOAT, &prefs.back_pearson, 0,0, 1.0,BIG},
+  {"BACK_PYRAMID", P_BOOL, &prefs.backpyr_flag},
   {"BACKPHOTO_THICK", P_INT, &prefs.pback_size, 1, 256},
   {"BACKPHOTO_TYPE", P_KEY, &prefs.pback_type, 0,0, 0.0,0.0,
    {"GLOBAL","LOCAL",""}},
@@ -126,8 +130,15 @@
   {"MASK_TYPE", P_KEY, &prefs.mask_type, 0,0, 0.0,0.0,
    {"NONE","BLANK","CORRECT",""}},
   {"MEMORY_BUFSIZE", P_INT, &prefs.mem_bufsize, 8, 65534},
+  {"MEMORY_COMPACTAREA", P_INT, &prefs.mem_compactarea, 0, 2000000000},
+  {"MEMORY_LIMIT", P_FLOAT, &prefs.mem_limit, 0,0, 0.0, 1e9},
   {"MEMORY_OBJSTACK", P_INT, &prefs.clean_stacksize, 16,65536},
   {"MEMORY_PIXSTACK", P_INT, &prefs.mem_pixstack, 1000, 100000000},
+  {"MEM_MAX", P_INT, &prefs.mem_max, 0, 1000000000},
+  {"MODEL_BLENDFIT", P_BOOL, &prefs.model_blendflag},
+  {"MODEL_COARSEFAC", P_INT, &prefs.model_coarsefac, 1, 8},
+  {"MODEL_INIT", P_BOOL, &prefs.modelinit_flag},
+  {"MODEL_INIT_NAME", P_STRING, prefs.modelinit_name},
   {"NTHREADS", P_INT, &prefs.nthreads, -THREADS_PREFMAX, THREADS_PREFMAX},
   {"PARAMETERS_NAME", P_STRING, prefs.param_name},
   {"PATTERN_TYPE", P_KEY, &prefs.pattern_type, 0,0, 0.0,0.0,
@@ -144,6 +155,8 @@
   {"PHOT_PETROPARAMS", P_FLOATLIST, prefs.petroparam, 0,0, 0.0,10.0,
    {""}, 2,2, &prefs.npetroparam},
   {"PIXEL_SCALE", P_FLOAT, &prefs.pixel_scale, 0,0, 0.0, 1e+10},
+  {"PRESELECT", P_STRINGLIST, prefs.presel_name, 0,0,0.0,0.0,
+    {""}, 0, MAXLIST, &prefs.npresel_name},
   {"PSF_NAME", P_STRINGLIST, prefs.psf_name, 0,0, 0.0,0.0,
    {""}, 1, 2, &prefs.npsf_name},	/*?*/
   {"PSF_NMAX", P_INT, &prefs.psf_npsfmax, 1, PSF_NPSFMAX},
@@ -159,6 +172,8 @@
     1, 2, &prefs.nthresh_type},
   {"VERBOSE_TYPE", P_KEY, &prefs.verbose_type, 0,0, 0.0,0.0,
    {"QUIET","NORMAL", "EXTRA_WARNINGS", "FULL",""}},
+  {"VMEM_DIR", P_STRING, prefs.swapdir_name},
+  {"VMEM_MAX", P_INT, &prefs.vmem_max, 1, 1000000000},
   {"WEIGHT_GAIN", P_BOOL, &prefs.weightgain_flag},
   {"WEIGHT_IMAGE", P_STRINGLIST, prefs.wimage_name, 0,0,0.0,0.0,
     {""}, 0, MAXIMAGE, &prefs.nwimage_name},
@@ -212,6 +227,8 @@ char *default_prefs[] =
 " ",
 "MASK_TYPE        CORRECT        # type of detection MASKing: can be one of",
 "                                # NONE, BLANK or CORRECT",
+"*PRESELECT        NONE           # cuts applied before measuring, e.g.",
+"*                                # FLAGS<4,ISOAREA_IMAGE>10,MAG_ISO<22",
 " ",
 "*#-------------------------------- WEIGHTing ----------------------------------",
 "*",
@@ -251,6 +268,8 @@ char *default_prefs[] =
 "GAIN             0.0            # detector gain in e-/ADU",
 "GAIN_KEY         GAIN           # keyword for detector gain in e-/ADU",
 "PIXEL_SCALE      1.0            # size of pixel in arcsec (0=use FITS WCS info)",
+"*ASTROM_GRIDERR   0.0            # max. error of interpolated WCS positions",
+"*                                # (in pixels, 0=exact transforms)",
 " ",
 "#------------------------- Star/Galaxy Separation ----------------------------",
 " ",
@@ -266,6 +285,11 @@ char *default_prefs[] =
 "*                                # Legacy value is 2.5, but 3.5 is more accurate",
 "BACK_SIZE        64             # Background mesh: <size> or <width>,<height>",
 "BACK_FILTERSIZE  3              # Background filter: <size> or <width>,<height>",
+"*BACK_PYRAMID     N              # Estimate background from a decimated image",
+"*                                # pyramid saved next to the image (Y/N)?",
+"*BACK_CACHE       N              # Reuse background maps from previous runs",
+"*                                # on the same data (Y/N)?",
+"*BACK_CACHE_DIR   .              # Directory of the background cache files",
 " ",
 "BACKPHOTO_TYPE   GLOBAL         # can be GLOBAL or LOCAL",
 "*BACKPHOTO_THICK  24             # thickness of the background LOCAL annulus",
@@ -285,6 +309,14 @@ char *default_prefs[] =
 "MEMORY_OBJSTACK  3000           # number of objects in stack",
 "MEMORY_PIXSTACK  300000         # number of pixels in stack",
 "MEMORY_BUFSIZE   1024           # number of lines in buffer",
+"MEMORY_LIMIT     0              # memory budget in MB, overriding the above",
+"                                # (0 = no budget)",
+"*MEMORY_COMPACTAREA 1000         # min. object area for contiguous pixel arrays",
+"*                                # in measurements (0 = never)",
+"*MEM_MAX          0              # RAM for full-frame check-images in MB",
+"*                                # (0 = unlimited)",
+"*VMEM_DIR         .              # directory path for swap files",
+"*VMEM_MAX         65536          # max. swap space for check-images in MB",
 " ",
 "*#------------------------------- ASSOCiation ---------------------------------",
 "*",
@@ -322,6 +354,12 @@ char *default_prefs[] =
 "*",
 "*PSF_NAME         default.psf    # File containing the PSF model",
 "*PSF_NMAX         1              # Max.number of PSFs fitted simultaneously",
+"*MODEL_BLENDFIT   N              # Fit overlapping objects simultaneously",
+"*MODEL_COARSEFAC  1              # Model grid coarsening factor for a first",
+"*                                # fitting pass (1 = no coarse pass)",
+"*MODEL_INIT       N              # Start fits from a previous FITS_LDAC catalog",
+"*MODEL_INIT_NAME  prior.cat      # Catalog with XMODEL_IMAGE, YMODEL_IMAGE and",
+"*                                # VECTOR_MODEL from a previous run",
 "*PATTERN_TYPE     RINGS-HARMONIC # can RINGS-QUADPOLE, RINGS-OCTOPOLE,",
 "*                                # RINGS-HARMONICS or GAUSS-LAGUERRE",
 "*SOM_NAME         default.som    # File containing Self-Organizing Map weights",
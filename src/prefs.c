@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -56,6 +56,8 @@
 #include	"preflist.h"
 #include	"fits/fitscat.h"
 
+extern size_t	body_maxram, body_maxvram, body_ramflag;
+
 int		findkeys(char *str, char key[][32], int mode);
 
 prefstruct	prefs;
@@ -80,6 +82,22 @@ void    dumpprefs(int state)
   }
 
 
+/******************************** findprefkey *******************************/
+/*
+Check that a configuration keyword exists (returns RETURN_OK if it does).
+*/
+int	findprefkey(char *keyword)
+  {
+   int	i;
+
+  for (i=0; key[i].name[0]; i++)
+    if (!strcmp(keyword, key[i].name))
+      return RETURN_OK;
+
+  return RETURN_ERROR;
+  }
+
+
 /********************************* readprefs ********************************/
 /*
 Read a configuration file in ``standard'' format (see the SExtractor
@@ -618,6 +636,14 @@ void	useprefs()
     error(EXIT_FAILURE, "*Error*: CHECKIMAGE_NAME(s) and CHECKIMAGE_TYPE(s)",
 		" are not in equal number");
 
+/* Full-frame check-images go to swap files beyond MEM_MAX */
+  body_maxram = prefs.mem_max? (size_t)prefs.mem_max*1024*1024 : (size_t)-1;
+  body_maxvram = (size_t)prefs.vmem_max*1024*1024;
+  if (set_swapdir(prefs.swapdir_name) != RETURN_OK)
+    error(EXIT_FAILURE, "*Error*: VMEM_DIR path is too long: ",
+		prefs.swapdir_name);
+  body_ramflag = 0;
+
 /*---------------------------- PSF-fitting ---------------------------------*/
   if (FLAG(obj2.flux_psf) )
     {
@@ -782,6 +808,8 @@ void	endprefs(void)
       free(prefs.psf_name[i]);
   for (i=0; i<prefs.ncheck_name; i++)
       free(prefs.check_name[i]);
+  for (i=0; i<prefs.npresel_name; i++)
+      free(prefs.presel_name[i]);
 
   return;
   }
@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		07/03/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -97,7 +97,7 @@ typedef struct
   enum {DGEO_NONE, DGEO_PIXELMAP}	dgeo_type;	/* diff.geo. scheme */
 /*----- photometry */
   enum	{CAT_NONE, ASCII, ASCII_HEAD, ASCII_SKYCAT, ASCII_VO,
-	FITS_LDAC, FITS_TPX, FITS_10}
+	FITS_LDAC, FITS_TPX, FITS_10, CAT_MEMORY}
 		cat_type;				/* type of catalog */
   enum	{PNONE, FIXED, AUTO}		apert_type;	/* type of aperture */
   double	apert[MAXNAPER];			/* apert size (pix) */
@@ -116,6 +116,7 @@ typedef struct
   char		gain_key[8];				/* gain keyword */
 /*----- S/G separation */
   double	pixel_scale;				/* in arcsec */
+  double	astrom_griderr;				/* max interp. error */
   double	seeing_fwhm;				/* in arcsec */
   char		nnw_name[MAXCHAR];			/* nnw filename */
 /*----- background */
@@ -131,16 +132,27 @@ typedef struct
   int		nbackfsize;				/* nb of params */
   double	backfthresh;				/* bkgnd fil. thresh */
   double	back_pearson;				/* Pearson's factor */
+  int		backpyr_flag;				/* bkgnd pyramid? */
+  int		backcache_flag;				/* bkgnd cache? */
+  char		backcache_dir[MAXCHAR];			/* bkgnd cache dir. */
   enum	{GLOBAL, LOCAL}			pback_type;	/* phot. bkgnd type */
   int		pback_size;				/* rect. ann. width */
 /*----- memory */
   int		clean_stacksize;			/* size of buffer */
   int		mem_pixstack;				/* pixel stack size */
   int		mem_bufsize;				/* strip height */
+  int		mem_compactarea;			/* min. compact area */
+  double	mem_limit;				/* memory budget (MB) */
+  int		mem_pixstackmax;			/* max. pixel stack */
+  int		mem_max;				/* max. RAM (MB) */
+  int		vmem_max;				/* max. swap (MB) */
+  char		swapdir_name[MAXCHAR];			/* swap directory */
 /*----- catalog output */
   char		param_name[MAXCHAR];			/* param. filename */
 /*----- miscellaneous */
   int		pipe_flag;				/* allow piping ? */
+  int		batch_flag;				/* batch mode ? */
+  char		batch_name[MAXCHAR];			/* job list filename */
   enum	{QUIET, NORM, WARN, FULL}      	verbose_type;	/* display type */
   int		xml_flag;				/* Write XML file? */
   char		xml_name[MAXCHAR];			/* XML file name */
@@ -172,6 +184,10 @@ typedef struct
   enum	{ASSOCSELEC_ALL, ASSOCSELEC_MATCHED, ASSOCSELEC_NOMATCHED}
 		assocselec_type;		       	/* type of assoc. */
   double	assoc_radius;				/* ASSOC range */
+/*----- pre-measurement selection */
+  char		*presel_name[MAXLIST];			/* selection cuts */
+  int		npresel_name;				/* nb of cuts */
+  int		presel_flag;				/* selection on? */
   int		assoc_size;				/* nb of parameters */
   char		retina_name[MAXCHAR];			/* retina filename */
   int		vignetsize[2];				/* vignet size */
@@ -230,6 +246,10 @@ typedef struct
   int		prof_flag;				/* Profile-fitting */
   int		dprof_flag;				/* Det. Prof.-fitting */
   int		pattern_flag;				/* Pattern-fitting */
+  int		model_coarsefac;			/* Coarse grid factor */
+  int		model_blendflag;			/* Joint blend fits? */
+  int		modelinit_flag;				/* Warm-start fits? */
+  char		modelinit_name[MAXCHAR];		/* Prior model cat. */
 /*----- Model-fitting */
   int		prof_vectorsize;			/* nb of params */
   int		prof_errvectorsize;			/* nb of params */
@@ -252,7 +272,8 @@ typedef struct
 extern prefstruct	prefs;
 
 /*-------------------------------- protos -----------------------------------*/
-extern int	cistrcmp(char *cs, char *ct, int mode);
+extern int	cistrcmp(char *cs, char *ct, int mode),
+		findprefkey(char *keyword);
 
 extern void	dumpprefs(int state),
 		endprefs(void),
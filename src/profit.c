@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		16/03/2016
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -44,7 +44,9 @@
 #include	"levmar/levmar.h"
 #include	"fft.h"
 #include	"fitswcs.h"
+#include	"assoc.h"
 #include	"check.h"
+#include	"image.h"
 #include	"pattern.h"
 #include	"psf.h"
 #include	"profit.h"
@@ -55,7 +57,40 @@ static float	prof_interpolate(profstruct *prof, float *posin);
 static float	interpolate_pix(float *posin, float *pix, int *naxisn,
 		interpenum interptype);
 
-static void	make_kernel(float pos, float *kernel, interpenum interptype);
+static void	make_kernel(float pos, float *kernel, interpenum interptype),
+		prof_sersicline(float *rtab, float *pix, int n, float x1,
+			float x1c, float x2c, float cd11, float cd21,
+			float rs2, float r2max, float a0, float a2, float a3);
+
+static float	*prof_rtab(profstruct *prof, double n, double k,
+			float r2min, float r2max);
+
+static void	profit_blenddone(profitstruct *profit, blendstruct *blend,
+			int k),
+		profit_blendevaluate(double *dpar, double *fvec, int m, int n,
+			void *adata),
+		prof_jacgrad(float *fdata, float *fmod, float *psfdft,
+			int *size),
+		prof_jacspec(float *fdata, float *fmod, float *psfdft,
+			double *g, double w, int *size);
+
+static double	profit_dunboundtobound(profitstruct *profit, int p);
+
+static profdepenum	prof_dep(profstruct *prof, float *param, double *g);
+
+#ifdef VEC_X86
+static VEC_AVX2 void	prof_sersicline_avx2(float *rtab, float *pix, int n,
+			float x1, float x1c, float x2c, float cd11, float cd21,
+			float rs2, float r2max, float a0, float a2, float a3);
+#endif
+
+/* Radial lookup tables are indexed by the IEEE-754 bits of r^2 */
+#define	PROF_RTABSHIFT	(23-PROFIT_RTABRES)
+#define	PROF_RTABMASK	((1<<PROF_RTABSHIFT)-1)
+#define	PROF_RTABIMIN	((127+PROFIT_RTABMINEXP)<<23)
+#define	PROF_RTABSIZE	(((PROFIT_RTABMAXEXP-PROFIT_RTABMINEXP)<<PROFIT_RTABRES)+2)
+#define	PROF_RTABJMAX	(((PROF_RTABSIZE-1)<<PROF_RTABSHIFT)-1)
+#define	PROF_RTABFSTEP	(1.0f/(float)(1<<PROF_RTABSHIFT))
 
 /*------------------------------- variables ---------------------------------*/
 
@@ -126,14 +161,20 @@ INPUT	Prof structure.
 OUTPUT	-.
 NOTES	-.
 AUTHOR	E. Bertin (IAP)
-VERSION	17/02/2015
+VERSION	19/10/2026
  ***/
 void	profit_end(profitstruct *profit)
   {
-   int	p;
+   blendstruct	*blend;
+   int		p;
 
   for (p=0; p<profit->nprof; p++)
     prof_end(profit->prof[p]);
+  while ((blend=profit->blend))
+    {
+    profit->blend = blend->nextblend;
+    profit_blendfree(blend);
+    }
   free(profit->modpix);
   free(profit->modpix2);
   free(profit->cmodpix);
@@ -171,13 +212,14 @@ OUTPUT	Pointer to an allocated fit structure (containing details about the
 	fit).
 NOTES	It is a modified version of the lm_minimize() of lmfit.
 AUTHOR	E. Bertin (IAP)
-VERSION	09/09/2015
+VERSION	19/10/2026
  ***/
 void	profit_fit(profitstruct *profit,
 		picstruct *field, picstruct *wfield, picstruct *dgeofield,
 		objstruct *obj, obj2struct *obj2)
   {
     profitstruct	*pprofit, *qprofit;
+    blendstruct		*blend;
     patternstruct	*pattern;
     psfstruct		*psf;
     checkstruct		*check;
@@ -189,9 +231,9 @@ void	profit_fit(profitstruct *profit,
 			param[PARAM_NPARAM],
 			**list,
 			*cov,
-			psf_fwhm, dchi2, aspect, chi2;
+			dchi2, aspect, chi2;
     int			*index,
-			c,i,j,p, nparam, nparam2, ncomp, nprof;
+			c,i,j,k,p, nparam, nparam2, ncomp, nprof;
 
   nparam = profit->nparam;
   nparam2 = nparam*nparam;
@@ -207,46 +249,9 @@ void	profit_fit(profitstruct *profit,
 
   profit->dgeoflag = (dgeofield != NULL);
 
-/* Create pixmaps at image resolution */
-  profit->ix = (int)(obj->mx + 0.49999);/* internal convention: 1st pix = 0 */
-  profit->iy = (int)(obj->my + 0.49999);/* internal convention: 1st pix = 0 */
-  psf_fwhm = psf->masksize[0]*psf->pixstep;
-  profit->objnaxisn[0] = (((int)((obj->xmax-obj->xmin+1) + psf_fwhm + 0.499)
-		*1.2)/2)*2 + 1;
-  profit->objnaxisn[1] = (((int)((obj->ymax-obj->ymin+1) + psf_fwhm + 0.499)
-		*1.2)/2)*2 + 1;
-  if (profit->objnaxisn[1]<profit->objnaxisn[0])
-    profit->objnaxisn[1] = profit->objnaxisn[0];
-  else
-    profit->objnaxisn[0] = profit->objnaxisn[1];
-  if (profit->objnaxisn[0]>PROFIT_MAXOBJSIZE)
-    {
-    profit->subsamp = ceil((float)profit->objnaxisn[0]/PROFIT_MAXOBJSIZE);
-    profit->objnaxisn[1] = (profit->objnaxisn[0] /= (int)profit->subsamp);
-    obj2->prof_flag |= PROFLAG_OBJSUB;
-    }
-  else
-    profit->subsamp = 1.0;
-  profit->nobjpix = profit->objnaxisn[0]*profit->objnaxisn[1];
-
-/* Create pixmap at model resolution */
-  profit->modnaxisn[0] =
-	((int)(profit->objnaxisn[0]*profit->subsamp/profit->pixstep
-		+0.4999)/2+1)*2; 
-  profit->modnaxisn[1] =
-	((int)(profit->objnaxisn[1]*profit->subsamp/profit->pixstep
-		+0.4999)/2+1)*2; 
-  if (profit->modnaxisn[1] < profit->modnaxisn[0])
-    profit->modnaxisn[1] = profit->modnaxisn[0];
-  else
-    profit->modnaxisn[0] = profit->modnaxisn[1];
-  if (profit->modnaxisn[0]>PROFIT_MAXMODSIZE)
-    {
-    profit->pixstep = (double)profit->modnaxisn[0] / PROFIT_MAXMODSIZE;
-    profit->modnaxisn[0] = profit->modnaxisn[1] = PROFIT_MAXMODSIZE;
-    obj2->prof_flag |= PROFLAG_MODSUB;
-    }
-  profit->nmodpix = profit->modnaxisn[0]*profit->modnaxisn[1];
+/* Create pixmaps at image and model resolutions */
+  obj2->prof_flag |= profit_frame(profit, obj->mx, obj->my,
+			obj->xmax-obj->xmin+1, obj->ymax-obj->ymin+1);
 
 /* Use (dirty) global variables to interface with lmfit */
   the_field = field;
@@ -293,6 +298,8 @@ void	profit_fit(profitstruct *profit,
   profit->guessposang = obj->theta;
 
   profit_resetparams(profit);
+  if (field->modelassoc)
+    profit_warmstart(profit, field, obj2);
 
 /* Actual minimisation */
   fft_reset();
@@ -323,7 +330,14 @@ for (i=profit->nobjpix; i--;)
 free(bpix);
 free(opix);
 */
-  profit->niter = profit_minimize(profit, PROFIT_MAXITER);
+/* Objects fitted jointly with their neighbours are already done */
+  if ((blend = profit_blendfind(profit, obj, &k)))
+    profit_blendload(profit, blend, k, obj2);
+  else
+    {
+    profit->niter = profit_coarsefit(profit, prefs.model_coarsefac);
+    profit->niter += profit_minimize(profit, PROFIT_MAXITER);
+    }
 /*
 profit_residuals(profit,field,wfield, 0.0, profit->paraminit, NULL);
 check=initcheck(str, CHECK_OTHER,1);
@@ -1007,6 +1021,675 @@ profit->niter = profit_minimize(profit, PROFIT_MAXITER);
   }
 
 
+/****** profit_frame **********************************************************
+PROTO	int profit_frame(profitstruct *profit, double mx, double my,
+			int w, int h)
+PURPOSE	Set the geometry of the object and model rasters for a fit.
+INPUT	Pointer to the profit structure,
+	x barycenter of the fitted footprint (internal convention),
+	y barycenter of the fitted footprint (internal convention),
+	width of the footprint,
+	height of the footprint.
+OUTPUT	PROFLAG_OBJSUB and/or PROFLAG_MODSUB if the rasters had to be resized.
+NOTES	profit->pixstep must have been set to the PSF sampling step.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	profit_frame(profitstruct *profit, double mx, double my, int w, int h)
+  {
+   psfstruct	*psf;
+   float	psf_fwhm;
+   int		flag;
+
+  psf = profit->psf;
+  flag = 0;
+
+/* Create pixmaps at image resolution */
+  profit->ix = (int)(mx + 0.49999);	/* internal convention: 1st pix = 0 */
+  profit->iy = (int)(my + 0.49999);	/* internal convention: 1st pix = 0 */
+  psf_fwhm = psf->masksize[0]*psf->pixstep;
+  profit->objnaxisn[0] = (((int)(w + psf_fwhm + 0.499)*1.2)/2)*2 + 1;
+  profit->objnaxisn[1] = (((int)(h + psf_fwhm + 0.499)*1.2)/2)*2 + 1;
+  if (profit->objnaxisn[1]<profit->objnaxisn[0])
+    profit->objnaxisn[1] = profit->objnaxisn[0];
+  else
+    profit->objnaxisn[0] = profit->objnaxisn[1];
+  if (profit->objnaxisn[0]>PROFIT_MAXOBJSIZE)
+    {
+    profit->subsamp = ceil((float)profit->objnaxisn[0]/PROFIT_MAXOBJSIZE);
+    profit->objnaxisn[1] = (profit->objnaxisn[0] /= (int)profit->subsamp);
+    flag |= PROFLAG_OBJSUB;
+    }
+  else
+    profit->subsamp = 1.0;
+  profit->nobjpix = profit->objnaxisn[0]*profit->objnaxisn[1];
+
+/* Create pixmap at model resolution */
+  profit->modnaxisn[0] =
+	((int)(profit->objnaxisn[0]*profit->subsamp/profit->pixstep
+		+0.4999)/2+1)*2; 
+  profit->modnaxisn[1] =
+	((int)(profit->objnaxisn[1]*profit->subsamp/profit->pixstep
+		+0.4999)/2+1)*2; 
+  if (profit->modnaxisn[1] < profit->modnaxisn[0])
+    profit->modnaxisn[1] = profit->modnaxisn[0];
+  else
+    profit->modnaxisn[0] = profit->modnaxisn[1];
+  if (profit->modnaxisn[0]>PROFIT_MAXMODSIZE)
+    {
+    profit->pixstep = (double)profit->modnaxisn[0] / PROFIT_MAXMODSIZE;
+    profit->modnaxisn[0] = profit->modnaxisn[1] = PROFIT_MAXMODSIZE;
+    flag |= PROFLAG_MODSUB;
+    }
+  profit->nmodpix = profit->modnaxisn[0]*profit->modnaxisn[1];
+
+  return flag;
+  }
+
+
+/****** profit_blendfit *******************************************************
+PROTO	int profit_blendfit(profitstruct *profit, picstruct *field,
+			picstruct *wfield, picstruct *dgeofield,
+			objliststruct *objlist, int n, obj2struct *obj2)
+PURPOSE	Fit simultaneously an object and the pending objects that overlap it.
+INPUT	Pointer to the profit structure,
+	pointer to the field,
+	pointer to the field weight,
+	pointer to the differential geometry field,
+	pointer to the list of pending objects,
+	index of the current object in the list,
+	pointer to the obj2 of the current object.
+OUTPUT	Number of objects fitted jointly (0 if no joint fit was done).
+NOTES	Members are connected through the overlap of their isophotal
+	footprints, enlarged by the PSF FWHM. All members share the same
+	object and model rasters, hence the same PSF DFT and FFT plans.
+	The results are stored in the blend list of the profit structure and
+	used by profit_fit() when each member gets measured.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	profit_blendfit(profitstruct *profit, picstruct *field,
+			picstruct *wfield, picstruct *dgeofield,
+			objliststruct *objlist, int n, obj2struct *obj2)
+  {
+   blendstruct	*blend;
+   objstruct	*obj, *objk, *objj;
+   psfstruct	*psf;
+   double	lm_opts[5], info[LM_INFO_SZ],
+		*dparam, *dcovar, *dcovark, margin;
+   int		member[PROFIT_BLENDMAX],
+		i,j,k,f, p, nmember, nparam, nfree, npresi,
+		xmin,xmax,ymin,ymax;
+
+  obj = objlist->obj + n;
+  if (profit_blendfind(profit, obj, NULL))
+    return 0;
+
+  psf = profit->psf;
+  nparam = profit->nparam;
+  margin = psf->fwhm;
+
+/* Gather the pending objects connected to the current one */
+  member[0] = n;
+  nmember = 1;
+  for (k=0; k<nmember; k++)
+    {
+    objk = objlist->obj + member[k];
+    for (j=0; j<objlist->nobj && nmember<PROFIT_BLENDMAX; j++)
+      {
+      for (i=0; i<nmember && member[i]!=j; i++);
+      if (i<nmember)
+        continue;
+      objj = objlist->obj + j;
+      if (objj->xmin - margin > objk->xmax + margin
+	|| objk->xmin - margin > objj->xmax + margin
+	|| objj->ymin - margin > objk->ymax + margin
+	|| objk->ymin - margin > objj->ymax + margin
+	|| profit_blendfind(profit, objj, NULL))
+        continue;
+      member[nmember++] = j;
+      }
+    }
+
+  if (nmember<2)
+    return 0;
+
+/* Set up a raster that encloses all members */
+  xmin = obj->xmin;
+  xmax = obj->xmax;
+  ymin = obj->ymin;
+  ymax = obj->ymax;
+  for (k=1; k<nmember; k++)
+    {
+    objk = objlist->obj + member[k];
+    if (objk->xmin < xmin)
+      xmin = objk->xmin;
+    if (objk->xmax > xmax)
+      xmax = objk->xmax;
+    if (objk->ymin < ymin)
+      ymin = objk->ymin;
+    if (objk->ymax > ymax)
+      ymax = objk->ymax;
+    }
+
+  if (profit->psfdft)
+    QFFTWF_FREE(profit->psfdft);
+  profit->pixstep = psf->pixstep;
+  profit->dgeoflag = (dgeofield != NULL);
+  profit_frame(profit, 0.5*(xmin+xmax), 0.5*(ymin+ymax),
+		xmax-xmin+1, ymax-ymin+1);
+
+  the_field = field;
+  the_wfield = wfield;
+  theprofit = profit;
+  profit->obj = obj;
+  profit->obj2 = obj2;
+  profit_psf(profit);
+
+/* Neighbours are still BLANKed: bring their pixels back for the fit */
+  if (prefs.blank_flag)
+    for (k=1; k<nmember; k++)
+      if ((objk = objlist->obj + member[k])->blank)
+        pasteimage(field, objk->blank, objk->subw, objk->subh,
+		objk->subx, objk->suby);
+  profit->nresi = profit_copyobjpix(profit, field, wfield, dgeofield);
+  if (prefs.blank_flag)
+    for (k=1; k<nmember; k++)
+      if ((objk = objlist->obj + member[k])->blank)
+        blankimage(field, objk->blank, objk->subw, objk->subh,
+		objk->subx, objk->suby, -BIG);
+
+/* Set initial guesses and boundaries for every member */
+  QCALLOC(blend, blendstruct, 1);
+  blend->profit = profit;
+  blend->nmember = nmember;
+  QMALLOC(blend->pos, double, 2*nmember);
+  QCALLOC(blend->done, int, nmember);
+  QCALLOC(blend->flag, int, nmember);
+  QMALLOC(blend->nfree, int, nmember);
+  QMALLOC(blend->param, float, nmember*PARAM_NPARAM);
+  QMALLOC(blend->parammin, float, nmember*PARAM_NPARAM);
+  QMALLOC(blend->parammax, float, nmember*PARAM_NPARAM);
+  QMALLOC(blend->parfittype, parfitenum, nmember*PARAM_NPARAM);
+  QMALLOC(blend->dparampcen, double, nmember*PARAM_NPARAM);
+  QMALLOC(blend->dparampsig, double, nmember*PARAM_NPARAM);
+  QCALLOC(blend->covar, float, nmember*nparam*nparam);
+  QMALLOC(dparam, double, nmember*PARAM_NPARAM);
+  nfree = npresi = 0;
+  for (k=0; k<nmember; k++)
+    {
+    objk = objlist->obj + member[k];
+    blend->pos[2*k] = objk->mx;
+    blend->pos[2*k+1] = objk->my;
+    profit->guesssigbkg = profit->sigma = objk->sigbkg;
+    profit->guessdx = objk->mx - profit->ix;
+    profit->guessdy = objk->my - profit->iy;
+    if (!k)
+      {
+/*---- The current object has its full set of measurements */
+      if ((profit->guessflux = obj2->flux_auto) <= 0.0)
+        profit->guessflux = 0.0;
+      profit->guessfluxmax = 10.0*obj2->fluxerr_auto;
+      if ((profit->guessradius = 0.5*psf->fwhm) < obj2->hl_radius)
+        profit->guessradius = obj2->hl_radius;
+      }
+    else
+      {
+/*---- Neighbours only have their isophotal measurements */
+      if ((profit->guessflux = objk->flux) <= 0.0)
+        profit->guessflux = 0.0;
+      profit->guessfluxmax = objk->fluxerr>0.0? 10.0*sqrt(objk->fluxerr) : 0.0;
+      if ((profit->guessradius = sqrtf(objk->a*objk->b)*1.17) < 0.5*psf->fwhm)
+        profit->guessradius = 0.5*psf->fwhm;
+      }
+    if (profit->guessfluxmax <= profit->guessflux)
+      profit->guessfluxmax = profit->guessflux;
+    if (profit->guessfluxmax <= 0.0)
+      profit->guessfluxmax = 1.0;
+    profit->guessaspect = objk->b/objk->a;
+    profit->guessposang = objk->theta;
+    profit_resetparams(profit);
+/*-- A single background offset is fitted for the whole blend */
+    if (k && profit->paramlist[PARAM_BACK])
+      {
+      p = profit->paramindex[PARAM_BACK];
+      profit->parfittype[p] = PARFIT_FIXED;
+      profit->paraminit[p] = 0.0;
+      }
+    profit_blendsave(profit, blend, k);
+    nfree += (blend->nfree[k] = profit_boundtounbound(profit,
+			profit->paraminit, dparam+nfree, PARAM_ALLPARAMS));
+    for (p=0; p<nparam; p++)
+      if (profit->dparampsig[p]>0.0)
+        npresi++;
+    }
+  profit->npresi = npresi;
+
+  if (profit->nresi < nfree)
+    {
+    free(dparam);
+    profit_blendfree(blend);
+    return 0;
+    }
+
+/* Models of each member are cached for the 2 last sets of parameters */
+  for (i=0; i<2; i++)
+    {
+    QMALLOC(blend->dslot[i], double, nmember*PARAM_NPARAM);
+    QMALLOC(blend->lmodslot[i], PIXTYPE, nmember*profit->nobjpix);
+    QCALLOC(blend->slotflag[i], int, nmember);
+    }
+  QCALLOC(blend->lastslot, int, nmember);
+
+/* Actual minimisation */
+  fft_reset();
+  QCALLOC(dcovar, double, nfree*nfree);
+  lm_opts[0] = 1.0e-3;		/* Initial mu */
+  lm_opts[1] = 1.0e-6;		/* ||J^T e||_inf stopping factor */
+  lm_opts[2] = 1.0e-6;		/* |Dp||_2 stopping factor */
+  lm_opts[3] = 1.0e-6;		/* ||e||_2 stopping factor */
+  lm_opts[4] = 1.0e-4;		/* Jacobian step */
+  blend->niter = dlevmar_dif(profit_blendevaluate, dparam, NULL, nfree,
+			profit->nresi + profit->npresi,
+			PROFIT_MAXITER, lm_opts, info, NULL, dcovar, blend);
+
+/* Store the results of each member, with absolute positions */
+  QMALLOC(dcovark, double, nparam*nparam);
+  for (k=0, f=0; k<nmember; f+=blend->nfree[k++])
+    {
+    profit_blendrestore(profit, blend, k);
+    profit_unboundtobound(profit, dparam+f, profit->paraminit,
+		PARAM_ALLPARAMS);
+    for (i=0; i<blend->nfree[k]; i++)
+      for (j=0; j<blend->nfree[k]; j++)
+        dcovark[i*blend->nfree[k]+j] = dcovar[(f+i)*nfree+f+j];
+    profit_covarunboundtobound(profit, dcovark, profit->covar);
+    memcpy(blend->covar+k*nparam*nparam, profit->covar,
+		nparam*nparam*sizeof(float));
+    if (profit->nlimmin)
+      blend->flag[k] |= PROFLAG_MINLIM;
+    if (profit->nlimmax)
+      blend->flag[k] |= PROFLAG_MAXLIM;
+    if (profit->paramlist[PARAM_X])
+      profit->paraminit[profit->paramindex[PARAM_X]] += (float)profit->ix;
+    if (profit->paramlist[PARAM_Y])
+      profit->paraminit[profit->paramindex[PARAM_Y]] += (float)profit->iy;
+    profit_blendsave(profit, blend, k);
+    }
+
+/* The background offset fitted with the first member is shared by all */
+  if (profit->paramlist[PARAM_BACK])
+    {
+    p = profit->paramindex[PARAM_BACK];
+    for (k=1; k<nmember; k++)
+      {
+      blend->param[k*PARAM_NPARAM+p] = blend->param[p];
+      blend->covar[(k*nparam+p)*nparam+p] = blend->covar[p*nparam+p];
+      }
+    }
+
+  for (i=0; i<2; i++)
+    {
+    free(blend->dslot[i]);
+    free(blend->lmodslot[i]);
+    free(blend->slotflag[i]);
+    blend->dslot[i] = NULL;
+    blend->lmodslot[i] = NULL;
+    blend->slotflag[i] = NULL;
+    }
+  free(blend->lastslot);
+  blend->lastslot = NULL;
+  free(dcovark);
+  free(dcovar);
+  free(dparam);
+
+/* Add the blend to the list */
+  blend->nextblend = profit->blend;
+  profit->blend = blend;
+
+  return nmember;
+  }
+
+
+/****** profit_blendevaluate **************************************************
+PROTO	void profit_blendevaluate(double *dpar, double *fvec, int m, int n,
+			void *adata)
+PURPOSE	Provide a function returning the residuals of a joint fit to levmar.
+INPUT	Pointer to the vector of parameters of all members,
+	pointer to the vector of residuals (output),
+	number of model parameters,
+	number of data points,
+	pointer to the blend structure.
+OUTPUT	-.
+NOTES	Only members whose parameters differ from those of one of their
+	two cached models are rendered again. As finite difference steps
+	change one parameter at a time, each column of the Jacobian costs a
+	single model, and the block structure of the Jacobian is exploited
+	implicitly.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	profit_blendevaluate(double *dpar, double *fvec, int m, int n,
+			void *adata)
+  {
+   blendstruct		*blend;
+   profitstruct		*profit;
+   PIXTYPE		*lmodpix, *slotpix;
+   double		dparam[PARAM_NPARAM],
+			*dslice, *fvect;
+   float		param[PARAM_NPARAM];
+   int			curslot[PROFIT_BLENDMAX],
+			i,k,p,s, nfree, npix;
+
+  blend = (blendstruct *)adata;
+  profit = blend->profit;
+  npix = profit->nobjpix;
+  dslice = dpar;
+  for (k=0; k<blend->nmember; k++, dslice+=nfree)
+    {
+    nfree = blend->nfree[k];
+    for (s=0; s<2; s++)
+      if (blend->slotflag[s][k] && !memcmp(dslice,
+		blend->dslot[s]+k*PARAM_NPARAM, nfree*sizeof(double)))
+        break;
+    if (s==2)
+      {
+/*---- Render the member model in the oldest slot */
+      s = 1 - blend->lastslot[k];
+      profit_blendrestore(profit, blend, k);
+      profit_unboundtobound(profit, dslice, param, PARAM_ALLPARAMS);
+      profit_residuals(profit, the_field, the_wfield, 0.0, param, NULL);
+      memcpy(blend->lmodslot[s]+k*npix, profit->lmodpix, npix*sizeof(PIXTYPE));
+      memcpy(blend->dslot[s]+k*PARAM_NPARAM, dslice, nfree*sizeof(double));
+      blend->slotflag[s][k] = 1;
+      blend->lastslot[k] = s;
+      }
+    curslot[k] = s;
+    }
+
+/* Sum the models of all members */
+  memcpy(profit->lmodpix, blend->lmodslot[curslot[0]], npix*sizeof(PIXTYPE));
+  for (k=1; k<blend->nmember; k++)
+    {
+    lmodpix = profit->lmodpix;
+    slotpix = blend->lmodslot[curslot[k]] + k*npix;
+    for (i=npix; i--;)
+      *(lmodpix++) += *(slotpix++);
+    }
+
+  profit_compresi(profit, PROFIT_DYNPARAM, profit->resi);
+  fvect = fvec;
+  for (p=0; p<profit->nresi; p++)
+    *(fvect++) = profit->resi[p];
+
+/* Priors (profit_presiduals() may read up to nparam values) */
+  dslice = dpar;
+  for (k=0; k<blend->nmember; dslice+=blend->nfree[k++])
+    {
+    profit_blendrestore(profit, blend, k);
+    memset(dparam, 0, profit->nparam*sizeof(double));
+    memcpy(dparam, dslice, blend->nfree[k]*sizeof(double));
+    profit_presiduals(profit, dparam, profit->presi);
+    for (i=0, p=0; p<profit->nparam; p++)
+      if (profit->dparampsig[p]>0.0)
+        *(fvect++) = profit->presi[i++];
+    }
+
+  return;
+  }
+
+
+/****** profit_blendsave ******************************************************
+PROTO	void profit_blendsave(profitstruct *profit, blendstruct *blend, int k)
+PURPOSE	Save the parameters and boundaries of a blend member.
+INPUT	Pointer to the profit structure,
+	pointer to the blend structure,
+	member index.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	profit_blendsave(profitstruct *profit, blendstruct *blend, int k)
+  {
+   int	off, nparam;
+
+  off = k*PARAM_NPARAM;
+  nparam = profit->nparam;
+  memcpy(blend->param+off, profit->paraminit, nparam*sizeof(float));
+  memcpy(blend->parammin+off, profit->parammin, nparam*sizeof(float));
+  memcpy(blend->parammax+off, profit->parammax, nparam*sizeof(float));
+  memcpy(blend->parfittype+off, profit->parfittype,
+		nparam*sizeof(parfitenum));
+  memcpy(blend->dparampcen+off, profit->dparampcen, nparam*sizeof(double));
+  memcpy(blend->dparampsig+off, profit->dparampsig, nparam*sizeof(double));
+
+  return;
+  }
+
+
+/****** profit_blendrestore ***************************************************
+PROTO	void profit_blendrestore(profitstruct *profit, blendstruct *blend,
+			int k)
+PURPOSE	Restore the parameters and boundaries of a blend member.
+INPUT	Pointer to the profit structure,
+	pointer to the blend structure,
+	member index.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	profit_blendrestore(profitstruct *profit, blendstruct *blend, int k)
+  {
+   int	off, nparam;
+
+  off = k*PARAM_NPARAM;
+  nparam = profit->nparam;
+  memcpy(profit->paraminit, blend->param+off, nparam*sizeof(float));
+  memcpy(profit->parammin, blend->parammin+off, nparam*sizeof(float));
+  memcpy(profit->parammax, blend->parammax+off, nparam*sizeof(float));
+  memcpy(profit->parfittype, blend->parfittype+off,
+		nparam*sizeof(parfitenum));
+  memcpy(profit->dparampcen, blend->dparampcen+off, nparam*sizeof(double));
+  memcpy(profit->dparampsig, blend->dparampsig+off, nparam*sizeof(double));
+
+  return;
+  }
+
+
+/****** profit_blendfind ******************************************************
+PROTO	blendstruct *profit_blendfind(profitstruct *profit, objstruct *obj,
+			int *k)
+PURPOSE	Find the joint fit an object belongs to.
+INPUT	Pointer to the profit structure,
+	pointer to the object,
+	pointer to the member index (output, may be NULL).
+OUTPUT	Pointer to the blend structure, or NULL if the object was not part of
+	a joint fit.
+NOTES	Objects are identified through their barycenter, as they get
+	renumbered in endobject() just before being measured.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+blendstruct	*profit_blendfind(profitstruct *profit, objstruct *obj, int *k)
+  {
+   blendstruct	*blend;
+   int		m;
+
+  for (blend=profit->blend; blend; blend=blend->nextblend)
+    for (m=0; m<blend->nmember; m++)
+      if (blend->pos[2*m] == obj->mx && blend->pos[2*m+1] == obj->my
+		&& !blend->done[m])
+        {
+        if (k)
+          *k = m;
+        return blend;
+        }
+
+  return NULL;
+  }
+
+
+/****** profit_blendload ******************************************************
+PROTO	void profit_blendload(profitstruct *profit, blendstruct *blend, int k,
+			obj2struct *obj2)
+PURPOSE	Load the results of a joint fit for one of its members, and subtract
+	the models of the other members from the object raster.
+INPUT	Pointer to the profit structure (set up for the member),
+	pointer to the blend structure,
+	member index,
+	pointer to the obj2 of the member.
+OUTPUT	-.
+NOTES	The blend is removed from the list once all members are loaded.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	profit_blendload(profitstruct *profit, blendstruct *blend, int k,
+			obj2struct *obj2)
+  {
+   PIXTYPE	*objpix, *objweight, *lmodpix;
+   float	param[PARAM_NPARAM];
+   int		i,j,p, nparam;
+
+  nparam = profit->nparam;
+
+/* Remove the light of the other members */
+  for (j=0; j<blend->nmember; j++)
+    {
+    if (j==k)
+      continue;
+    for (p=0; p<nparam; p++)
+      param[p] = blend->param[j*PARAM_NPARAM+p];
+    if (profit->paramlist[PARAM_X])
+      param[profit->paramindex[PARAM_X]] -= (float)profit->ix;
+    if (profit->paramlist[PARAM_Y])
+      param[profit->paramindex[PARAM_Y]] -= (float)profit->iy;
+/*-- The shared background stays with the current member */
+    if (profit->paramlist[PARAM_BACK])
+      param[profit->paramindex[PARAM_BACK]] = 0.0;
+    profit_residuals(profit, the_field, the_wfield, 0.0, param, NULL);
+    objpix = profit->objpix;
+    objweight = profit->objweight;
+    lmodpix = profit->lmodpix;
+    for (i=profit->nobjpix; i--; objpix++, lmodpix++)
+      if (*(objweight++)>0.0)
+        *objpix -= *lmodpix;
+    }
+
+/* Fitted parameters of the current member */
+  for (p=0; p<nparam; p++)
+    profit->paraminit[p] = blend->param[k*PARAM_NPARAM+p];
+  if (profit->paramlist[PARAM_X])
+    profit->paraminit[profit->paramindex[PARAM_X]] -= (float)profit->ix;
+  if (profit->paramlist[PARAM_Y])
+    profit->paraminit[profit->paramindex[PARAM_Y]] -= (float)profit->iy;
+  memcpy(profit->covar, blend->covar+k*nparam*nparam,
+		nparam*nparam*sizeof(float));
+  profit->niter = blend->niter;
+  profit->nlimmin = (blend->flag[k]&PROFLAG_MINLIM)? 1 : 0;
+  profit->nlimmax = (blend->flag[k]&PROFLAG_MAXLIM)? 1 : 0;
+  obj2->prof_flag |= PROFLAG_BLEND;
+
+  profit_blenddone(profit, blend, k);
+
+  return;
+  }
+
+
+/****** profit_blenddrop ******************************************************
+PROTO	void profit_blenddrop(profitstruct *profit, objstruct *obj)
+PURPOSE	Release the share of a pending joint fit held by an object that will
+	not be measured.
+INPUT	Pointer to the profit structure,
+	pointer to the obj.
+OUTPUT	-.
+NOTES	Must be called for members of a joint fit which are discarded before
+	being measured (PRESELECT, CLEANing), so that the joint fit is freed as
+	soon as the other members are done.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	profit_blenddrop(profitstruct *profit, objstruct *obj)
+  {
+   blendstruct	*blend;
+   int		k;
+
+  if ((blend = profit_blendfind(profit, obj, &k)))
+    profit_blenddone(profit, blend, k);
+
+  return;
+  }
+
+
+/****** profit_blenddone ******************************************************
+PROTO	void profit_blenddone(profitstruct *profit, blendstruct *blend, int k)
+PURPOSE	Mark a member of a joint fit as done, and discard the joint fit once
+	all its members are done.
+INPUT	Pointer to the profit structure,
+	pointer to the blend structure,
+	member index.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	profit_blenddone(profitstruct *profit, blendstruct *blend, int k)
+  {
+   blendstruct	**pblend;
+   int		j;
+
+  blend->done[k] = 1;
+  for (j=0; j<blend->nmember && blend->done[j]; j++);
+  if (j==blend->nmember)
+    {
+    for (pblend=&profit->blend; *pblend!=blend;
+		pblend=&(*pblend)->nextblend);
+    *pblend = blend->nextblend;
+    profit_blendfree(blend);
+    }
+
+  return;
+  }
+
+
+/****** profit_blendfree ******************************************************
+PROTO	void profit_blendfree(blendstruct *blend)
+PURPOSE	Free a blend structure.
+INPUT	Pointer to the blend structure.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	profit_blendfree(blendstruct *blend)
+  {
+   int	i;
+
+  free(blend->pos);
+  free(blend->done);
+  free(blend->flag);
+  free(blend->nfree);
+  free(blend->param);
+  free(blend->parammin);
+  free(blend->parammax);
+  free(blend->parfittype);
+  free(blend->dparampcen);
+  free(blend->dparampsig);
+  free(blend->covar);
+  for (i=0; i<2; i++)
+    {
+    free(blend->dslot[i]);
+    free(blend->lmodslot[i]);
+    free(blend->slotflag[i]);
+    }
+  free(blend->lastslot);
+  free(blend);
+
+  return;
+  }
+
+
 /****** profit_dfit ***********************************************************
 PROTO	void profit_dfit(profitstruct *profit, profitstruct *dprofit,
 		picstruct *field, picstruct *dfield,
@@ -1134,7 +1817,8 @@ void	profit_dfit(profitstruct *profit, profitstruct *dprofit,
 /* Actual minimisation */
   fft_reset();
 
-  dprofit->niter = profit_minimize(dprofit, PROFIT_MAXITER);
+  dprofit->niter = profit_coarsefit(dprofit, prefs.model_coarsefac);
+  dprofit->niter += profit_minimize(dprofit, PROFIT_MAXITER);
 
   if (dprofit->nlimmin)
     obj2->dprof_flag |= PROFLAG_MINLIM;
@@ -1554,21 +2238,75 @@ void	profit_psf(profitstruct *profit)
   }
 
 
+/****** profit_coarsefit *****************************************************
+PROTO	int profit_coarsefit(profitstruct *profit, int fac)
+PURPOSE	Fit the model on a coarser model grid to bring the initial guesses
+	of the full resolution fit close to the solution.
+INPUT	Pointer to the profit structure involved in the fit,
+	coarsening factor of the model grid.
+OUTPUT	Number of iterations used.
+NOTES	The coarsening factor is reduced as needed for the coarse model grid
+	to remain at least as fine as the object grid. The best-fitting
+	parameters are left in profit->paraminit, and the full resolution
+	PSF is restored on exit.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	profit_coarsefit(profitstruct *profit, int fac)
+  {
+   float	pixstep;
+   int		niter, modnaxisn;
+
+  while (fac>1 && profit->pixstep*fac > profit->subsamp)
+    fac--;
+  modnaxisn = profit->modnaxisn[0];
+  if (fac<2 || modnaxisn/fac < 2)
+    return 0;
+
+/* Switch to the coarse model grid */
+  pixstep = profit->pixstep;
+  profit->pixstep = pixstep*fac;
+  profit->modnaxisn[0] = profit->modnaxisn[1] = (modnaxisn/(2*fac))*2;
+  profit->nmodpix = profit->modnaxisn[0]*profit->modnaxisn[1];
+  if (profit->psfdft)
+    QFFTWF_FREE(profit->psfdft);
+  fft_reset();
+  profit_psf(profit);
+
+  niter = profit_minimize(profit, PROFIT_MAXITER);
+
+/* Back to full resolution */
+  profit->pixstep = pixstep;
+  profit->modnaxisn[0] = profit->modnaxisn[1] = modnaxisn;
+  profit->nmodpix = modnaxisn*modnaxisn;
+  if (profit->psfdft)
+    QFFTWF_FREE(profit->psfdft);
+  fft_reset();
+  profit_psf(profit);
+
+  return niter;
+  }
+
+
 /****** profit_minimize *******************************************************
 PROTO	void profit_minimize(profitstruct *profit)
 PURPOSE	Provide a function returning residuals to lmfit.
 INPUT	Pointer to the profit structure involved in the fit,
 	maximum number of iterations.
 OUTPUT	Number of iterations used.
-NOTES	-.
+NOTES	The Jacobian provided by profit_jacobian() is used unless more than
+	PROFIT_MAXJACRENDER parameters require rebuilding model components
+	(e.g. the features of spiral galaxy models), in which case levmar
+	relies on finite differences and secant updates.
 AUTHOR	E. Bertin (IAP)
-VERSION	15/01/2013
+VERSION	19/10/2026
  ***/
 int	profit_minimize(profitstruct *profit, int niter)
   {
    double	lm_opts[5], info[LM_INFO_SZ],
-		dcovar[PARAM_NPARAM*PARAM_NPARAM], dparam[PARAM_NPARAM];
-   int		nfree;
+		dcovar[PARAM_NPARAM*PARAM_NPARAM], dparam[PARAM_NPARAM],
+		g[4];
+   int		c, nfree, nrender, p;
 
   profit->iter = 0;
   memset(dcovar, 0, profit->nparam*profit->nparam*sizeof(double));
@@ -1583,7 +2321,23 @@ int	profit_minimize(profitstruct *profit, int niter)
   nfree = profit_boundtounbound(profit, profit->paraminit, dparam,
 				PARAM_ALLPARAMS);
 
-  niter = dlevmar_dif(profit_evaluate, dparam, NULL, nfree,
+/* Count the derivatives that require rebuilding model components */
+  nrender = 0;
+  for (p=0; p<profit->nparam; p++)
+    if (profit->parfittype[p]!=PARFIT_FIXED)
+      for (c=0; c<profit->nprof; c++)
+        if (prof_dep(profit->prof[c], &profit->param[p], g)==PROF_DEPRENDER)
+          {
+          nrender++;
+          break;
+          }
+
+  if (nrender > PROFIT_MAXJACRENDER)
+    niter = dlevmar_dif(profit_evaluate, dparam, NULL, nfree,
+			profit->nresi + profit->npresi,
+			niter, lm_opts, info, NULL, dcovar, profit);
+  else
+    niter = dlevmar_der(profit_evaluate, profit_jacobian, dparam, NULL, nfree,
 			profit->nresi + profit->npresi,
 			niter, lm_opts, info, NULL, dcovar, profit);
 
@@ -1653,186 +2407,580 @@ INPUT	Pointer to the vector of parameters,
 	number of data points,
 	pointer to a data structure (we use it for the profit structure here).
 OUTPUT	-.
-NOTES	-.
+NOTES	Derivatives are provided separately by profit_jacobian().
 AUTHOR	E. Bertin (IAP)
-VERSION	16/01/2013
+VERSION	19/10/2026
  ***/
 void	profit_evaluate(double *dpar, double *fvec, int m, int n, void *adata)
   {
    profitstruct		*profit;
-   profstruct		**prof;
-   double		*dpar0, *dresi, *fvect;
-   float		*modpixt, *profpixt, *resi,
-			tparam, val;
+   double		*fvect;
+   int			p;
+
+  profit = (profitstruct *)adata;
+
+  for (p=0; p<m; p++)
+    profit->dparam[p] = dpar[p];
+  profit_unboundtobound(profit, dpar, profit->param, PARAM_ALLPARAMS);
+
+  profit_residuals(profit, the_field, the_wfield, PROFIT_DYNPARAM,
+	profit->param, profit->resi);
+
+  profit_presiduals(profit, dpar, profit->presi);
+
+  fvect = fvec;
+  for (p=0; p<profit->nresi; p++)
+    *(fvect++) = profit->resi[p];
+  for (p=0; p<profit->npresi; p++)
+    *(fvect++) = profit->presi[p];
+
+//  profit_printout(m, par, n, fvec, adata, 0, -1, 0 );
+  profit->iter++;
+
+  return;
+  }
+
+
+/****** profit_jacobian ******************************************************
+PROTO	void profit_jacobian(double *par, double *jac, int m, int n,
+			void *adata)
+PURPOSE	Provide a function returning the Jacobian of residuals to levmar.
+INPUT	Pointer to the vector of parameters,
+	pointer to the n x m Jacobian matrix (output),
+	number of model parameters,
+	number of data points,
+	pointer to a data structure (we use it for the profit structure here).
+OUTPUT	-.
+NOTES	Derivative images are convolved in one batched FFT pass (see
+	prof_dep()). Those of Sersic, de Vaucouleurs and exponential
+	components with respect to flux, scale, aspect ratio and position
+	angle are derived analytically from the component models at the last
+	profit_evaluate() call: with C the profile CD matrix, the convolved
+	derivative of a component P is tr(G).K*P + sum_ij G_ij (x_j d_i(K*P)
+	- d_i(u_j.K*P)), where G = C^-1.dC/dparam, (x_1,x_2) are model
+	coordinates and (u_1,u_2) kernel coordinates. The truncation of the
+	profiles at the model boundary is neglected. Other shape parameters
+	require rebuilding the components that depend on them, and their
+	derivatives are computed from forward differences. Shifts require no
+	convolution. Chain rules through the unbound->bound transform and the
+	dynamic compression of residuals are applied analytically.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	profit_jacobian(double *dpar, double *jac, int m, int n, void *adata)
+  {
+   profitstruct		*profit;
+   profstruct		**prof, *profc;
+   double		g[4],
+			*jact,
+			dparam, dstep, invdstep, dxdy, back, fac;
+   float		*mpix,*fmpix,*fjpix, *dpixt,*pixt,*gpix1t,*gpix2t,
+			*ptr,
+			tparam, val, fluxfac, lostfluxfrac, x1,x2;
    PIXTYPE		*lmodpixt,*lmodpix2t, *objpix,*weight,
 			wval;
-   int			c,f,i,p,q, fd,pd, jflag,sflag, nprof;
+   int			findex[PROFIT_MAXPROF], gindex[PROFIT_MAXPROF],
+			dindex[PARAM_NPARAM], jindex[PARAM_NPARAM],
+			c,f,i,p, x,y, nprof, npix,npix2, nfor,njac, code,
+			dirac_flag, render_flag;
 
   profit = (profitstruct *)adata;
+  prof = profit->prof;
+  nprof = profit->nprof;
+  npix = profit->nmodpix;
+  npix2 = (profit->modnaxisn[0]/2 + 1)*profit->modnaxisn[1];
+  dirac_flag = (nprof==1 && prof[0]->code == MODEL_DIRAC);
 
-/* Detect "Jacobian-related" calls */
-  jflag = pd = fd = 0;
-  dpar0 = profit->dparam;
-  if (profit->iter)
+/* Make sure the current model matches the input parameters */
+  for (f=0; f<m; f++)
+    if (dpar[f] != profit->dparam[f])
+      break;
+  if (f<m)
     {
-    f = q = 0;
+    for (f=0; f<m; f++)
+      profit->dparam[f] = dpar[f];
+    profit_unboundtobound(profit, dpar, profit->param, PARAM_ALLPARAMS);
+    profit_residuals(profit, the_field, the_wfield, PROFIT_DYNPARAM,
+	profit->param, profit->resi);
+    }
+
+  memset(jac, 0, (size_t)n*m*sizeof(double));
+  mpix = fmpix = fjpix = NULL;
+
+/* Assign slots in the batched FFTs: component models and unconvolved */
+/* derivatives forward; derivatives and component gradients backward */
+  for (c=0; c<nprof; c++)
+    findex[c] = gindex[c] = -1;
+  nfor = njac = 0;
+  for (p=0; p<profit->nparam; p++)
+    {
+    dindex[p] = jindex[p] = -1;
+    code = profit->paramrevindex[p];
+    if (dirac_flag || profit->parfittype[p] == PARFIT_FIXED
+	|| code == PARAM_X || code == PARAM_Y)
+      continue;
+    jindex[p] = njac++;
+    for (c=0; c<nprof; c++)
+      switch(prof_dep(prof[c], &profit->param[p], g))
+        {
+        case PROF_DEPGEOM:
+          gindex[c] = 0;
+        case PROF_DEPFLUX:
+          findex[c] = 0;
+          break;
+        case PROF_DEPPIX:
+        case PROF_DEPRENDER:
+          dindex[p] = 0;
+          break;
+        default:
+          break;
+        }
+    }
+
+  if (njac)
+    {
+    if (!profit->psfdft)
+      profit_makedft(profit);
+    for (c=0; c<nprof; c++)
+      if (findex[c]>=0)
+        findex[c] = nfor++;
+    for (p=0; p<profit->nparam; p++)
+      if (dindex[p]>=0)
+        dindex[p] = nfor++;
+    for (c=0; c<nprof; c++)
+      if (gindex[c]>=0)
+        {
+        gindex[c] = njac;
+        njac += 2;
+        }
+    QFFTWF_MALLOC(mpix, float, (size_t)(nfor>njac? nfor:njac)*npix);
+    QFFTWF_MALLOC(fmpix, float, (size_t)2*(nfor? nfor:1)*npix2);
+    QFFTWF_MALLOC(fjpix, float, (size_t)2*njac*npix2);
+    for (c=0; c<nprof; c++)
+      if (findex[c]>=0)
+        memcpy(mpix + findex[c]*npix, prof[c]->pix, npix*sizeof(float));
+/*-- Unconvolved derivatives of the other components */
+    f = 0;
     for (p=0; p<profit->nparam; p++)
       {
-      if (dpar[f] - dpar0[f] != 0.0)
+      if (profit->parfittype[p] == PARFIT_FIXED)
+        continue;
+      if (dindex[p]<0)
         {
-        pd = p;
-        fd = f;
-        q++;
-        }
-      if (profit->parfittype[p]!=PARFIT_FIXED)
         f++;
+        continue;
+        }
+      ptr = &profit->param[p];
+      dpixt = mpix + dindex[p]*npix;
+      memset(dpixt, 0, npix*sizeof(float));
+      dxdy = profit_dunboundtobound(profit, p);
+      render_flag = 0;
+      for (c=0; c<nprof; c++)
+        switch(prof_dep(prof[c], ptr, g))
+          {
+          case PROF_DEPPIX:
+            pixt = prof[c]->pix;
+            for (i=0; i<npix; i++)
+              dpixt[i] += dxdy**(pixt++);
+            break;
+          case PROF_DEPRENDER:
+            render_flag = 1;
+            break;
+          default:
+            break;
+          }
+      if (render_flag)
+        {
+/*------ Perturb the current parameter in unbounded space */
+        dstep = 1e-4*fabs(dpar[f]);
+        if (dstep<1e-4)
+          dstep = 1e-4;
+        dparam = dpar[f] + dstep;
+        tparam = profit->param[p];
+        profit_unboundtobound(profit, &dparam, ptr, p);
+        memset(profit->modpix, 0, npix*sizeof(float));
+        for (c=0; c<nprof; c++)
+          {
+          profc = prof[c];
+          if (prof_dep(profc, ptr, g) != PROF_DEPRENDER)
+            continue;
+          pixt = profc->pix;
+          val = *profc->flux;
+          for (i=0; i<npix; i++)
+            profit->modpix[i] -= val**(pixt++);
+          memcpy(profit->modpix2, profc->pix, npix*sizeof(float));
+          fluxfac = profc->fluxfac;
+          lostfluxfrac = profc->lostfluxfrac;
+          prof_add(profit, profc, 0);
+          memcpy(profc->pix, profit->modpix2, npix*sizeof(float));
+          profc->fluxfac = fluxfac;
+          profc->lostfluxfrac = lostfluxfrac;
+          }
+        profit->param[p] = tparam;
+        invdstep = 1.0/dstep;
+        pixt = profit->modpix;
+        for (i=0; i<npix; i++)
+          dpixt[i] += invdstep**(pixt++);
+        }
+      f++;
       }
-    if (f>0 && q==1)
-      jflag = 1;
-    }
-jflag = 0;	/* Temporarily deactivated (until problems are fixed) */
-  if (jflag && !(profit->nprof==1 && profit->prof[0]->code == MODEL_DIRAC))
-    {
-    prof = profit->prof;
-    nprof = profit->nprof;
-
-/*-- "Jacobian call" */
-    tparam = profit->param[pd];
-    profit_unboundtobound(profit, &dpar[fd], &profit->param[pd], pd);
-    sflag = 1;
-    switch(profit->paramrevindex[pd])
+    if (nfor)
+      fft_rtfmany(mpix, fmpix, nfor, profit->modnaxisn);
+/*-- Derivative spectra */
+    for (p=0; p<profit->nparam; p++)
       {
-      case PARAM_BACK:
-        lmodpixt = profit->lmodpix;
-        lmodpix2t = profit->lmodpix2;
-        val = (profit->param[pd] - tparam);
-        for (i=profit->nobjpix;i--;)
-          *(lmodpix2t++) = val;
-        break;
-      case PARAM_X:
-      case PARAM_Y:
-        profit_resample(profit, profit->cmodpix, profit->lmodpix2, 1.0);
-        lmodpixt = profit->lmodpix;
-        lmodpix2t = profit->lmodpix2;
-        for (i=profit->nobjpix;i--;)
-          *(lmodpix2t++) -= *(lmodpixt++);
-        break;
-      case PARAM_DIRAC_FLUX:
-      case PARAM_SPHEROID_FLUX:
-      case PARAM_DISK_FLUX:
-      case PARAM_ARMS_FLUX:
-      case PARAM_BAR_FLUX:
-        if (nprof==1 && tparam != 0.0)
+      if (jindex[p]<0)
+        continue;
+      ptr = &profit->param[p];
+      dpixt = fjpix + 2*jindex[p]*npix2;
+      memset(dpixt, 0, 2*npix2*sizeof(float));
+      dxdy = profit_dunboundtobound(profit, p);
+      for (c=0; c<nprof; c++)
+        switch(prof_dep(prof[c], ptr, g))
           {
-          lmodpixt = profit->lmodpix;
-          lmodpix2t = profit->lmodpix2;
-          val = (profit->param[pd] - tparam) / tparam;
-          for (i=profit->nobjpix;i--;)
-            *(lmodpix2t++) = val**(lmodpixt++);
+          case PROF_DEPFLUX:
+            prof_jacspec(dpixt, fmpix + 2*findex[c]*npix2, profit->psfdft,
+		NULL, dxdy, profit->modnaxisn);
+            break;
+          case PROF_DEPGEOM:
+            prof_jacspec(dpixt, fmpix + 2*findex[c]*npix2, profit->psfdft,
+		g, dxdy**prof[c]->flux, profit->modnaxisn);
+            break;
+          default:
+            break;
           }
-        else
+      if (dindex[p]>=0)
+        prof_jacspec(dpixt, fmpix + 2*dindex[p]*npix2, profit->psfdft,
+		NULL, 1.0, profit->modnaxisn);
+      }
+    for (c=0; c<nprof; c++)
+      if (gindex[c]>=0)
+        prof_jacgrad(fjpix + 2*gindex[c]*npix2, fmpix + 2*findex[c]*npix2,
+		profit->psfdft, profit->modnaxisn);
+    fft_ftrmany(fjpix, mpix, njac, profit->modnaxisn);
+    }
+
+  f = 0;
+  for (p=0; p<profit->nparam; p++)
+    {
+    if (profit->parfittype[p] == PARFIT_FIXED)
+      continue;
+    code = profit->paramrevindex[p];
+    if (jindex[p]<0)
+      {
+/*---- Perturb the current parameter in unbounded space */
+      dstep = 1e-4*fabs(dpar[f]);
+      if (dstep<1e-4)
+        dstep = 1e-4;
+      dparam = dpar[f] + dstep;
+      tparam = profit->param[p];
+      profit_unboundtobound(profit, &dparam, &profit->param[p], p);
+      if (dirac_flag)
+        {
+/*------ Simple PSF shortcut */
+        if (profit_resample(profit, profit->psfpix, profit->lmodpix2,
+		*prof[0]->flux) == RETURN_ERROR)
+          memcpy(profit->lmodpix2, profit->lmodpix,
+		profit->nobjpix*sizeof(PIXTYPE));
+        }
+/*---- Shifts only affect resampling */
+      else if (profit_resample(profit, profit->cmodpix, profit->lmodpix2, 1.0)
+		== RETURN_ERROR)
+        memcpy(profit->lmodpix2, profit->lmodpix,
+		profit->nobjpix*sizeof(PIXTYPE));
+      profit->param[p] = tparam;
+      lmodpixt = profit->lmodpix;
+      lmodpix2t = profit->lmodpix2;
+      for (i=profit->nobjpix;i--;)
+        *(lmodpix2t++) -= *(lmodpixt++);
+      invdstep = 1.0/dstep;
+      }
+    else
+      {
+/*---- Normalize the convolved derivative and add the real-space terms */
+      ptr = &profit->param[p];
+      dxdy = profit_dunboundtobound(profit, p);
+      fac = 1.0/npix;
+      back = 0.0;
+      for (c=0; c<nprof; c++)
+        if (prof_dep(prof[c], ptr, g) == PROF_DEPBACK)
+          back += (*prof[c]->flux<0.0? -dxdy : dxdy)*profit->psfdft[0];
+      dpixt = mpix + jindex[p]*npix;
+      pixt = profit->modpix;
+      for (i=npix; i--;)
+        *(pixt++) = fac**(dpixt++) + back;
+      for (c=0; c<nprof; c++)
+        {
+        if (prof_dep(prof[c], ptr, g) != PROF_DEPGEOM)
+          continue;
+        val = fac*dxdy**prof[c]->flux;
+        for (i=0; i<4; i++)
+          g[i] *= val;
+        gpix1t = mpix + gindex[c]*npix;
+        gpix2t = gpix1t + npix;
+        pixt = profit->modpix;
+        for (y=0; y<profit->modnaxisn[1]; y++)
           {
-          for (c=0; c<nprof; c++)
-            if (prof[c]->flux == &profit->param[pd])
-              break;
-          memcpy(profit->modpix, prof[c]->pix, profit->nmodpix*sizeof(float));
-          profit_convolve(profit, profit->modpix);
-          profit_resample(profit, profit->modpix, profit->lmodpix2,
-		profit->param[pd] - tparam);
+          x2 = (float)(y - profit->modnaxisn[1]/2);
+          x1 = (float)(-(profit->modnaxisn[0]/2));
+          for (x=profit->modnaxisn[0]; x--; x1+=1.0)
+            *(pixt++) += (g[0]*x1 + g[1]*x2)**(gpix1t++)
+			+ (g[2]*x1 + g[3]*x2)**(gpix2t++);
           }
-        break;
-      case PARAM_SPHEROID_REFF:
-      case PARAM_SPHEROID_ASPECT:
-      case PARAM_SPHEROID_POSANG:
-      case PARAM_SPHEROID_SERSICN:
-        sflag = 0;			/* We are in the same switch */
-        for (c=0; c<nprof; c++)
-          if (prof[c]->code == MODEL_SERSIC
-		|| prof[c]->code == MODEL_DEVAUCOULEURS)
-            break; 
-      case PARAM_DISK_SCALE:
-      case PARAM_DISK_ASPECT:
-      case PARAM_DISK_POSANG:
-        if (sflag)
-          for (c=0; c<nprof; c++)
-            if (prof[c]->code == MODEL_EXPONENTIAL)
-              break; 
-        sflag = 0;
-      case PARAM_ARMS_QUADFRAC:
-      case PARAM_ARMS_SCALE:
-      case PARAM_ARMS_START:
-      case PARAM_ARMS_POSANG:
-      case PARAM_ARMS_PITCH:
-      case PARAM_ARMS_PITCHVAR:
-      case PARAM_ARMS_WIDTH:
-        if (sflag)
-          for (c=0; c<nprof; c++)
-            if (prof[c]->code == MODEL_ARMS)
-              break; 
-        sflag = 0;
-      case PARAM_BAR_ASPECT:
-      case PARAM_BAR_POSANG:
-        if (sflag)
-          for (c=0; c<nprof; c++)
-            if (prof[c]->code == MODEL_ARMS)
-              break; 
-        modpixt = profit->modpix;
-        profpixt = prof[c]->pix;
-        val = -*prof[c]->flux;
-        for (i=profit->nmodpix;i--;)
-          *(modpixt++) = val**(profpixt++);
-        memcpy(profit->modpix2, prof[c]->pix, profit->nmodpix*sizeof(float));
-        prof_add(profit, prof[c], 0);
-        memcpy(prof[c]->pix, profit->modpix2, profit->nmodpix*sizeof(float));
-        profit_convolve(profit, profit->modpix);
-        profit_resample(profit, profit->modpix, profit->lmodpix2, 1.0);
-        break;
-      default:
-        error(EXIT_FAILURE, "*Internal Error*: ",
-			"unknown parameter index in profit_jacobian()");
-        break;
+        }
+      if (profit_resample(profit, profit->modpix, profit->lmodpix2, 1.0)
+		== RETURN_ERROR)
+        memset(profit->lmodpix2, 0, profit->nobjpix*sizeof(PIXTYPE));
+      invdstep = 1.0;
       }
+
+/*-- Apply the derivative of the dynamic compression of residuals */
     objpix = profit->objpix;
     weight = profit->objweight;
     lmodpixt = profit->lmodpix;
     lmodpix2t = profit->lmodpix2;
-    resi = profit->resi;
-    dresi = fvec;
+    jact = jac + f;
     if (PROFIT_DYNPARAM > 0.0)
       for (i=profit->nobjpix;i--; lmodpixt++, lmodpix2t++)
         {
         val = *(objpix++);
         if ((wval=*(weight++))>0.0)
-          *(dresi++) = *(resi++) + *lmodpix2t
+          {
+          *jact = *lmodpix2t*invdstep
 		* wval/(1.0+wval*fabs(*lmodpixt - val)/PROFIT_DYNPARAM);
+          jact += m;
+          }
         }
     else
       for (i=profit->nobjpix;i--; lmodpix2t++)
         if ((wval=*(weight++))>0.0)
-          *(dresi++) = *(resi++) + *lmodpix2t * wval;
+          {
+          *jact = *lmodpix2t*invdstep*wval;
+          jact += m;
+          }
+    f++;
     }
-  else
+
+  if (njac)
     {
-/*-- "Regular call" */
-    for (p=0; p<profit->nparam; p++)
-      dpar0[p] = dpar[p];
-    profit_unboundtobound(profit, dpar, profit->param, PARAM_ALLPARAMS);
+    QFFTWF_FREE(mpix);
+    QFFTWF_FREE(fmpix);
+    QFFTWF_FREE(fjpix);
+    }
 
-    profit_residuals(profit, the_field, the_wfield, PROFIT_DYNPARAM,
-	profit->param, profit->resi);
+/* Prior "residuals" (see profit_presiduals()) */
+  jact = jac + profit->nresi*m;
+  for (p=0; p<profit->nparam; p++)
+    if (profit->dparampsig[p]>0.0)
+      {
+      if (p<m)
+        jact[p] = 1.0/profit->dparampsig[p];
+      jact += m;
+      }
+
+  return;
+  }
+
+
+/****** profit_dunboundtobound ************************************************
+PROTO	double profit_dunboundtobound(profitstruct *profit, int p)
+PURPOSE	Return the derivative of a parameter with respect to its unbounded
+	counterpart.
+INPUT	Pointer to the profit structure,
+	parameter index.
+OUTPUT	Derivative at the current parameter value.
+NOTES	See profit_unboundtobound() and profit_covarunboundtobound().
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static double	profit_dunboundtobound(profitstruct *profit, int p)
+  {
+   double	x, xmin, xmax;
+
+  x = profit->param[p];
+  xmin = profit->parammin[p];
+  xmax = profit->parammax[p];
+  switch(profit->parfittype[p])
+    {
+    case PARFIT_UNBOUND:
+      return xmax;
+    case PARFIT_LINBOUND:
+      return (x - xmin)*(xmax - x)/(xmax - xmin);
+    case PARFIT_LOGBOUND:
+      return x*log(x/xmin)*log(xmax/x)/log(xmax/xmin);
+    default:
+      return 0.0;
+    }
+  }
 
-    profit_presiduals(profit, dpar, profit->presi);
 
-    fvect = fvec;
-    for (p=0; p<profit->nresi; p++)
-      *(fvect++) = profit->resi[p];
-    for (p=0; p<profit->npresi; p++)
-      *(fvect++) = profit->presi[p];
+/****** prof_dep **************************************************************
+PROTO	profdepenum prof_dep(profstruct *prof, float *param, double *g)
+PURPOSE	Tell how a model component depends on a given parameter.
+INPUT	Pointer to the profile structure,
+	pointer to the parameter,
+	pointer to the 2x2 matrix G = C^-1.dC/dparam, C being the profile CD
+	matrix (output, only set for PROF_DEPGEOM).
+OUTPUT	PROF_DEPNONE (no dependency), PROF_DEPBACK (background level),
+	PROF_DEPFLUX (flux of a Sersic, de Vaucouleurs or exponential
+	component), PROF_DEPPIX (flux of another component), PROF_DEPGEOM
+	(scale, aspect ratio or position angle of a Sersic, de Vaucouleurs or
+	exponential component) or PROF_DEPRENDER (any other shape parameter).
+NOTES	G is in row-major order, rows for derivatives along model axes.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static profdepenum	prof_dep(profstruct *prof, float *param, double *g)
+  {
+   double	ctheta,stheta, fac;
+   int		k;
+
+  if (prof->flux==param)
+    return prof->code==MODEL_BACK? PROF_DEPBACK :
+		((prof->code==MODEL_SERSIC || prof->code==MODEL_DEVAUCOULEURS
+		|| prof->code==MODEL_EXPONENTIAL)? PROF_DEPFLUX : PROF_DEPPIX);
 
+  if (prof->code==MODEL_SERSIC || prof->code==MODEL_DEVAUCOULEURS
+	|| prof->code==MODEL_EXPONENTIAL)
+    {
+    if (prof->scale==param)
+      {
+      g[0] = g[3] = (*param!=0.0)? -1.0/ *param : 0.0;
+      g[1] = g[2] = 0.0;
+      return PROF_DEPGEOM;
+      }
+    else if (prof->aspect==param)
+      {
+      ctheta = cos(*prof->posangle*DEG);
+      stheta = sin(*prof->posangle*DEG);
+      fac = (*param!=0.0)? 1.0 / *param : 0.0;
+      g[0] = -fac*stheta*stheta;
+      g[1] = g[2] = fac*stheta*ctheta;
+      g[3] = -fac*ctheta*ctheta;
+      return PROF_DEPGEOM;
+      }
+    else if (prof->posangle==param)
+      {
+      g[0] = g[3] = 0.0;
+      g[1] = DEG;
+      g[2] = -DEG;
+      return PROF_DEPGEOM;
+      }
     }
 
-//  profit_printout(m, par, n, fvec, adata, 0, -1, 0 );
-  profit->iter++;
+  if (prof->scale==param || prof->aspect==param || prof->posangle==param
+	|| prof->featfrac==param || prof->featscale==param
+	|| prof->featstart==param || prof->featposang==param
+	|| prof->featpitch==param || prof->featpitchvar==param
+	|| prof->featwidth==param || prof->feataspect==param)
+    return PROF_DEPRENDER;
+  for (k=0; k<PROFIT_MAXEXTRA; k++)
+    if (prof->extra[k]==param)
+      return PROF_DEPRENDER;
+
+  return PROF_DEPNONE;
+  }
+
+
+/****** prof_jacspec **********************************************************
+PROTO	void prof_jacspec(float *fdata, float *fmod, float *psfdft, double *g,
+			double w, int *size)
+PURPOSE	Add the Fourier transform of the convolved derivative of a component
+	to that of a derivative image.
+INPUT	Pointer to the compressed Fourier transform to be updated,
+	pointer to the compressed Fourier transform of the component,
+	pointer to the PSF Fourier transforms (see profit_makedft()),
+	pointer to the G matrix (see prof_dep()), or NULL for a plain
+	convolution,
+	multiplicative factor,
+	image size vector.
+OUTPUT	-.
+NOTES	The x_j d_i(K*P) terms are added in real space by profit_jacobian().
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	prof_jacspec(float *fdata, float *fmod, float *psfdft,
+			double *g, double w, int *size)
+  {
+   double	kx,ky, dkx,dky, trg, k1,k2, qr,qi;
+   float	*fu1,*fu2;
+   int		ix,iy, nx, npix2;
+
+  nx = size[0]/2 + 1;
+  npix2 = nx*size[1];
+  if (!g)
+    {
+    for (ix=npix2; ix--; fdata+=2, fmod+=2, psfdft+=2)
+      {
+      fdata[0] += w*(psfdft[0]*fmod[0] - psfdft[1]*fmod[1]);
+      fdata[1] += w*(psfdft[0]*fmod[1] + psfdft[1]*fmod[0]);
+      }
+    return;
+    }
+
+  fu1 = psfdft + 2*npix2;
+  fu2 = psfdft + 4*npix2;
+  trg = g[0] + g[3];
+  dkx = 2.0*PI/size[0];
+  dky = 2.0*PI/size[1];
+  for (iy=0; iy<size[1]; iy++)
+    {
+/*-- Nyquist frequencies have no derivative */
+    ky = (2*iy<size[1])? iy*dky : ((2*iy==size[1])? 0.0 : (iy-size[1])*dky);
+    for (ix=0; ix<nx; ix++, fdata+=2, fmod+=2, psfdft+=2, fu1+=2, fu2+=2)
+      {
+      kx = (2*ix==size[0])? 0.0 : ix*dkx;
+/*---- Q = tr(G).FK - i.sum_ij G_ij k_i FU_j */
+      k1 = g[0]*kx + g[2]*ky;
+      k2 = g[1]*kx + g[3]*ky;
+      qr = trg*psfdft[0] + k1*fu1[1] + k2*fu2[1];
+      qi = trg*psfdft[1] - k1*fu1[0] - k2*fu2[0];
+      fdata[0] += w*(qr*fmod[0] - qi*fmod[1]);
+      fdata[1] += w*(qr*fmod[1] + qi*fmod[0]);
+      }
+    }
+
+  return;
+  }
+
+
+/****** prof_jacgrad **********************************************************
+PROTO	void prof_jacgrad(float *fdata, float *fmod, float *psfdft, int *size)
+PURPOSE	Compute the Fourier transforms of the gradient of a convolved
+	component.
+INPUT	Pointer to the two contiguous compressed Fourier transforms (output),
+	pointer to the compressed Fourier transform of the component,
+	pointer to the PSF Fourier transform,
+	image size vector.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	prof_jacgrad(float *fdata, float *fmod, float *psfdft, int *size)
+  {
+   double	kx,ky, dkx,dky, pr,pi;
+   float	*fdata2;
+   int		ix,iy, nx;
+
+  nx = size[0]/2 + 1;
+  fdata2 = fdata + 2*nx*size[1];
+  dkx = 2.0*PI/size[0];
+  dky = 2.0*PI/size[1];
+  for (iy=0; iy<size[1]; iy++)
+    {
+    ky = (2*iy<size[1])? iy*dky : ((2*iy==size[1])? 0.0 : (iy-size[1])*dky);
+    for (ix=0; ix<nx; ix++, fdata+=2, fdata2+=2, fmod+=2, psfdft+=2)
+      {
+      kx = (2*ix==size[0])? 0.0 : ix*dkx;
+      pr = psfdft[0]*fmod[0] - psfdft[1]*fmod[1];
+      pi = psfdft[0]*fmod[1] + psfdft[1]*fmod[0];
+      fdata[0] = -kx*pi;
+      fdata[1] = kx*pr;
+      fdata2[0] = -ky*pi;
+      fdata2[1] = ky*pr;
+      }
+    }
 
   return;
   }
@@ -1986,9 +3134,10 @@ INPUT	Profile-fitting structure,
 	pointer to output raster,
 	multiplicating factor.
 OUTPUT	RETURN_ERROR if the rasters don't overlap, RETURN_OK otherwise.
-NOTES	-.
+NOTES	Without differential geometry maps, the resampling is separable and
+	done in two passes with vignet_resamplex() and vignet_resampley().
 AUTHOR	E. Bertin (IAP)
-VERSION	17/02/2015
+VERSION	19/10/2026
  ***/
 int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
 	float factor)
@@ -1996,13 +3145,12 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
    interpenum	interptype;
    PIXTYPE	*pixout,*pixout0;
    float	kernel[INTERP_MAXKERNELWIDTH], pos[2],
-		*kernelt, *pixin,*pixin0, *mask,*maskt, *pixinout,
-		*dpixin,*dpixin0, *dpixout,*dpixout0, *dx,*dy,
+		*kernelt, *mask,*maskt, *pixinout, *dx,*dy,
 		*dgeoxpix0,*dgeoypix0, *dgeoxpix,*dgeoypix,
-		xcin,xcout,ycin,ycout, xsin,ysin, xin,yin, x,y, val,
+		xcin,xcout,ycin,ycout, xsin,ysin, xin,yin,
 		invpixstep;
    int		*start,*startt, *nmask,*nmaskt, *modnaxisn,
-		i,j,k,n,t,w,
+		i,j,n,t,w,
 		ixsout,iysout, ixout,iyout, dixout,diyout, nxout,nyout,
 		iysina, nyin, hmw,hmh, ix,iy, ixin,iyin, interpw, offout;
 
@@ -2115,7 +3263,7 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
   ysin -= (float)iysina;
 
 /* Allocate interpolant stuff for the x direction */
-  QMALLOC(mask, float, nxout*interpw);	/* Interpolation masks */
+  QCALLOC(mask, float, nxout*INTERPW);	/* Interpolation masks */
   QMALLOC(nmask, int, nxout);		/* Interpolation mask sizes */
   QMALLOC(start, int, nxout);		/* Int. part of Input conv starts */
 
@@ -2125,7 +3273,7 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
   maskt = mask;
   nmaskt = nmask;
   startt = start;
-  for (j=nxout; j--; xin+=invpixstep)
+  for (j=nxout; j--; xin+=invpixstep, maskt+=INTERPW)
     {
     ix = (ixin=(int)xin) - hmw;
     make_kernel(xin - ixin, kernel, interptype);
@@ -2133,8 +3281,8 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
     if (ix < 0)
       {
       n = interpw + ix;
-      ix = 0;
       kernelt -= ix;
+      ix = 0;
       }
     else
       n = interpw;
@@ -2142,33 +3290,18 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
       n=t;
     *(startt++) = ix;
     *(nmaskt++) = n;
-    for (i=n; i--;)
-      *(maskt++) = *(kernelt++);
+    for (i=0; i<n; i++)
+      maskt[i] = *(kernelt++);
     }
 
   QCALLOC(pixinout, float, nxout*nyin);	/* Intermediary frame-buffer */
 
-/* Make the interpolation in x (this includes transposition) */
-  pixin0 = inpix + iysina*modnaxisn[0];
-  dpixout0 = pixinout;
-  for (k=nyin; k--; pixin0+=modnaxisn[0], dpixout0++)
-    {
-    maskt = mask;
-    nmaskt = nmask;
-    startt = start;
-    dpixout = dpixout0;
-    for (j=nxout; j--; dpixout+=nyin)
-      {
-      pixin = pixin0+*(startt++);
-      val = 0.0; 
-      for (i=*(nmaskt++); i--;)
-        val += *(maskt++)**(pixin++);
-      *dpixout = val;
-      }
-    }
+/* Make the interpolation in x */
+  vignet_resamplex(inpix + iysina*modnaxisn[0], modnaxisn[0], nyin, pixinout,
+	nxout, mask, nmask, start);
 
 /* Reallocate interpolant stuff for the y direction */
-  QREALLOC(mask, float, nyout*interpw);	/* Interpolation masks */
+  QREALLOC(mask, float, nyout*INTERPW);	/* Interpolation masks */
   QREALLOC(nmask, int, nyout);			/* Interpolation mask sizes */
   QREALLOC(start, int, nyout);		/* Int. part of Input conv starts */
 
@@ -2178,7 +3311,7 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
   maskt = mask;
   nmaskt = nmask;
   startt = start;
-  for (j=nyout; j--; yin+=invpixstep)
+  for (j=nyout; j--; yin+=invpixstep, maskt+=INTERPW)
     {
     iy = (iyin=(int)yin) - hmh;
     make_kernel(yin - iyin, kernel, interptype);
@@ -2195,28 +3328,13 @@ int	profit_resample(profitstruct *profit, float *inpix, PIXTYPE *outpix,
       n=t;
     *(startt++) = iy;
     *(nmaskt++) = n;
-    for (i=n; i--;)
-      *(maskt++) = *(kernelt++);
+    for (i=0; i<n; i++)
+      maskt[i] = *(kernelt++);
     }
 
-/* Make the interpolation in y and transpose once again */
-  dpixin0 = pixinout;
-  pixout0 = outpix+ixsout+iysout*w;
-  for (k=nxout; k--; dpixin0+=nyin, pixout0++)
-    {
-    maskt = mask;
-    nmaskt = nmask;
-    startt = start;
-    pixout = pixout0;
-    for (j=nyout; j--; pixout+=w)
-      {
-      dpixin = dpixin0+*(startt++);
-      val = 0.0; 
-      for (i=*(nmaskt++); i--;)
-        val += *(maskt++)**(dpixin++);
-       *pixout = (PIXTYPE)(factor*val);
-      }
-    }
+/* Make the interpolation in y */
+  vignet_resampley(pixinout, nxout, outpix+ixsout+iysout*w, w, nyout,
+	mask, nmask, start, factor);
 
 /* Free memory */
   free(pixinout);
@@ -2254,16 +3372,18 @@ PROTO	void profit_makedft(profitstruct *profit)
 PURPOSE	Create the Fourier transform of the descrambled PSF component.
 INPUT	Pointer to the profit structure.
 OUTPUT	-.
-NOTES	-.
+NOTES	The transforms of the PSF K and of u1*K and u2*K, where (u1,u2) are
+	the kernel coordinates, are stored contiguously in profit->psfdft.
+	The latter two are used by profit_jacobian().
 AUTHOR	E. Bertin (IAP)
-VERSION	22/04/2008
+VERSION	19/10/2026
  ***/
 void	profit_makedft(profitstruct *profit)
   {
    psfstruct	*psf;
-   float      *mask,*maskt, *ppix;
+   float      *mask,*maskt,*umaskt,*vmaskt, *ppix, *fdata;
    float       dx,dy, r,r2,rmin,rmin2,rmax,rmax2,rsig,invrsig2;
-   int          width,height,npix,offset, psfwidth,psfheight,psfnpix,
+   int          width,height,npix,npix2,offset, psfwidth,psfheight,psfnpix,
                 cpwidth, cpheight,hcpwidth,hcpheight, i,j,x,y;
 
   if (!(psf=profit->psf))
@@ -2275,7 +3395,7 @@ void	profit_makedft(profitstruct *profit)
   width = profit->modnaxisn[0];
   height = profit->modnaxisn[1];
   npix = width*height;
-  QCALLOC(mask, float, npix);
+  QCALLOC(mask, float, 3*npix);
   cpwidth = (width>psfwidth)?psfwidth:width;
   hcpwidth = cpwidth>>1;
   cpwidth = hcpwidth<<1;
@@ -2354,8 +3474,29 @@ void	profit_makedft(profitstruct *profit)
         *maskt *= (r2>rmax2)?0.0:expf((2*rmin*sqrtf(r2)-r2-rmin2)*invrsig2);
     }
 
+/* Moment-weighted kernels u1*K and u2*K, for profit_jacobian() */
+  maskt = mask;
+  umaskt = mask + npix;
+  vmaskt = mask + 2*npix;
+  for (y=0; y<height; y++)
+    {
+    dy = (y < height/2)? (float)y : (float)(y - height);
+    for (x=0; x<width; x++, maskt++)
+      {
+      *(umaskt++) = ((x < width/2)? (float)x : (float)(x - width))**maskt;
+      *(vmaskt++) = dy**maskt;
+      }
+    }
+
 /* Finally move to Fourier space */
-  profit->psfdft = fft_rtf(mask, profit->modnaxisn);
+  npix2 = ((width/2) + 1) * height;
+  QFFTWF_MALLOC(profit->psfdft, float, 6*npix2);
+  for (i=0; i<3; i++)
+    {
+    fdata = fft_rtf(mask + i*npix, profit->modnaxisn);
+    memcpy(profit->psfdft + 2*i*npix2, fdata, 2*npix2*sizeof(float));
+    QFFTWF_FREE(fdata);
+    }
 
   free(mask);
 
@@ -3439,6 +4580,53 @@ void	profit_resetparams(profitstruct *profit)
   }
 
 
+/****** profit_warmstart ***************************************************
+PROTO	int profit_warmstart(profitstruct *profit, picstruct *field,
+			obj2struct *obj2)
+PURPOSE	Replace initial guesses with the model parameters fitted to the same
+	object in a previous run.
+INPUT	Pointer to the profit structure,
+	pointer to the field (with a model initialisation list),
+	pointer to the obj2.
+OUTPUT	1 if a match was found, 0 otherwise.
+NOTES	The model configuration must be the same as in the previous run.
+	Stored values that fall outside the current boundaries are ignored.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	profit_warmstart(profitstruct *profit, picstruct *field,
+			obj2struct *obj2)
+  {
+   assocstruct	*assoc;
+   double	*row, *data;
+   float	param;
+   int		p;
+
+  assoc = field->modelassoc;
+  if (assoc->ndata != profit->nparam
+	|| !(row = nearest_assoc(field, assoc, obj2->posx, obj2->posy)))
+    return 0;
+
+  data = row+3;
+  for (p=0; p<profit->nparam; p++)
+    {
+/*-- Fitted positions are made relative to the current reference pixel */
+    if (p==profit->paramindex[PARAM_X] && profit->paramlist[PARAM_X])
+      param = (float)(row[0] - 1.0 - profit->ix);
+    else if (p==profit->paramindex[PARAM_Y] && profit->paramlist[PARAM_Y])
+      param = (float)(row[1] - 1.0 - profit->iy);
+    else
+      param = (float)data[p];
+    if (profit->parfittype[p] == PARFIT_UNBOUND
+	|| (profit->parfittype[p] != PARFIT_FIXED
+		&& param>profit->parammin[p] && param<profit->parammax[p]))
+      profit->paraminit[p] = param;
+    }
+
+  return 1;
+  }
+
+
 /****** profit_setparam ****************************************************
 PROTO	void profit_setparam(profitstruct *profit, paramenum paramtype,
 		float param, float parammin, float parammax,
@@ -3947,15 +5135,19 @@ INPUT	Prof structure.
 OUTPUT	-.
 NOTES	-.
 AUTHOR	E. Bertin (IAP)
-VERSION	09/04/2007
+VERSION	19/10/2026
  ***/
 void	prof_end(profstruct *prof)
   {
+   int	s;
+
   if (prof->pix)
     {
     free(prof->pix);
     free(prof->kernelbuf);
     }
+  for (s=0; s<PROFIT_RTABNSLOT; s++)
+    free(prof->rtab[s]);
   free(prof);
 
   return;
@@ -3970,9 +5162,10 @@ INPUT	Profile-fitting structure,
 	profile structure,
 	flag (0 if flux correction factor is to be computed internally) 
 OUTPUT	Total (asymptotic) flux contribution.
-NOTES	-.
+NOTES	Sersic, de Vaucouleurs and exponential profiles are rendered using
+	a radial lookup table (see prof_rtab()).
 AUTHOR	E. Bertin (IAP)
-VERSION	13/02/2013
+VERSION	19/10/2026
  ***/
 float	prof_add(profitstruct *profit, profstruct *prof, int extfluxfac_flag)
   {
@@ -3991,8 +5184,10 @@ float	prof_add(profitstruct *profit, profstruct *prof, int extfluxfac_flag)
 		invn, dr, krpinvn,dkrpinvn, rs,rs2,
 		a11,a12,a21,a22, invdet, dca,dsa, a0,a2,a3, p1,p2,
 		krspinvn, ekrspinvn, selem;
+   double	ea,eb,ec, er2max, disc, ex1;
+   float	*rtab;
    int		npix, threshflag,
-		a,d,e,i, ix1,ix2, ix1max,ix2max, nang, nx2,
+		a,d,e,i, ix1,ix2, ix1min,ix1max,ix2max, nang, nx1,nx2,
 		npix2;
 
   npix = profit->nmodpix;
@@ -4090,43 +5285,53 @@ float	prof_add(profitstruct *profit, profstruct *prof, int extfluxfac_flag)
 /*---- Compute the smooth part of the profile */
       x10 = -x1cout - dx1;
       x2 = -x2cout - dx2;
+      rtab = prof_rtab(prof, n, k, rs2, r2max);
+/*---- Pixels with r^2 <= r2max are within an ellipse, tilted by a small */
+/*---- margin to make sure that all of them are computed */
+      ea = cd11*cd11 + cd21*cd21;
+      eb = 2.0*(cd11*cd12 + cd21*cd22);
+      ec = cd12*cd12 + cd22*cd22;
+      er2max = r2max*1.0001 + 1e-4;
+      nx1 = profit->modnaxisn[0];
       pixin = prof->pix;
-      if (prof->code==MODEL_EXPONENTIAL)
-        for (ix2=nx2; ix2--; x2+=1.0)
+      for (ix2=nx2; ix2--; x2+=1.0, pixin+=nx1)
+        {
+        ix1min = 0;
+        ix1max = nx1;
+        if (ea > 0.0)
           {
-          x1 = x10;
-          for (ix1=profit->modnaxisn[0]; ix1--; x1+=1.0)
+          disc = eb*eb*x2*x2 - 4.0*ea*(ec*x2*x2 - er2max);
+          if (disc<0.0)
+            ix1min = ix1max = 0;
+          else
             {
-            x1in = cd12*x2 + cd11*x1;
-            x2in = cd22*x2 + cd21*x1;
-            ra = x1in*x1in+x2in*x2in;
-            if (ra>r2max)
-              {
-              *(pixin++) = 0.0;
-              continue;
-              }
-            val = ra<rs2? a0+ra*(a2+a3*sqrtf(ra)) : expf(-sqrtf(ra));
-            *(pixin++) = val;
+            disc = sqrt(disc);
+            ex1 = (-eb*x2 - disc)/(2.0*ea) - x10;
+            ix1min = ex1 > 1.0? (ex1 < nx1? (int)ex1 - 1 : nx1) : 0;
+            ex1 = (-eb*x2 + disc)/(2.0*ea) - x10;
+            ix1max = ex1 > -2.0? (ex1 < nx1-2? (int)ex1 + 2 : nx1) : 0;
+            if (ix1max < ix1min)
+              ix1max = ix1min;
             }
           }
-      else
-        for (ix2=nx2; ix2--; x2+=1.0)
+        if (ix1min>0)
+          memset(pixin, 0, ix1min*sizeof(float));
+        if (ix1max<nx1)
+          memset(pixin+ix1max, 0, (nx1-ix1max)*sizeof(float));
+        if (ix1max>ix1min)
           {
-          x1 = x10;
-          for (ix1=profit->modnaxisn[0]; ix1--; x1+=1.0)
-            {
-            x1in = cd12*x2 + cd11*x1;
-            x2in = cd22*x2 + cd21*x1;
-            ra = x1in*x1in+x2in*x2in;
-            if (ra>r2max)
-              {
-              *(pixin++) = 0.0;
-              continue;
-              }
-            val = ra<rs2? a0+ra*(a2+a3*sqrtf(ra)) : expf(k*expf(logf(ra)*hinvn));
-            *(pixin++) = val;
-            }
+#ifdef VEC_X86
+          if (vec_getlevel() >= VEC_LEVEL_AVX2)
+            prof_sersicline_avx2(rtab, pixin+ix1min, ix1max-ix1min,
+		x10+(float)ix1min, cd12*x2, cd22*x2, cd11, cd21, rs2, r2max,
+		a0, a2, a3);
+          else
+#endif
+            prof_sersicline(rtab, pixin+ix1min, ix1max-ix1min,
+		x10+(float)ix1min, cd12*x2, cd22*x2, cd11, cd21, rs2, r2max,
+		a0, a2, a3);
           }
+        }
 /*---- Copy the symmetric part */
       if ((npix2=(profit->modnaxisn[1]-nx2)*profit->modnaxisn[0]) > 0)
         {
@@ -4472,6 +5677,227 @@ width = 3.0;
   }
 
 
+/****** prof_rtab ************************************************************
+PROTO	float *prof_rtab(profstruct *prof, double n, double k,
+			float r2min, float r2max)
+PURPOSE	Return a lookup table of exp(k*r^(1/n)) as a function of r^2, updated
+	to cover the requested range of r^2.
+INPUT	Profile structure,
+	profile index n,
+	profile slope k,
+	lowest r^2 to be looked up,
+	highest r^2 to be looked up.
+OUTPUT	Pointer to the lookup table.
+NOTES	Table elements are evenly spaced in the IEEE-754 representation of r^2,
+	with 2^PROFIT_RTABRES elements per octave, from 2^PROFIT_RTABMINEXP
+	to 2^PROFIT_RTABMAXEXP. Values are linearly interpolated within each
+	step. Tables for the PROFIT_RTABNSLOT most recently used (n,k) pairs
+	are kept in the profile structure, so that the finite-difference
+	steps in n do not discard the table of the current solution; a table
+	is only extended as needed.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static float	*prof_rtab(profstruct *prof, double n, double k,
+			float r2min, float r2max)
+  {
+   union {float f; int i;}	u;
+   float	*rtab;
+   double	hinvn;
+   int		j, jmin,jmax, jstart,jend, s,t;
+
+/* Look for a table computed with the same n and k, or recycle the oldest */
+  for (s=t=0; s<PROFIT_RTABNSLOT; s++)
+    if (prof->rtab[s] && n == prof->rtabn[s] && k == prof->rtabk[s])
+      break;
+    else if (prof->rtabuse[s] < prof->rtabuse[t])
+      t = s;
+  if (s==PROFIT_RTABNSLOT)
+    {
+    s = t;
+    if (!prof->rtab[s])
+      QCALLOC(prof->rtab[s], float, PROF_RTABSIZE);
+    prof->rtabn[s] = n;
+    prof->rtabk[s] = k;
+    prof->rtabmin[s] = PROF_RTABSIZE;
+    prof->rtabmax[s] = -1;
+    }
+  prof->rtabuse[s] = ++prof->rtabclock;
+  rtab = prof->rtab[s];
+
+  u.f = r2min;
+  jmin = u.i - PROF_RTABIMIN;
+  jmin = jmin<0? 0 : (jmin>PROF_RTABJMAX? PROF_RTABJMAX : jmin);
+  jmin >>= PROF_RTABSHIFT;
+  u.f = r2max;
+  jmax = u.i - PROF_RTABIMIN;
+  jmax = jmax<0? 0 : (jmax>PROF_RTABJMAX? PROF_RTABJMAX : jmax);
+  jmax = (jmax>>PROF_RTABSHIFT) + 1;
+  if (jmin >= prof->rtabmin[s] && jmax <= prof->rtabmax[s])
+    return rtab;
+
+/* Fill in the missing elements */
+  if (prof->rtabmax[s] < prof->rtabmin[s])
+    {
+    jstart = jmin;
+    jend = jmax;
+    }
+  else
+    {
+    jstart = jmin<prof->rtabmin[s]? jmin : prof->rtabmin[s];
+    jend = jmax>prof->rtabmax[s]? jmax : prof->rtabmax[s];
+    }
+  hinvn = 0.5/n;
+  for (j=jstart; j<=jend; j++)
+    if (j<prof->rtabmin[s] || j>prof->rtabmax[s])
+      {
+      u.i = PROF_RTABIMIN + (j<<PROF_RTABSHIFT);
+      rtab[j] = (float)exp(k*pow((double)u.f, hinvn));
+      }
+  prof->rtabmin[s] = jstart;
+  prof->rtabmax[s] = jend;
+
+  return rtab;
+  }
+
+
+/****** prof_sersicline *******************************************************
+PROTO	void prof_sersicline(float *rtab, float *pix, int n, float x1,
+		float x1c, float x2c, float cd11, float cd21,
+		float rs2, float r2max, float a0, float a2, float a3)
+PURPOSE	Render a line of the smooth part of a Sersic-like profile.
+INPUT	Pointer to the radial lookup table,
+	pointer to the output line,
+	number of pixels,
+	x coordinate of the first pixel,
+	x contribution of the line y coordinate to the profile x coordinate,
+	x contribution of the line y coordinate to the profile y coordinate,
+	x derivative of the profile x coordinate,
+	x derivative of the profile y coordinate,
+	r^2 of the transition to the central polynomial,
+	truncation r^2,
+	0th order coefficient of the central polynomial,
+	2nd order coefficient of the central polynomial,
+	3rd order coefficient of the central polynomial.
+OUTPUT	-.
+NOTES	See prof_rtab() for the lookup table indexing.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static void	prof_sersicline(float *rtab, float *pix, int n, float x1,
+			float x1c, float x2c, float cd11, float cd21,
+			float rs2, float r2max, float a0, float a2, float a3)
+  {
+   union {float f; int i;}	u;
+   float	*rtabt,
+		x1in,x2in, ra;
+   int		j;
+
+  for (; n--; x1+=1.0)
+    {
+    x1in = x1c + cd11*x1;
+    x2in = x2c + cd21*x1;
+    ra = x1in*x1in+x2in*x2in;
+    if (ra>r2max)
+      *(pix++) = 0.0;
+    else if (ra<rs2)
+      *(pix++) = a0+ra*(a2+a3*sqrtf(ra));
+    else
+      {
+      u.f = ra;
+      j = u.i - PROF_RTABIMIN;
+      j = j<0? 0 : (j>PROF_RTABJMAX? PROF_RTABJMAX : j);
+      rtabt = rtab + (j>>PROF_RTABSHIFT);
+      *(pix++) = rtabt[0] + (float)(j&PROF_RTABMASK)*PROF_RTABFSTEP
+			*(rtabt[1] - rtabt[0]);
+      }
+    }
+
+  return;
+  }
+
+
+#ifdef VEC_X86
+/****** prof_sersicline_avx2 **************************************************
+PROTO	void prof_sersicline_avx2(float *rtab, float *pix, int n, float x1,
+		float x1c, float x2c, float cd11, float cd21,
+		float rs2, float r2max, float a0, float a2, float a3)
+PURPOSE	AVX2 version of prof_sersicline().
+INPUT	Pointer to the radial lookup table,
+	pointer to the output line,
+	number of pixels,
+	x coordinate of the first pixel,
+	x contribution of the line y coordinate to the profile x coordinate,
+	x contribution of the line y coordinate to the profile y coordinate,
+	x derivative of the profile x coordinate,
+	x derivative of the profile y coordinate,
+	r^2 of the transition to the central polynomial,
+	truncation r^2,
+	0th order coefficient of the central polynomial,
+	2nd order coefficient of the central polynomial,
+	3rd order coefficient of the central polynomial.
+OUTPUT	-.
+NOTES	FMA contraction is avoided to reproduce exactly the scalar results.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static VEC_AVX2 void	prof_sersicline_avx2(float *rtab, float *pix, int n,
+			float x1, float x1c, float x2c, float cd11, float cd21,
+			float rs2, float r2max, float a0, float a2, float a3)
+  {
+   __m256	vx1,vx1c,vx2c,vcd11,vcd21, vrs2,vr2max, va0,va2,va3, vstep,
+		vfstep, vx1in,vx2in, vra, vpoly, vt0,vt1, vval;
+   __m256i	vj, vimin, vjmax, vmask, vzero, vidx;
+
+  vx1 = _mm256_add_ps(_mm256_set1_ps(x1),
+		_mm256_setr_ps(0.0,1.0,2.0,3.0,4.0,5.0,6.0,7.0));
+  vx1c = _mm256_set1_ps(x1c);
+  vx2c = _mm256_set1_ps(x2c);
+  vcd11 = _mm256_set1_ps(cd11);
+  vcd21 = _mm256_set1_ps(cd21);
+  vrs2 = _mm256_set1_ps(rs2);
+  vr2max = _mm256_set1_ps(r2max);
+  va0 = _mm256_set1_ps(a0);
+  va2 = _mm256_set1_ps(a2);
+  va3 = _mm256_set1_ps(a3);
+  vstep = _mm256_set1_ps(8.0);
+  vfstep = _mm256_set1_ps(PROF_RTABFSTEP);
+  vimin = _mm256_set1_epi32(PROF_RTABIMIN);
+  vjmax = _mm256_set1_epi32(PROF_RTABJMAX);
+  vmask = _mm256_set1_epi32(PROF_RTABMASK);
+  vzero = _mm256_setzero_si256();
+  for (; n>=8; n-=8, pix+=8, x1+=8.0)
+    {
+    vx1in = _mm256_add_ps(vx1c, _mm256_mul_ps(vcd11, vx1));
+    vx2in = _mm256_add_ps(vx2c, _mm256_mul_ps(vcd21, vx1));
+    vra = _mm256_add_ps(_mm256_mul_ps(vx1in, vx1in),
+		_mm256_mul_ps(vx2in, vx2in));
+/*-- Central polynomial */
+    vpoly = _mm256_add_ps(va0, _mm256_mul_ps(vra, _mm256_add_ps(va2,
+		_mm256_mul_ps(va3, _mm256_sqrt_ps(vra)))));
+/*-- Table lookup */
+    vj = _mm256_sub_epi32(_mm256_castps_si256(vra), vimin);
+    vj = _mm256_min_epi32(_mm256_max_epi32(vj, vzero), vjmax);
+    vidx = _mm256_srli_epi32(vj, PROF_RTABSHIFT);
+    vt0 = _mm256_i32gather_ps(rtab, vidx, 4);
+    vt1 = _mm256_i32gather_ps(rtab+1, vidx, 4);
+    vval = _mm256_add_ps(vt0, _mm256_mul_ps(_mm256_mul_ps(
+		_mm256_cvtepi32_ps(_mm256_and_si256(vj, vmask)), vfstep),
+		_mm256_sub_ps(vt1, vt0)));
+    vval = _mm256_blendv_ps(vval, vpoly, _mm256_cmp_ps(vra, vrs2, _CMP_LT_OQ));
+    vval = _mm256_andnot_ps(_mm256_cmp_ps(vra, vr2max, _CMP_GT_OQ), vval);
+    _mm256_storeu_ps(pix, vval);
+    vx1 = _mm256_add_ps(vx1, vstep);
+    }
+  if (n)
+    prof_sersicline(rtab, pix, n, x1, x1c, x2c, cd11, cd21, rs2, r2max,
+		a0, a2, a3);
+
+  return;
+  }
+#endif
+
+
 /****** prof_moments **********************************************************
 PROTO	int	prof_moments(profitstruct *profit, profstruct *prof)
 PURPOSE	Computes (analytically or numerically) the 2nd moments of a profile.
@@ -4899,54 +6325,8 @@ void	make_kernel(float pos, float *kernel, interpenum interptype)
       }
     }
   else if (interptype == INTERP_LANCZOS4)
-    {
-    if (pos<1e-5f && pos>-1e-5f)
-      {
-      *(kernel++) = 0.0f;
-      *(kernel++) = 0.0f;
-      *(kernel++) = 0.0f;
-      *(kernel++) = 1.0f;
-      *(kernel++) = 0.0f;
-      *(kernel++) = 0.0f;
-      *(kernel++) = 0.0f;
-      *kernel = 0.0f;
-      }
-    else
-      {
-      x = -PI/4.0f*(pos+3.0f);
-#ifdef HAVE_SINCOSF
-      sincosf(x, &sinx1, &cosx1);
-#else
-      sinx1 = sinf(x);
-      cosx1 = cosf(x);
-#endif
-      val = (*(kernel++) = sinx1/(x*x));
-      x += PI/4.0f;
-      val +=(*(kernel++) = -(sinx2=0.707106781186f*(sinx1+cosx1))
-				/(x*x));
-      x += PI/4.0f;
-      val += (*(kernel++) = cosx1/(x*x));
-      x += PI/4.0f;
-      val += (*(kernel++) = -(sinx3=0.707106781186f*(cosx1-sinx1))/(x*x));
-      x += PI/4.0f;
-      val += (*(kernel++) = -sinx1/(x*x));
-      x += PI/4.0f;
-      val += (*(kernel++) = sinx2/(x*x));
-      x += PI/4.0f;
-      val += (*(kernel++) = -cosx1/(x*x));
-      x += PI/4.0f;
-      val += (*kernel = sinx3/(x*x));
-      val = 1.0f/val;
-      *(kernel--) *= val;
-      *(kernel--) *= val;
-      *(kernel--) *= val;
-      *(kernel--) *= val;
-      *(kernel--) *= val;
-      *(kernel--) *= val;
-      *(kernel--) *= val;
-      *kernel *= val;
-      }
-    }
+/*-- Tabulated kernel, shared with vignet_resample() */
+    make_interpkernel(pos, kernel);
   else
     error(EXIT_FAILURE, "*Internal Error*: Unknown interpolation type in ",
 		"make_kernel()");
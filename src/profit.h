@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		16/03/2016
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -49,6 +49,7 @@
 #define		PROFLAG_NOTCONST	0x0004
 #define		PROFLAG_MINLIM		0x0008
 #define		PROFLAG_MAXLIM		0x0010
+#define		PROFLAG_BLEND		0x0020
 
 /*------------------------- parameter type flags ----------------------------*/
 
@@ -76,10 +77,18 @@
 #define	PROFIT_MAXOBJSIZE  512	/* Maximum size allowed for the object raster */
 #define	PROFIT_BARXFADE	0.1	/* Fract. of bar length crossfaded with arms */
 #define	PROFIT_MAXEXTRA	2	/* Max. nb of extra free params of profiles */
+#define	PROFIT_MAXJACRENDER 1	/* Max. nb of rebuilt components for Jacobian*/
+#define	PROFIT_BLENDMAX	8	/* Max. nb of objects in a joint fit */
+#define	PROFIT_RTABRES	8	/* log2 of radial table steps per octave in r^2*/
+#define	PROFIT_RTABMINEXP (-30)	/* log2 of the smallest tabulated r^2 */
+#define	PROFIT_RTABMAXEXP 21	/* log2 of the largest tabulated r^2 */
+#define	PROFIT_RTABNSLOT 4	/* Nb of radial tables cached (one per n) */
 #define INTERP_MAXKERNELWIDTH	8	/* Max. range of kernel (pixels) */
 /* NOTES:
 One must have:	PROFIT_NITER > 0
 		PROFIT_MAXEXTRA > 0
+		0 < PROFIT_RTABRES <= 23
+		2^PROFIT_RTABMAXEXP > PROFIT_MAXR2MAX
 */
 
 /*--------------------------------- typedefs --------------------------------*/
@@ -104,6 +113,9 @@ typedef enum	{PARAM_BACK,
 typedef enum 	{PARFIT_FIXED, PARFIT_UNBOUND, PARFIT_LINBOUND,
 		PARFIT_LOGBOUND}	parfitenum;
 
+typedef enum	{PROF_DEPNONE, PROF_DEPBACK, PROF_DEPFLUX, PROF_DEPPIX,
+		PROF_DEPGEOM, PROF_DEPRENDER}	profdepenum;
+
 /*--------------------------- structure definitions -------------------------*/
 
 typedef struct
@@ -140,6 +152,13 @@ typedef struct
   int		kernelwidth[2+PROFIT_MAXEXTRA];	/* Kernel size */
   float		*kernelbuf;		/* Kernel buffer */
   int		kernelnlines;		/* Number of interp kernel lines */
+  float		*rtab[PROFIT_RTABNSLOT];	/* Radial profile lookup tables */
+  double	rtabn[PROFIT_RTABNSLOT],	/* Profile index of each rtab */
+		rtabk[PROFIT_RTABNSLOT];	/* Profile slope of each rtab */
+  int		rtabmin[PROFIT_RTABNSLOT],	/* Range of valid rtab elements */
+		rtabmax[PROFIT_RTABNSLOT];
+  unsigned int	rtabuse[PROFIT_RTABNSLOT],	/* Last use of each rtab */
+		rtabclock;			/* Lookup counter */
   }	profstruct;
 
 typedef struct
@@ -169,7 +188,7 @@ typedef struct
   float		pixstep;	/* Model/PSF sampling step */
   float		fluxfac;	/* Model flux scaling factor */
   float		subsamp;	/* Subsampling factor */
-  float		*psfdft;	/* Compressed Fourier Transform of the PSF */
+  float		*psfdft;	/* Compressed FTs of the PSF and moments */
   float		*psfpix;	/* Full res. pixmap of the PSF */
   float		*modpix;	/* Full res. pixmap of the complete model */
   float		*modpix2;	/* 2nd full res. pixmap of the complete model */
@@ -200,10 +219,34 @@ typedef struct
   float		guessradius;	/* Best guess for source half-light radius */
   float		guessaspect;	/* Best guess for source aspect ratio */
   float		guessposang;	/* Best guess for source position angle */
+  struct blend	*blend;		/* List of pending joint fits */
 /* Buffers */
   double	dparam[PARAM_NPARAM];
   }	profitstruct;
 
+typedef struct blend
+  {
+  profitstruct	*profit;	/* Profile-fitting structure used for the fit */
+  int		nmember;	/* Number of objects fitted jointly */
+  double	*pos;		/* Barycenters of the members */
+  int		*done;		/* Set once the member has been measured */
+  int		*flag;		/* PROFLAG_MINLIM/MAXLIM flags of each member */
+  int		*nfree;		/* Number of free parameters of each member */
+  float		*param;		/* Parameters (absolute positions) */
+  float		*parammin;	/* Parameter lower limits */
+  float		*parammax;	/* Parameter upper limits */
+  parfitenum	*parfittype;	/* Parameter fitting types */
+  double	*dparampcen;	/* Parameter prior centers */
+  double	*dparampsig;	/* Parameter prior sigmas */
+  float		*covar;		/* Covariance matrix of each member */
+  int		niter;		/* Number of iterations of the joint fit */
+  double	*dslot[2];	/* Unbound parameters of cached models */
+  PIXTYPE	*lmodslot[2];	/* Cached low resolution models */
+  int		*slotflag[2];	/* Set if a cached model is valid */
+  int		*lastslot;	/* Most recently computed cache slot */
+  struct blend	*nextblend;	/* Next joint fit in the list */
+  }	blendstruct;
+
 /*----------------------------- Global variables ----------------------------*/
 /*-------------------------------- functions --------------------------------*/
 
@@ -211,6 +254,8 @@ profitstruct	*profit_init(struct psf *psf, unsigned int modeltype);
 
 profstruct	*prof_init(profitstruct *profit, unsigned int modeltype);
 
+blendstruct	*profit_blendfind(profitstruct *profit, objstruct *obj, int *k);
+
 float		*profit_compresi(profitstruct *profit, float dynparam,
 				float *resi),
 		*profit_presiduals(profitstruct *profit, double *dparam,
@@ -224,12 +269,18 @@ float		*profit_compresi(profitstruct *profit, float dynparam,
 		profit_noisearea(profitstruct *profit),
 		profit_spiralindex(profitstruct *profit);
 
-int		profit_boundtounbound(profitstruct *profit,
+int		profit_blendfit(profitstruct *profit, picstruct *field,
+			picstruct *wfield, picstruct *dgeofield,
+			objliststruct *objlist, int n, obj2struct *obj2),
+		profit_boundtounbound(profitstruct *profit,
 			float *param, double *dparam, int index),
+		profit_coarsefit(profitstruct *profit, int fac),
 		profit_copyobjpix(profitstruct *profit, picstruct *field,
 			picstruct *wfield, picstruct *dgeofield),
 		profit_covarunboundtobound(profitstruct *profit,
 			double *dparam, float *param),
+		profit_frame(profitstruct *profit, double mx, double my,
+			int w, int h),
 		profit_minimize(profitstruct *profit, int niter),
 		prof_moments(profitstruct *profit, profstruct *prof,
 				double *jac),
@@ -240,7 +291,9 @@ int		profit_boundtounbound(profitstruct *profit,
 			parfitenum parfittype,
 			float priorcen, float priorsig),
 		profit_unboundtobound(profitstruct *profit,
-			double *dparam, float *param, int index);
+			double *dparam, float *param, int index),
+		profit_warmstart(profitstruct *profit, picstruct *field,
+			obj2struct *obj2);
 
 void		profit_dfit(profitstruct *profit, profitstruct *dprofit,
 			picstruct *field, picstruct *dfield,
@@ -249,6 +302,14 @@ void		profit_dfit(profitstruct *profit, profitstruct *dprofit,
 		prof_end(profstruct *prof),
 		profit_addparam(profitstruct *profit, paramenum paramindex,
 			float **param),
+		profit_blenddrop(profitstruct *profit, objstruct *obj),
+		profit_blendfree(blendstruct *blend),
+		profit_blendload(profitstruct *profit, blendstruct *blend,
+			int k, obj2struct *obj2),
+		profit_blendrestore(profitstruct *profit, blendstruct *blend,
+			int k),
+		profit_blendsave(profitstruct *profit, blendstruct *blend,
+			int k),
 		profit_fit(profitstruct *profit, picstruct *field,
 			picstruct *wfield, picstruct *dgeofield,
 			objstruct *obj, obj2struct *obj2),
@@ -259,6 +320,8 @@ void		profit_dfit(profitstruct *profit, profitstruct *dprofit,
 			void *adata),
 		profit_fluxcor(profitstruct *profit, objstruct *obj,
 				obj2struct *obj2),
+		profit_jacobian(double *par, double *jac, int m, int n,
+			void *adata),
 		profit_makedft(profitstruct *profit),
 		profit_moments(profitstruct *profit, obj2struct *obj2),
 		profit_printout(int n_par, float* par, int m_dat, float* fvec,
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -61,14 +61,14 @@ Allocate memory and stuff for the PSF-fitting.
 */
 void	psf_init(void)
   {
-  QMALLOC(thepsfit, psfitstruct, 1);
+  QCALLOC(thepsfit, psfitstruct, 1);
   QMALLOC(thepsfit->x, double, prefs.psf_npsfmax);
   QMALLOC(thepsfit->y, double, prefs.psf_npsfmax);
   QMALLOC(thepsfit->flux, float, prefs.psf_npsfmax);
   QMALLOC(thepsfit->fluxerr, float, prefs.psf_npsfmax);
   if (prefs.dpsf_flag)
     {
-    QMALLOC(thedpsfit, psfitstruct, 1);
+    QCALLOC(thedpsfit, psfitstruct, 1);
     QMALLOC(thedpsfit->x, double, prefs.psf_npsfmax);
     QMALLOC(thedpsfit->y, double, prefs.psf_npsfmax);
     QMALLOC(thedpsfit->flux, float, prefs.psf_npsfmax);
@@ -80,32 +80,36 @@ void	psf_init(void)
 
 /********************************* psf_end ***********************************/
 /*
-Free memory occupied by the PSF-fitting stuff.
+Free memory occupied by the PSF-fitting stuff (psf or psfit may be NULL).
 */
 void	psf_end(psfstruct *psf, psfitstruct *psfit)
   {
    int	d, ndim;
 
-  if (psf->pc)
-    pc_end(psf->pc);
-
-  ndim = psf->poly->ndim;
-  for (d=0; d<ndim; d++)
-    free(psf->contextname[d]);
-  free(psf->context);
-  free(psf->contextindex);
-  free(psf->contextname);
-  free(psf->contextoffset);
-  free(psf->contextscale);
-  free(psf->contexttyp);
-  poly_end(psf->poly);
-  free(psf->maskcomp);
-  free(psf->maskloc);
-  free(psf->masksize);
-  free(psf);
+  if (psf)
+    {
+    if (psf->pc)
+      pc_end(psf->pc);
+
+    ndim = psf->poly->ndim;
+    for (d=0; d<ndim; d++)
+      free(psf->contextname[d]);
+    free(psf->context);
+    free(psf->contextindex);
+    free(psf->contextname);
+    free(psf->contextoffset);
+    free(psf->contextscale);
+    free(psf->contexttyp);
+    poly_end(psf->poly);
+    free(psf->maskcomp);
+    free(psf->maskloc);
+    free(psf->masksize);
+    free(psf);
+    }
 
   if (psfit)
     {
+    psf_fitbuf(psfit, 0);
     free(psfit->x);
     free(psfit->y);
     free(psfit->flux);
@@ -117,23 +121,78 @@ void	psf_end(psfstruct *psf, psfitstruct *psfit)
   }
 
 
+/******************************** psf_fitbuf *********************************/
+/*
+Make sure the PSF-fitting scratch buffers can hold npix pixels (free them all
+if npix is 0). Buffers are only reallocated when they have to grow, and their
+content is not preserved.
+*/
+void	psf_fitbuf(psfitstruct *psfit, int npix)
+  {
+   int	i;
+
+  if (npix && npix<=psfit->npixmax)
+    return;
+
+  if (psfit->npixmax)
+    {
+    for (i=0; i<prefs.psf_npsfmax; i++)
+      {
+      free(psfit->psfmasks[i]);
+      free(psfit->psfmaskx[i]);
+      free(psfit->psfmasky[i]);
+      }
+    free(psfit->psfmasks);
+    free(psfit->psfmaskx);
+    free(psfit->psfmasky);
+    free(psfit->datah);
+    free(psfit->weighth);
+    free(psfit->data);
+    free(psfit->data2);
+    free(psfit->data3);
+    free(psfit->weight);
+    free(psfit->mat);
+    psfit->npixmax = 0;
+    }
+
+  if (!npix)
+    return;
+
+  QMALLOC(psfit->psfmasks, float *, prefs.psf_npsfmax);
+  QMALLOC(psfit->psfmaskx, float *, prefs.psf_npsfmax);
+  QMALLOC(psfit->psfmasky, float *, prefs.psf_npsfmax);
+  for (i=0; i<prefs.psf_npsfmax; i++)
+    {
+    QMALLOC(psfit->psfmasks[i], float, npix);
+    QMALLOC(psfit->psfmaskx[i], float, npix);
+    QMALLOC(psfit->psfmasky[i], float, npix);
+    }
+  QMALLOC(psfit->datah, PIXTYPE, npix);
+  QMALLOC(psfit->weighth, PIXTYPE, npix);
+  QMALLOC(psfit->data, float, npix);
+  QMALLOC(psfit->data2, float, npix);
+  QMALLOC(psfit->data3, float, npix);
+  QMALLOC(psfit->weight, float, npix);
+  QMALLOC(psfit->mat, double, npix*PSF_NA*prefs.psf_npsfmax);
+  psfit->npixmax = npix;
+
+  return;
+  }
+
+
 /********************************* psf_load *********************************/
 /*
 Read the PSF data from a FITS file.
 */
 psfstruct	*psf_load(char *filename, int ext)
   {
-   extern tabstruct	*objtab;
-   static objstruct	saveobj;
-   static obj2struct	saveobj2;
    psfstruct		*psf;
    catstruct		*cat;
    tabstruct		*tab;
    keystruct		*key;
-   char			rkeyname[80],
-			*head, *ci,*co, *pstr, *pstrbuf;
+   char			*head, *ci;
    int			deg[POLY_MAXDIM], group[POLY_MAXDIM], ndim, ngroup,
-			d,e,i,k,p,n, keyn;
+			e,i;
 
 /* Open the cat (well it is not a "cat", but simply a FITS file */
   if (!(cat = read_cat(filename)))
@@ -176,12 +235,6 @@ psfstruct	*psf_load(char *filename, int ext)
     QMALLOC(psf->contextoffset, double, ndim);
     QMALLOC(psf->contextscale, double, ndim);
 
-/*-- We will have to use the outobj structs, so we first save their content */
-    saveobj = outobj;
-    saveobj2 = outobj2;
-/*-- outobj's are used as FLAG arrays, so we initialize them to 0 */
-    memset(&outobj, 0, sizeof(outobj));
-    memset(&outobj2, 0, sizeof(outobj2));
     for (i=0; i<ndim; i++)
       {
 /*---- Polynomial groups */
@@ -194,50 +247,6 @@ psfstruct	*psf_load(char *filename, int ext)
       sprintf(gstr, "POLNAME%1d", i+1);
       if (fitsread(head,gstr,psf->contextname[i],H_STRING,T_STRING)!=RETURN_OK)
         goto headerror;
-      if (*psf->contextname[i]==(char)':')
-/*------ It seems we're facing a FITS header parameter */
-        psf->context[i] = NULL;	/* This is to tell we'll have to load */
-				/* a FITS header context later on */
-      else
-/*------ The context element is a dynamic object parameter */
-        {
-        strncpy(rkeyname, psf->contextname[i],40);
-        strtok_r(rkeyname, "([{}])", &pstrbuf);
-        if ((k = findkey(rkeyname, (char *)objkey,
-		sizeof(keystruct)))==RETURN_ERROR)
-          {
-          sprintf(gstr, "*Error*: %s CONTEXT parameter in %s unknown",
-		rkeyname, psf->name);
-          error(EXIT_FAILURE, gstr, "");
-          }
-        keyn = (pstr = strtok_r(NULL,"([{}])", &pstrbuf))? atoi(pstr) - 1 : 0;
-        key = objkey+k;
-        if (key->naxis)
-          {
-          n = 1;
-          for (d=0; d<key->naxis; d++)
-            n *= key->naxisn[d];
-          if (keyn >= n)
-            {
-/*---------- Increase vector size: we restrict ourselves to vectors (1D) */
-            key->nbytes = key->naxisn[0] = keyn+1;
-            key->naxis = 1;
-            changecatparamarrays(rkeyname, key->naxisn, key->naxis);
-            }
-          }
-        else
-          keyn = -1;
-        psf->context[i] = (double *)((char *)key->ptr);
-        psf->contextindex[i] = keyn;
-        psf->contexttyp[i] = key->ttype;
-/*------ Declare the parameter "active" to trigger computation by SExtractor */
-        *((char *)key->ptr) = (char)'\1';
-/*------ Add the key to the catalog */
-        if (add_key(key, objtab, 0) != RETURN_ERROR)
-          thecat.nparam++;
-        if (!cistrcmp("MAG", rkeyname, FIND_NOSTRICT))
-          psf->mag_flag = 1;
-        }
 /*---- Scaling of the context parameter */
       sprintf(gstr, "POLZERO%1d", i+1);
       if (fitsread(head, gstr, &psf->contextoffset[i], H_EXPO, T_DOUBLE)
@@ -263,15 +272,8 @@ psfstruct	*psf_load(char *filename, int ext)
 
     psf->poly = poly_init(group, ndim, deg, ngroup);
 
-/*-- Update the permanent FLAG arrays (that is, perform an "OR" on them) */
-    for (ci=(char *)&outobj,co=(char *)&flagobj,i=sizeof(objstruct); i--;)
-      *(co++) |= *(ci++);
-    for (ci=(char *)&outobj2,co=(char *)&flagobj2,i=sizeof(obj2struct); i--;)
-      *(co++) |= *(ci++);
-
-/*-- Restore previous outobj contents */
-    outobj = saveobj;
-    outobj2 = saveobj2;
+/*-- Hook context parameters to catalog measurements */
+    psf_initcontext(psf);
     }
   else
     {
@@ -328,6 +330,94 @@ headerror:
   }
 
 
+/****************************** psf_initcontext ******************************/
+/*
+Hook the PSF context parameters to the catalog measurements they depend on,
+or mark them for reading from the FITS header. This must be done again each
+time the catalog parameters are reset while the PSF is kept in memory.
+*/
+void	psf_initcontext(psfstruct *psf)
+  {
+   extern tabstruct	*objtab;
+   static objstruct	saveobj;
+   static obj2struct	saveobj2;
+   keystruct		*key;
+   char			rkeyname[80],
+			*ci,*co, *pstr, *pstrbuf;
+   int			d,i,k,n, ndim, keyn;
+
+  ndim = psf->poly->ndim;
+  if (!ndim)
+    return;
+
+/* We will have to use the outobj structs, so we first save their content */
+  saveobj = outobj;
+  saveobj2 = outobj2;
+/* outobj's are used as FLAG arrays, so we initialize them to 0 */
+  memset(&outobj, 0, sizeof(outobj));
+  memset(&outobj2, 0, sizeof(outobj2));
+  for (i=0; i<ndim; i++)
+    {
+    if (*psf->contextname[i]==(char)':')
+/*---- It seems we're facing a FITS header parameter */
+      psf->context[i] = NULL;	/* This is to tell we'll have to load */
+				/* a FITS header context later on */
+    else
+/*---- The context element is a dynamic object parameter */
+      {
+      strncpy(rkeyname, psf->contextname[i],40);
+      strtok_r(rkeyname, "([{}])", &pstrbuf);
+      if ((k = findkey(rkeyname, (char *)objkey,
+		sizeof(keystruct)))==RETURN_ERROR)
+        {
+        sprintf(gstr, "*Error*: %.80s CONTEXT parameter in %.256s unknown",
+		rkeyname, psf->name);
+        error(EXIT_FAILURE, gstr, "");
+        }
+      keyn = (pstr = strtok_r(NULL,"([{}])", &pstrbuf))? atoi(pstr) - 1 : 0;
+      key = objkey+k;
+      if (key->naxis)
+        {
+        n = 1;
+        for (d=0; d<key->naxis; d++)
+          n *= key->naxisn[d];
+        if (keyn >= n)
+          {
+/*-------- Increase vector size: we restrict ourselves to vectors (1D) */
+          key->nbytes = key->naxisn[0] = keyn+1;
+          key->naxis = 1;
+          changecatparamarrays(rkeyname, key->naxisn, key->naxis);
+          }
+        }
+      else
+        keyn = -1;
+      psf->context[i] = (double *)((char *)key->ptr);
+      psf->contextindex[i] = keyn;
+      psf->contexttyp[i] = key->ttype;
+/*---- Declare the parameter "active" to trigger computation by SExtractor */
+      *((char *)key->ptr) = (char)'\1';
+/*---- Add the key to the catalog */
+      if (add_key(key, objtab, 0) != RETURN_ERROR)
+        thecat.nparam++;
+      if (!cistrcmp("MAG", rkeyname, FIND_NOSTRICT))
+        psf->mag_flag = 1;
+      }
+    }
+
+/* Update the permanent FLAG arrays (that is, perform an "OR" on them) */
+  for (ci=(char *)&outobj,co=(char *)&flagobj,i=sizeof(objstruct); i--;)
+    *(co++) |= *(ci++);
+  for (ci=(char *)&outobj2,co=(char *)&flagobj2,i=sizeof(obj2struct); i--;)
+    *(co++) |= *(ci++);
+
+/* Restore previous outobj contents */
+  outobj = saveobj;
+  outobj2 = saveobj2;
+
+  return;
+  }
+
+
 /***************************** psf_readcontext *******************************/
 /*
 Read the PSF context parameters in the FITS header.
@@ -372,7 +462,8 @@ void	psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
 			deltaxb[PSF_NPSFMAX],deltayb[PSF_NPSFMAX],
 			fluxb[PSF_NPSFMAX],fluxerrb[PSF_NPSFMAX],
 			sol[PSF_NTOT], covmat[PSF_NTOT*PSF_NTOT], 
-			vmat[PSF_NTOT*PSF_NTOT], wmat[PSF_NTOT];
+			vmat[PSF_NTOT*PSF_NTOT], wmat[PSF_NTOT],
+			lmat[PSF_NTOT*PSF_NTOT], rhs[PSF_NTOT];
   float			*data, *data2, *data3, *weight, *d, *w;
   double		*mat,
 			*m, *var,
@@ -386,7 +477,7 @@ void	psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
   int			i,j,p, npsf,npsfmax, npix, nppix, ix,iy,niter,
 			width, height, pwidth,pheight, x,y,
 			xmax,ymax, wbad, gainflag, convflag, npsfflag,
-			ival,kill=0;
+			ival, svdflag, kill=0;
   
   dx = dy = 0.0;
   niter = 0;
@@ -429,13 +520,19 @@ void	psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
   pheight = (int)(psf->masksize[1]*psf->pixstep)+height;
   nppix = pwidth*pheight;
 
-  QMALLOC(weighth, PIXTYPE, npix);
-  QMALLOC(weight, float, npix);
-  QMALLOC(datah, PIXTYPE, npix);
-  QMALLOC(data, float, npix);
-  QMALLOC(data2, float, npix);
-  QMALLOC(data3, float, npix);
-  QMALLOC(mat, double, npix*PSF_NTOT);
+  /* Scratch buffers are shared by all objects (and the morphology fit) */
+  psf_fitbuf(thepsfit, prefs.pc_flag && (pwidth-1)*(pheight-1)>npix?
+		(pwidth-1)*(pheight-1) : npix);
+  weighth = thepsfit->weighth;
+  weight = thepsfit->weight;
+  datah = thepsfit->datah;
+  data = thepsfit->data;
+  data2 = thepsfit->data2;
+  data3 = thepsfit->data3;
+  mat = thepsfit->mat;
+  psfmasks = thepsfit->psfmasks;
+  psfmaskx = thepsfit->psfmaskx;
+  psfmasky = thepsfit->psfmasky;
   if (prefs.check[CHECK_SUBPSFPROTOS] || prefs.check[CHECK_PSFPROTOS]
       || prefs.check[CHECK_SUBPCPROTOS] || prefs.check[CHECK_PCPROTOS]
       || prefs.check[CHECK_PCOPROTOS])
@@ -443,16 +540,6 @@ void	psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
       QMALLOC(checkmask, PIXTYPE, nppix);
     }
 
-  QMALLOC(psfmasks, float *, npsfmax);
-  QMALLOC(psfmaskx, float *, npsfmax);
-  QMALLOC(psfmasky, float *, npsfmax);
-  for (i=0; i<npsfmax; i++)
-    {
-      QMALLOC(psfmasks[i], float, npix);
-      QMALLOC(psfmaskx[i], float, npix);
-      QMALLOC(psfmasky[i], float, npix);
-    }
-
   copyimage(field, datah, width, height, ix, iy);
 
   /* Compute weights */
@@ -574,16 +661,22 @@ void	psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
               m=compute_gradient(weight,width,height,
                                  psfmasks[j],psfmaskx[j],psfmasky[j],m);
             }
-          
-          
-          svdfit(mat, data, npix, npsf*PSF_NA, sol, vmat, wmat);
-          
+
+/*------ Normal equations, with SVD as a fallback for degenerate systems */
+          svdflag = (cholfit(mat, data, npix, npsf*PSF_NA, 0, sol, lmat, rhs)
+			!= RETURN_OK);
+          if (svdflag)
+            svdfit(mat, data, npix, npsf*PSF_NA, sol, vmat, wmat);
+
           compute_pos( &npsf, &convflag, &npsfflag,radmin2,radmax2,
                        r2, sol,flux, deltax, deltay,&dx,&dy);
         }
 
 /*-- Compute variances and covariances */
-      svdvar(vmat, wmat, npsf*PSF_NA, covmat);
+      if (svdflag)
+        svdvar(vmat, wmat, npsf*PSF_NA, covmat);
+      else
+        cholvar(lmat, npsf*PSF_NA, covmat);
       var = covmat;
       for (j=0; j<npsf; j++, var += (npsf*PSF_NA+1)*PSF_NA)
         {
@@ -733,26 +826,7 @@ void	psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
       pc_fit(psf, data, weight, width, height, ix,iy, dx,dy, npix,
              field->backsig);
     }
-  
-  
-  for (i=0; i<prefs.psf_npsfmax; i++)
-    {
-      QFREE(psfmasks[i]);
-      QFREE(psfmaskx[i]);
-      QFREE(psfmasky[i]);
-    }
 
-  QFREE(psfmasks);
-  QFREE(psfmaskx);
-  QFREE(psfmasky);
-  QFREE(datah);
-  QFREE(data);
-  QFREE(data2);
-  QFREE(data3);
-  QFREE(weighth);
-  QFREE(weight);
-  QFREE(data);
-  QFREE(mat);
 
   if (prefs.check[CHECK_SUBPSFPROTOS] || prefs.check[CHECK_PSFPROTOS]
       || prefs.check[CHECK_SUBPCPROTOS] || prefs.check[CHECK_PCPROTOS]
@@ -779,7 +853,7 @@ void    double_psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
   static double      /* sum[PSF_NPSFMAX]*/ pdeltax[PSF_NPSFMAX],
     pdeltay[PSF_NPSFMAX],psol[PSF_NPSFMAX], pcovmat[PSF_NPSFMAX*PSF_NPSFMAX], 
     pvmat[PSF_NPSFMAX*PSF_NPSFMAX], pwmat[PSF_NPSFMAX],pflux[PSF_NPSFMAX],
-    pfluxerr[PSF_NPSFMAX];
+    pfluxerr[PSF_NPSFMAX], plmat[PSF_NTOT*PSF_NTOT], prhs[PSF_NTOT];
 
     double *pmat,
      *pm, /* *pps,  *px, *py,*/
@@ -787,23 +861,21 @@ void    double_psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
     val, ppix,ppix2, /* dflux, */
     gain, radmin2,radmax2,satlevel
     ,chi2,pwthresh,pbacknoise2, /* mr, */
-    r2=0, dpsf_fwhm,psf_fwhm ;
-  float         **psfmasks, **psfmaskx,**psfmasky, *pps;
-  float         *pdata, *pdata2, *pdata3, *pweight, *pd, *pw, 
-		*pdh, *pwh, pixstep,ppixstep;
+    dpsf_fwhm,psf_fwhm ;
+  float         **psfmasks;
+  float         *pdata, *pweight, *pd, *pw, 
+		*pdh, *pwh, ppixstep;
   PIXTYPE       *pdatah, *pweighth;
-  int                   i,j,k,p, npsf, npix,ix,iy,
+  int                   j,k,p, npsf, npix,ix,iy,
     width, height, /* hw,hh, */
-    x,y, /* yb, */
     wbad, gainflag,
-    ival,npsfmax;
+    ival,npsfmax, nchol, svdflag;
   double *pvar;
   
     static obj2struct   *obj2 = &outobj2;
 
   pdx = pdy =dx = dy = 0.0;
   ppixstep = 1.0/psf->pixstep;
-  pixstep = 1.0/dpsf->pixstep;
   gain = (dfield->gain >0.0? dfield->gain: 1e30);
   npsfmax=prefs.psf_npsfmax;
   pbacknoise2 = field->backsig*field->backsig;
@@ -840,24 +912,15 @@ void    double_psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
   psf_fit(dpsf,dfield, dwfield,obj);
   npsf=thedpsfit->npsf;
   
-  QMALLOC(psfmasks,float *,npsfmax);
-  QMALLOC(psfmaskx,float *,npsfmax);
-  QMALLOC(psfmasky,float *,npsfmax);
 
-  for (i=0; i<npsfmax; i++)
-    {
-      QMALLOC(psfmasks[i],float,npix);
-      QMALLOC(psfmaskx[i],float,npix);
-      QMALLOC(psfmasky[i],float,npix);
-    }
-
-  QMALLOC(pweighth, PIXTYPE, npix);
-  QMALLOC(pweight, float, npix);
-  QMALLOC(pdatah, PIXTYPE, npix);
-  QMALLOC(pdata, float, npix);
-  QMALLOC(pdata2, float, npix);
-  QMALLOC(pdata3, float, npix);
-  QMALLOC(pmat, double, npix*npsfmax);
+/* psf_fit() is done with the scratch buffers: reuse them */
+  psf_fitbuf(thepsfit, npix);
+  psfmasks = thepsfit->psfmasks;
+  pweighth = thepsfit->weighth;
+  pweight = thepsfit->weight;
+  pdatah = thepsfit->datah;
+  pdata = thepsfit->data;
+  pmat = thepsfit->mat;
   
    for (j=0; j<npsf; j++)
     {
@@ -915,60 +978,38 @@ void    double_psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
  
   /* Get the photmetry PSF */
   psf_build(psf);
+  /* Positions are fixed: each new component only adds one column to the */
+  /* system, and one row to its Cholesky factor */
+  nchol = 0;
+  svdflag = 0;
+  pm = pmat;
   for (j=1; j<=npsf; j++)
     {
-      if (j>1)
+      vignet_resample(psf->maskloc, psf->masksize[0], psf->masksize[1],
+			psfmasks[j-1], width, height,
+			-pdeltax[j-1]*ppixstep, -pdeltay[j-1]*ppixstep,
+			ppixstep);
+      pm = compute_gradient_phot(pweight,width,height, psfmasks[j-1],pm);
+      if (!svdflag
+	&& cholfit(pmat, pdata, npix, j, nchol, psol, plmat, prhs)==RETURN_OK)
+        nchol = j;
+      else
         {
-          /*---- Subtract //previously fitted components in photometry image */
-          pd = pdata2;
-          pdh = pdatah;
-          for (p=npix; p--;)
-            *(pd++) = (double)*(pdh++);
-          for (k=0; k<j-1; k++)
-            {
-              pd = pdata2;
-              pps = psfmasks[k];
-              for (p=npix; p--;)
-                *(pd++) -= pflux[k]**(pps++);
-            }
-          convolve_image(field, pdata2, pdata3, width,height);
-         /*---- Ignore regions too close to stellar cores */
-          for (k=0; k<j-1; k++)
-            {
-              pd = pdata3;
-              dy = -((double)(height/2)+pdeltay[k]);
-              for (y=height; y--; dy += 1.0)
-                {
-                  dx = -((double)(width/2)+pdeltax[k]);
-                  for (x=width; x--; dx+= 1.0, pd++)
-                    if (dx*dx+dy*dy<r2) /*?*/
-                      *pd = -BIG;
-                }
-            } 
+/*------ svdfit() overwrites the design matrix: rebuild it after a first pass */
+          if (svdflag)
+            for (pm=pmat, k=0; k<j; k++)
+              pm = compute_gradient_phot(pweight,width,height, psfmasks[k],pm);
+          svdflag = 1;
+          svdfit(pmat, pdata, npix, j, psol, pvmat, pwmat);  
         }
-   
-      pm=pmat;
-      for (k=0; k<j; k++)
-            {
-              /*------ Resample the PSFs here for the 1st iteration */
-              vignet_resample(psf->maskloc,
-			psf->masksize[0], psf->masksize[1],
-			psfmasks[k], width, height,
-			-pdeltax[k]*ppixstep, -pdeltay[k]*ppixstep,
-			ppixstep);              
-              pm=compute_gradient_phot(pweight,width,height, psfmasks[k],pm);
-            }
-      
-      svdfit(pmat, pdata, npix, j, psol, pvmat, pwmat);  
       compute_pos_phot( &j, psol,pflux);
-   
-  for (k=0; k<j; k++)
-        {
-          svdvar(pvmat, pwmat, j, pcovmat);
-          pvar = pcovmat;
-          pfluxerr[k]= sqrt(*pvar)>0.0 && sqrt(*pvar)<99? 
-            sqrt(*pvar):99;
-        }
+      if (svdflag)
+        svdvar(pvmat, pwmat, j, pcovmat);
+      else
+        cholvar(plmat, j, pcovmat);
+      pvar = pcovmat;
+      for (k=0; k<j; k++)
+        pfluxerr[k]= sqrt(*pvar)>0.0 && sqrt(*pvar)<99? sqrt(*pvar):99;
     }
   /* Compute chi2 if asked to 
   if (FLAG(obj2.chi2_psf))
@@ -1024,27 +1065,7 @@ void    double_psf_fit(psfstruct *psf, picstruct *field, picstruct *wfield,
       thepsfit->fluxerr[j] = pfluxerr[j];
     }
     
-  
-  for (i=0; i<npsfmax; i++)
-    {
-      QFREE(psfmasks[i]);
-      QFREE(psfmaskx[i]);
-      QFREE(psfmasky[i]);
-    }
 
-  
-  QFREE(psfmasks);
-  QFREE(psfmaskx);
-  QFREE(psfmasky);
-  QFREE(pdatah);
-  QFREE(pdata);
-  QFREE(pdata2);
-  QFREE(pdata3);
-  QFREE(pweighth);
-  QFREE(pweight);
-  QFREE(pdata);
-  QFREE(pmat);
-   
   if (prefs.check[CHECK_SUBPSFPROTOS] || prefs.check[CHECK_PSFPROTOS]
       || prefs.check[CHECK_SUBPCPROTOS] || prefs.check[CHECK_PCPROTOS]
       || prefs.check[CHECK_PCOPROTOS])
@@ -1672,3 +1693,108 @@ void svdvar(double *v, double *w, int n, double *cov)
   return;
   }
 
+
+
+/******************************** cholfit ************************************/
+/*
+Least-square fit A.x = b through the normal equations, solved by Cholesky
+decomposition. The a matrix is stored column after column, like in svdfit().
+The lower triangular factor is stored in lmat with a PSF_NTOT row length, and
+the right-hand side in rhs: both are kept from one call to the next, so that
+the first nold rows need not be computed again if the first nold columns of a
+are unchanged. Returns RETURN_ERROR if the system is too close to degenerate
+(one should then fall back to svdfit()).
+*/
+int	cholfit(double *a, float *b, int m, int n, int nold, double *sol,
+		double *lmat, double *rhs)
+  {
+   double	*ai,*aj, *li,*lj,
+		s, g;
+   float	*bp;
+   int		i,j,k,p;
+
+  for (i=nold; i<n; i++)
+    {
+    ai = a + i*m;
+    li = lmat + i*PSF_NTOT;
+    for (j=0; j<=i; j++)
+      {
+      aj = a + j*m;
+      g = 0.0;
+      for (p=0; p<m; p++)
+        g += ai[p]*aj[p];
+      lj = lmat + j*PSF_NTOT;
+      s = g;
+      for (k=0; k<j; k++)
+        s -= li[k]*lj[k];
+      if (j<i)
+        li[j] = s/lj[j];
+      else if (g<=0.0 || s<=PSF_CHOLTOL*g)
+        return RETURN_ERROR;
+      else
+        li[i] = sqrt(s);
+      }
+    s = 0.0;
+    bp = b;
+    for (p=0; p<m; p++)
+      s += ai[p]**(bp++);
+    rhs[i] = s;
+    }
+
+/* Forward (L.y = rhs) and back (tL.sol = y) substitutions */
+  for (i=0; i<n; i++)
+    {
+    li = lmat + i*PSF_NTOT;
+    s = rhs[i];
+    for (k=0; k<i; k++)
+      s -= li[k]*sol[k];
+    sol[i] = s/li[i];
+    }
+  for (i=n; i--;)
+    {
+    s = sol[i];
+    for (k=i+1; k<n; k++)
+      s -= lmat[k*PSF_NTOT+i]*sol[k];
+    sol[i] = s/lmat[i*PSF_NTOT+i];
+    }
+
+  return RETURN_OK;
+  }
+
+
+/******************************** cholvar ************************************/
+/*
+Computation of the covariance matrix (tA.A)^-1 from the Cholesky factor of
+the normal equations provided by cholfit().
+*/
+void	cholvar(double *lmat, int n, double *cov)
+  {
+   static double	linv[PSF_NTOT*PSF_NTOT];
+   double		s;
+   int			i,j,k;
+
+/* Invert the lower triangular factor */
+  for (j=0; j<n; j++)
+    {
+    linv[j*n+j] = 1.0/lmat[j*PSF_NTOT+j];
+    for (i=j+1; i<n; i++)
+      {
+      s = 0.0;
+      for (k=j; k<i; k++)
+        s -= lmat[i*PSF_NTOT+k]*linv[k*n+j];
+      linv[i*n+j] = s/lmat[i*PSF_NTOT+i];
+      }
+    }
+
+/* cov = tLinv.Linv */
+  for (i=0; i<n; i++)
+    for (j=0; j<=i; j++)
+      {
+      for (s=0.0,k=i; k<n; k++)
+        s += linv[k*n+i]*linv[k*n+j];
+      cov[j*n+i] = cov[i*n+j] = s;
+      }
+
+  return;
+  }
+
@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		15/07/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -36,6 +36,7 @@
 #define PSF_NTOT	(PSF_NA*PSF_NPSFMAX)	/* Number of fitted parameters*/
 #define PSF_DOUBLETOT   ((PSF_NA+1)*PSF_NPSFMAX)/* Nb of fitted parameters */
 #define	PC_NITER	1	/* Maximum number of iterations in PC fit */
+#define	PSF_CHOLTOL	1e-12	/* Min. relative pivot in Cholesky solutions */
 
 /* NOTES:
 One must have:	PSF_MAXSHIFT > 0.0
@@ -102,6 +103,14 @@ typedef struct
   double	*x,*y;		/* Position derived from the PSF-fitting */
   float		*flux;		/* Flux derived from the PSF-fitting */
   float		*fluxerr;	/* Flux error estimated from the PSF-fitting */
+/* Scratch buffers, kept from one object to the next */
+  int		npixmax;	/* Number of pixels allocated in buffers */
+  float		**psfmasks;	/* Resampled PSFs */
+  float		**psfmaskx;	/* Resampled PSF x-gradients */
+  float		**psfmasky;	/* Resampled PSF y-gradients */
+  PIXTYPE	*datah, *weighth;/* Copies of the data and weight pixels */
+  float		*data, *data2, *data3, *weight;	/* Work vectors */
+  double	*mat;		/* Design matrix */
   }	psfitstruct;
 
 /*----------------------------- Global variables ----------------------------*/
@@ -117,9 +126,12 @@ extern void	compute_pos(int *pnpsf,int *pconvflag,int *pnpsfflag,
 		compute_pos_phot(int *pnpsf,double *sol,double *flux),
 		compute_poserr(int j,double *var,double *sol,obj2struct *obj2,
 			double *x2, double *y2,double *xy, int npsf),
+		cholvar(double *lmat, int n, double *covmat),
 		psf_build(psfstruct *psf),
 		psf_end(psfstruct *psf, psfitstruct *psfit),
+		psf_fitbuf(psfitstruct *psfit, int npix),
 		psf_init(void),
+		psf_initcontext(psfstruct *psf),
 		svdfit(double *a, float *b, int m, int n, double *sol,
 			double *vmat, double *wmat),
 		svdvar(double *vmat, double *wmat, int n, double *covmat);
@@ -131,6 +143,9 @@ extern double	*compute_gradient (float *weight,int width, int height,
 			float *masks, double *pm),
 		psf_fwhm(psfstruct *psf);
 
+extern int	cholfit(double *a, float *b, int m, int n, int nold,
+			double *sol, double *lmat, double *rhs);
+
 extern psfstruct	*psf_load(char *filename, int ext);
 
 extern void	pc_end(pcstruct *pc),
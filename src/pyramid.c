@@ -0,0 +1,421 @@
+/*
+*				pyramid.c
+*
+* Decimated image pyramids for fast background estimation.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifdef HAVE_CONFIG_H
+#include        "config.h"
+#endif
+
+#include	<math.h>
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+#include	<sys/stat.h>
+
+#include	"define.h"
+#include	"globals.h"
+#include	"prefs.h"
+#include	"fits/fitscat.h"
+#include	"back.h"
+#include	"pyramid.h"
+#include	"weight.h"
+
+static PIXTYPE	*pyr_make(picstruct *field, char *name, int fac,
+			int *pw, int *ph);
+
+/****** pyr_name *************************************************************
+PROTO	void pyr_name(picstruct *field, char *name)
+PURPOSE	Build the filename of the pyramid sidecar file of an image.
+INPUT	Pointer to the field,
+	pointer to the output filename string (MAXCHAR long).
+OUTPUT	-.
+NOTES	The image extension number is appended for Multi-Extension files.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	pyr_name(picstruct *field, char *name)
+  {
+   tabstruct	*tab;
+   char		*pstr;
+   int		ext;
+
+  strcpy(name, field->filename);
+  if (!(pstr = strrchr(name, '.')) || strchr(pstr, '/'))
+    pstr = name+strlen(name);
+/* Find the position of the image in the file */
+  for (ext=0, tab=field->cat->tab; tab!=field->tab; tab=tab->nexttab)
+    ext++;
+  if (field->cat->ntab>1)
+    sprintf(pstr, "%s_%d.fits", PYR_SUFFIX, ext);
+  else
+    sprintf(pstr, "%s.fits", PYR_SUFFIX);
+
+  return;
+  }
+
+
+/****** pyr_srcid ************************************************************
+PROTO	void pyr_srcid(picstruct *field, char *srcid)
+PURPOSE	Build a string identifying the content of an image file.
+INPUT	Pointer to the field,
+	pointer to the output identifier string (MAXCHAR long).
+OUTPUT	-.
+NOTES	The identifier is made from the file size and modification time, and
+	from the image dimensions.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	pyr_srcid(picstruct *field, char *srcid)
+  {
+   struct stat	st;
+
+  if (stat(field->filename, &st))
+    st.st_size = st.st_mtime = 0;
+  sprintf(srcid, "%lld:%lld:%dx%d",
+	(long long)st.st_size, (long long)st.st_mtime,
+	field->width, field->height);
+
+  return;
+  }
+
+
+/****** pyr_factor ***********************************************************
+PROTO	int pyr_factor(picstruct *field)
+PURPOSE	Find the coarsest pyramid level suitable for the background meshes.
+INPUT	Pointer to the field.
+OUTPUT	Decimation factor, or 0 if no level is suitable.
+NOTES	The decimation factor must divide the mesh width and height, and leave
+	at least PYR_MINPIX pixels per decimated mesh.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	pyr_factor(picstruct *field)
+  {
+   int	l, fac;
+
+  for (l=PYR_NLEVEL; l--;)
+    {
+    fac = PYR_MINFAC<<l;
+    if (!(field->backw%fac) && !(field->backh%fac)
+	&& (field->backw/fac)*(field->backh/fac) >= PYR_MINPIX)
+      return fac;
+    }
+
+  return 0;
+  }
+
+
+/****** pyr_read *************************************************************
+PROTO	PIXTYPE *pyr_read(picstruct *field, int fac, int *pw, int *ph)
+PURPOSE	Load one level of the decimated image pyramid of a field, building and
+	saving the pyramid sidecar file first if it is missing or outdated.
+INPUT	Pointer to the field,
+	decimation factor,
+	pointer to the decimated width (output),
+	pointer to the decimated height (output).
+OUTPUT	Pointer to the decimated image.
+NOTES	Pixel values are stored as read from the original image (BLANKed pixels
+	are set to -BIG).
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+PIXTYPE	*pyr_read(picstruct *field, int fac, int *pw, int *ph)
+  {
+   catstruct	*cat;
+   tabstruct	*tab;
+   PIXTYPE	*buf;
+   char		name[MAXCHAR], srcid[MAXCHAR], str[MAXCHAR];
+   int		t, tfac;
+
+  pyr_name(field, name);
+  pyr_srcid(field, srcid);
+  buf = NULL;
+  if ((cat = read_cat(name)))
+    {
+    if (fitsread(cat->tab->headbuf, "PYRSRCID", str, H_STRING, T_STRING)
+		== RETURN_OK && !strcmp(str, srcid))
+      {
+      tab = cat->tab;
+      for (t=cat->ntab; t--; tab=tab->nexttab)
+        if (tab->naxis==2 && fitsread(tab->headbuf, "PYRFAC  ", &tfac,
+		H_INT, T_LONG) == RETURN_OK && tfac == fac)
+          {
+          sprintf(gstr, "Loading background pyramid level %d", fac);
+          NFPRINTF(OUTPUT, gstr);
+          *pw = tab->naxisn[0];
+          *ph = tab->naxisn[1];
+          QMALLOC(buf, PIXTYPE, (size_t)*pw**ph);
+          QFSEEK(cat->file, tab->bodypos, SEEK_SET, cat->filename);
+#ifdef	HAVE_CFITSIO
+          tab->currentElement = 1;
+#endif
+          read_body(tab, buf, (size_t)*pw**ph);
+          break;
+          }
+      }
+    free_cat(&cat, 1);
+    }
+
+  if (!buf)
+    buf = pyr_make(field, name, fac, pw, ph);
+
+  return buf;
+  }
+
+
+/****** pyr_make *************************************************************
+PROTO	PIXTYPE *pyr_make(picstruct *field, char *name, int fac,
+		int *pw, int *ph)
+PURPOSE	Build the decimated image pyramid of a field in a single pass through
+	the data, and save it as a sidecar FITS file.
+INPUT	Pointer to the field,
+	sidecar filename,
+	decimation factor of the level to be returned,
+	pointer to the decimated width (output),
+	pointer to the decimated height (output).
+OUTPUT	Pointer to the requested decimated image.
+NOTES	Level l holds one pixel every PYR_MINFAC*2^l along both axes. Failing
+	to write the sidecar file only triggers a warning. The position in the
+	image file is preserved.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static PIXTYPE	*pyr_make(picstruct *field, char *name, int fac,
+			int *pw, int *ph)
+  {
+   catstruct	*cat;
+   tabstruct	*tab;
+   PIXTYPE	*lbuf[PYR_NLEVEL],
+		*line, *pix, *lpix, *buf;
+   OFF_T2	fcurpos;
+#ifdef	HAVE_CFITSIO
+   OFF_T2	currentElement;
+#endif
+   char		srcid[MAXCHAR];
+   size_t	npix;
+   int		lw[PYR_NLEVEL], lh[PYR_NLEVEL], lfac[PYR_NLEVEL],
+		l, x,y, w,h, nlevel;
+
+  w = field->width;
+  h = field->height;
+  NFPRINTF(OUTPUT, "Building background pyramid");
+  for (l=0; l<PYR_NLEVEL; l++)
+    {
+    lfac[l] = PYR_MINFAC<<l;
+    lw[l] = (w + lfac[l] - 1)/lfac[l];
+    lh[l] = (h + lfac[l] - 1)/lfac[l];
+    QMALLOC(lbuf[l], PIXTYPE, (size_t)lw[l]*lh[l]);
+    }
+
+/* Read the full image once, line by line */
+  QMALLOC(line, PIXTYPE, w);
+  QFTELL(field->file, fcurpos, field->filename);
+  QFSEEK(field->file, field->tab->bodypos, SEEK_SET, field->filename);
+#ifdef	HAVE_CFITSIO
+  currentElement = field->tab->currentElement;
+  field->tab->currentElement = 1;
+#endif
+  for (y=0; y<h; y++)
+    {
+    read_body(field->tab, line, w);
+    for (l=0; l<PYR_NLEVEL && !(y%lfac[l]); l++)
+      {
+      pix = line;
+      lpix = lbuf[l] + (size_t)(y/lfac[l])*lw[l];
+      for (x=lw[l]; x--; pix+=lfac[l])
+        *(lpix++) = *pix;
+      }
+    }
+  free(line);
+  QFSEEK(field->file, fcurpos, SEEK_SET, field->filename);
+#ifdef	HAVE_CFITSIO
+  field->tab->currentElement = currentElement;
+#endif
+
+/* Save the pyramid in a Multi-Extension FITS file */
+  cat = new_cat(1);
+  init_cat(cat);
+  strcpy(cat->filename, name);
+  tab = cat->tab;
+  tab->cat = cat;
+  nlevel = PYR_NLEVEL;
+  pyr_srcid(field, srcid);
+  addkeywordto_head(tab, "NEXTEND ", "Number of extensions");
+  fitswrite(tab->headbuf, "NEXTEND ", &nlevel, H_INT, T_LONG);
+  addkeywordto_head(tab, "PYRSRCID", "Identifier of the source image");
+  fitswrite(tab->headbuf, "PYRSRCID", srcid, H_STRING, T_STRING);
+  if (open_cat(cat, WRITE_ONLY) != RETURN_OK)
+    warning("Cannot save background pyramid to ", name);
+  else
+    {
+    save_head(cat, tab);
+    ext_head(tab);
+    removekeywordfrom_head(tab, "NEXTEND ");
+    removekeywordfrom_head(tab, "PYRSRCID");
+    addkeywordto_head(tab, "PYRFAC  ", "Pyramid decimation factor");
+    tab->bitpix = BP_FLOAT;
+    tab->bytepix = 4;
+    tab->bitsgn = 0;
+    tab->bscale = 1.0;
+    tab->bzero = 0.0;
+    tab->naxis = 2;
+    QMALLOC(tab->naxisn, int, 2);
+    for (l=0; l<PYR_NLEVEL; l++)
+      {
+      tab->naxisn[0] = lw[l];
+      tab->naxisn[1] = lh[l];
+      fitswrite(tab->headbuf, "PYRFAC  ", &lfac[l], H_INT, T_LONG);
+      npix = (size_t)lw[l]*lh[l];
+      save_head(cat, tab);
+      write_body(tab, lbuf[l], npix);
+      pad_tab(cat, npix*sizeof(PIXTYPE));
+      }
+    close_cat(cat);
+    }
+  free_cat(&cat, 1);
+
+/* Keep only the requested level */
+  buf = NULL;
+  for (l=0; l<PYR_NLEVEL; l++)
+    if (lfac[l] == fac)
+      {
+      buf = lbuf[l];
+      *pw = lw[l];
+      *ph = lh[l];
+      }
+    else
+      free(lbuf[l]);
+
+  if (!buf)
+    error(EXIT_FAILURE, "*Internal Error*: no such pyramid level in ",
+	"pyr_make()");
+
+  return buf;
+  }
+
+
+/****** pyr_back *************************************************************
+PROTO	int pyr_back(picstruct *field, picstruct *wfield)
+PURPOSE	Compute the background and background noise meshes of a field (and of
+	its weight-map) from a decimated level of the image pyramid.
+INPUT	Pointer to the field,
+	pointer to the weight-map field (or NULL).
+OUTPUT	RETURN_OK if the meshes were computed, RETURN_ERROR if no pyramid level
+	is suitable for the current mesh size.
+NOTES	The back and sigma maps must have been allocated by the caller.
+	Filtering of the meshes is left to the caller.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	pyr_back(picstruct *field, picstruct *wfield)
+  {
+   backstruct	*backmesh,*wbackmesh, *bm,*wbm;
+   PIXTYPE	*buf,*wbuf;
+   size_t	bufsize;
+   int		fac, pw,ph, wpw,wph, bw,bh, nx,ny, j,k,m, nlines;
+
+  if (!(fac = pyr_factor(field)))
+    return RETURN_ERROR;
+
+  buf = pyr_read(field, fac, &pw, &ph);
+  wbuf = NULL;
+  wbackmesh = NULL;
+  if (wfield)
+    {
+    wbuf = pyr_read(wfield, fac, &wpw, &wph);
+    if (wpw!=pw || wph!=ph)
+      error(EXIT_FAILURE, "*Error*: background pyramid size mismatch for ",
+		wfield->filename);
+    weight_to_var(wfield, wbuf, pw*ph);
+    }
+
+  bw = field->backw/fac;
+  bh = field->backh/fac;
+  nx = field->nbackx;
+  ny = field->nbacky;
+  QMALLOC(backmesh, backstruct, nx);
+  if (wfield)
+    QMALLOC(wbackmesh, backstruct, nx);
+
+  NFPRINTF(OUTPUT, "Setting up background maps from pyramid");
+  for (j=0; j<ny; j++)
+    {
+    nlines = ph - j*bh;
+    if (nlines>bh)
+      nlines = bh;
+    bufsize = (size_t)nlines*pw;
+    backstat(backmesh, wbackmesh, buf+(size_t)j*bh*pw,
+	wbuf? wbuf+(size_t)j*bh*pw : NULL, bufsize, nx, pw, bw,
+	wfield?wfield->weight_thresh:0.0);
+    bm = backmesh;
+    for (m=nx; m--; bm++)
+      if (bm->mean <= -BIG)
+        bm->histo=NULL;
+      else
+        QCALLOC(bm->histo, LONG, bm->nlevels);
+    if (wfield)
+      {
+      wbm = wbackmesh;
+      for (m=nx; m--; wbm++)
+        if (wbm->mean <= -BIG)
+          wbm->histo=NULL;
+        else
+          QCALLOC(wbm->histo, LONG, wbm->nlevels);
+      }
+    backhisto(backmesh, wbackmesh, buf+(size_t)j*bh*pw,
+	wbuf? wbuf+(size_t)j*bh*pw : NULL, bufsize, nx, pw, bw,
+	wfield?wfield->weight_thresh:0.0);
+    bm = backmesh;
+    for (m=0; m<nx; m++, bm++)
+      {
+      k = m+nx*j;
+      backguess(bm, field->back+k, field->sigma+k);
+      free(bm->histo);
+      }
+    if (wfield)
+      {
+      wbm = wbackmesh;
+      for (m=0; m<nx; m++, wbm++)
+        {
+        k = m+nx*j;
+        backguess(wbm, wfield->back+k, wfield->sigma+k);
+        free(wbm->histo);
+        }
+      }
+    }
+
+  free(backmesh);
+  free(buf);
+  if (wfield)
+    {
+    free(wbackmesh);
+    free(wbuf);
+    }
+
+  return RETURN_OK;
+  }
+
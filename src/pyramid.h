@@ -0,0 +1,51 @@
+#pragma once
+/*
+*				pyramid.h
+*
+* Include file for pyramid.c.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/*----------------------------- Internal constants --------------------------*/
+
+#define	PYR_NLEVEL	4	/* Number of decimated levels in the pyramid */
+#define	PYR_MINFAC	4	/* Decimation factor of the finest level */
+#define	PYR_MINPIX	4096	/* Min. number of pixels per decimated mesh */
+#define	PYR_SUFFIX	".pyr"	/* Suffix of pyramid sidecar files */
+
+/* NOTES:
+One must have:
+	PYR_NLEVEL >= 1
+	PYR_MINFAC >= 2
+	PYR_MINPIX >= 1
+*/
+
+/*------------------------------- functions ---------------------------------*/
+extern PIXTYPE	*pyr_read(picstruct *field, int fac, int *pw, int *ph);
+
+extern int	pyr_back(picstruct *field, picstruct *wfield),
+		pyr_factor(picstruct *field);
+
+extern void	pyr_name(picstruct *field, char *name),
+		pyr_srcid(picstruct *field, char *srcid);
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		23/09/2020
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -30,6 +30,9 @@
 #include        "config.h"
 #endif
 
+#ifdef HAVE_POSIX_FADVISE
+#include	<fcntl.h>
+#endif
 #include	<math.h>
 #include	<stdio.h>
 #include	<stdlib.h>
@@ -275,6 +278,66 @@ void	*loadstrip(picstruct *field, picstruct *wfield)
   }
 
 
+/****************************** prefetchstrips *******************************/
+/*
+Ask the system to read ahead the next block of lines of all the image streams
+involved in the scan, so that these are fetched concurrently instead of one
+synchronous read after the other.
+*/
+void	prefetchstrips(picstruct **pfield, int nfield)
+
+  {
+#ifdef HAVE_POSIX_FADVISE
+   picstruct	*field;
+   tabstruct	*tab;
+   OFF_T2	linesize;
+   int		i, p, ynext, yend, nlines, refill;
+
+/* Top-up all streams together as soon as one of them runs low */
+  for (refill=p=0; p<2; p++)
+    for (i=0; i<nfield; i++)
+      {
+      field = pfield[i];
+      tab = field->tab;
+      if (!field->file || field->yprefetch>=field->height)
+        continue;
+#ifdef HAVE_CFITSIO
+      if (tab->isTileCompressed)
+        continue;
+#endif
+      linesize = (OFF_T2)field->width*tab->bytepix;
+      if ((nlines = PREFETCH_SIZE/linesize) < 1)
+        nlines = 1;
+/*---- ymax is only meaningful once the first strip has been loaded */
+      ynext = field->yprefetch? field->ymax : 0;
+      if (!p)
+        {
+        if (ynext + nlines/2 >= field->yprefetch)
+          refill = 1;
+        continue;
+        }
+      if (!refill)
+        return;
+      if ((yend = ynext + nlines) > field->height)
+        yend = field->height;
+      if (yend <= field->yprefetch)
+        continue;
+      posix_fadvise(fileno(field->file),
+		tab->bodypos + field->yprefetch*linesize,
+		(yend - field->yprefetch)*linesize, POSIX_FADV_WILLNEED);
+/*---- Differential geometry maps have a second plane for y shifts */
+      if (field->flags & DGEO_FIELD)
+        posix_fadvise(fileno(field->file),
+		tab->bodypos + (field->height + field->yprefetch)*linesize,
+		(yend - field->yprefetch)*linesize, POSIX_FADV_WILLNEED);
+      field->yprefetch = yend;
+      }
+#endif
+
+  return;
+  }
+
+
 /******************************** copydata **********************************/
 /*
 Copy image data from one field to the other.
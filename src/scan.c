@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		13/01/2016
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -38,6 +38,7 @@
 #include	"define.h"
 #include	"globals.h"
 #include	"prefs.h"
+#include	"fits/fitscat.h"
 #include	"back.h"
 #include	"check.h"
 #include	"clean.h"
@@ -47,6 +48,14 @@
 #include	"plist.h"
 #include	"weight.h"
 
+static int		scan_skipbkg(PIXTYPE *cdscan, char *marker, int xl, int w,
+				PIXTYPE thresh);
+
+#ifdef VEC_X86
+static VEC_AVX2 int	scan_skipbkg_avx2(PIXTYPE *cdscan, char *marker, int xl,
+				int w, PIXTYPE thresh);
+#endif
+
 /****************************** scanimage ************************************
 PROTO   void scanimage(picstruct *field, picstruct *dfield, picstruct *ffield,
         picstruct *wfield, picstruct *dwfield, picstruct *dgeofield)
@@ -59,7 +68,7 @@ INPUT   Measurement field pointer,
 OUTPUT  -.
 NOTES   -.
 AUTHOR  E. Bertin (IAP)
-VERSION 14/01/2015
+VERSION 19/10/2026
  ***/
 void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
 		int nffield, picstruct *wfield, picstruct *dwfield,
@@ -73,11 +82,11 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
    objliststruct       	objlist;
    objstruct		*cleanobj;
    pliststruct		*pixel, *pixt;
-   picstruct		*cfield, *cdwfield;
+   picstruct		*cfield, *cdwfield, *pfield[MAXFLAG+5];
 
    char			*marker, newmarker, *blankpad, *bpt,*bpt0;
-   int			co, i,j, flag, luflag,pstop, xl,xl2,yl, cn,
-			nposize, stacksize, w, h, blankh, maxpixnb,
+   int			co, i,j, flag, luflag,pstop, xl,xl2,xn,yl, cn, npfield,
+			nposize, npomax, npo, stacksize, w, h, blankh, maxpixnb,
 			varthreshflag, ontotal;
    short	       	trunflag;
    PIXTYPE		thresh, relthresh, cdnewsymbol, cdwthresh,wthresh,
@@ -96,6 +105,7 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
   blankh = 0;				/* Avoid gcc -Wall warnings */
 /*----- Beginning of the main loop: Initialisations  */
   thecat.ntotal = thecat.ndetect = 0;
+  thecat.nobjstack = 0;
 
 /* cfield is the detection field in any case */
   cfield = dfield? dfield:field;
@@ -152,6 +162,22 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
     dgeofield->stripysclim = 0;
   }
 
+/* Gather all the image streams for read-ahead */
+  npfield = 0;
+  pfield[npfield++] = field;
+  if (dfield)
+    pfield[npfield++] = dfield;
+  if (wfield)
+    pfield[npfield++] = wfield;
+  if (dwfield)
+    pfield[npfield++] = dwfield;
+  for (i=0; i<nffield; i++)
+    pfield[npfield++] = pffield[i];
+  if (dgeofield)
+    pfield[npfield++] = dgeofield;
+  for (i=0; i<npfield; i++)
+    pfield[i]->yprefetch = 0;
+
 /*Allocate memory for buffers */
   stacksize = w+1;
   QMALLOC(info, infostruct, stacksize);
@@ -188,7 +214,13 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
 /*----- Allocate memory for the pixel list */
   init_plist();
 
-  if (!(pixel = objlist.plist = malloc(nposize=prefs.mem_pixstack*plistsize)))
+/*----- With a memory budget, the pixel stack starts small and grows on demand */
+  npomax = (prefs.mem_limit > 0.0? prefs.mem_pixstackmax : prefs.mem_pixstack)
+		* plistsize;
+  nposize = prefs.mem_pixstack*plistsize;
+  if (nposize > npomax)
+    nposize = npomax;
+  if (!(pixel = objlist.plist = malloc(nposize)))
     error(EXIT_FAILURE, "Not enough memory to store the pixel stack:\n",
         "           Try to decrease MEMORY_PIXSTACK");
 
@@ -252,6 +284,8 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
       }
     else
       {
+/*---- Request the next block of lines of all image streams together */
+      prefetchstrips(pfield, npfield);
       if (nffield)
         for (i=0; i<nffield; i++)
           {
@@ -357,6 +391,17 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
 
     for (xl=0; xl<=w; xl++)
       {
+/*---- Outside of segments, jump over background pixels without markers */
+      if (cs == NONOBJECT && !varthreshflag && xl<w)
+        {
+        xn = scan_skipbkg(cdscan, marker, xl, w, thresh);
+        if (xn>xl && prefs.blank_flag && prefs.filter_flag)
+          {
+          memset(bpt, 0, (size_t)(xn-xl));
+          bpt += xn-xl;
+          }
+        xl = xn;
+        }
       if (xl == w)
         cdnewsymbol = -BIG;
       else
@@ -377,6 +422,21 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
         pixt = pixel + (cn=freeinfo.firstpix);
         freeinfo.firstpix = PLIST(pixt, nextpix);
 
+/*------- Running out of pixels: extend the stack within the memory budget */
+        if (freeinfo.firstpix==freeinfo.lastpix && nposize<npomax)
+          {
+          npo = nposize;
+          nposize = (npomax-nposize > nposize)? 2*nposize : npomax;
+          if (!(pixel = objlist.plist = realloc(pixel, nposize)))
+            error(EXIT_FAILURE, "Not enough memory to extend the pixel stack:"
+		"\n", "           Try to decrease MEMORY_LIMIT");
+          pixt = pixel + cn;
+          freeinfo.firstpix = npo;
+          for (i=npo; i<nposize-plistsize; i += plistsize)
+            PLIST(pixel+i, nextpix) = i + plistsize;
+          PLIST(pixel+i, nextpix) = freeinfo.lastpix;
+          }
+
 /*------- Running out of pixels, the largest object becomes a "victim" ------*/
 
         if (freeinfo.firstpix==freeinfo.lastpix)
@@ -721,12 +781,18 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
 
   endclean();
 
+/* Memory usage statistics */
+  thecat.npixstack = nposize/plistsize;
+  thecat.mempeak = thecat.memfield + (double)nposize
+		+ (double)thecat.nobjstack*sizeof(objstruct);
+
 /*Free memory */
   if (prefs.filter_flag && cdwfield && PLISTEXIST(wflag))
     free(cdwscanp);
   freeparcelout();
   free(pixel);
   lutzfree();
+  end_compactplist();
   free(info);
   free(store);
   free(marker);
@@ -741,6 +807,87 @@ void	scanimage(picstruct *field, picstruct *dfield, picstruct **pffield,
   }
 
 
+/****** scan_skipbkg *********************************************************
+PROTO	int scan_skipbkg(PIXTYPE *cdscan, char *marker, int xl, int w,
+			PIXTYPE thresh)
+PURPOSE	Find the next pixel on the current line that must go through Lutz'
+	state machine, that is, a pixel above the detection threshold or a pixel
+	with a marker left by the previous line.
+INPUT	Pointer to the filtered detection line,
+	pointer to the marker array,
+	starting x,
+	line width,
+	detection threshold.
+OUTPUT	Position of the next pixel to process (w if none).
+NOTES	Must only be called outside of segments, with a constant threshold.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static int	scan_skipbkg(PIXTYPE *cdscan, char *marker, int xl, int w,
+			PIXTYPE thresh)
+  {
+#ifdef VEC_X86
+  if (vec_getlevel() >= VEC_LEVEL_AVX2)
+    return scan_skipbkg_avx2(cdscan, marker, xl, w, thresh);
+#endif
+
+  for (; xl<w; xl++)
+    if (marker[xl] || cdscan[xl] > thresh)
+      break;
+
+  return xl;
+  }
+
+
+#ifdef VEC_X86
+/****** scan_skipbkg_avx2 ****************************************************
+PROTO	int scan_skipbkg_avx2(PIXTYPE *cdscan, char *marker, int xl, int w,
+			PIXTYPE thresh)
+PURPOSE	AVX2 version of scan_skipbkg().
+INPUT	Pointer to the filtered detection line,
+	pointer to the marker array,
+	starting x,
+	line width,
+	detection threshold.
+OUTPUT	Position of the next pixel to process (w if none).
+NOTES	32 pixels are tested at once; the first hit is located with a
+	trailing zero count on the comparison bitmask.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static VEC_AVX2 int	scan_skipbkg_avx2(PIXTYPE *cdscan, char *marker, int xl,
+			int w, PIXTYPE thresh)
+  {
+   __m256		vthresh;
+   __m256i		vzero;
+   unsigned int		mask;
+
+  vthresh = _mm256_set1_ps(thresh);
+  vzero = _mm256_setzero_si256();
+  for (; xl<=w-32; xl+=32)
+    {
+    mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+		_mm256_loadu_si256((__m256i *)(marker+xl)), vzero))
+	| (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(
+		_mm256_loadu_ps(cdscan+xl), vthresh, _CMP_GT_OQ))
+	| (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(
+		_mm256_loadu_ps(cdscan+xl+8), vthresh, _CMP_GT_OQ)) << 8
+	| (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(
+		_mm256_loadu_ps(cdscan+xl+16), vthresh, _CMP_GT_OQ)) << 16
+	| (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(
+		_mm256_loadu_ps(cdscan+xl+24), vthresh, _CMP_GT_OQ)) << 24;
+    if (mask)
+      return xl + __builtin_ctz(mask);
+    }
+  for (; xl<w; xl++)
+    if (marker[xl] || cdscan[xl] > thresh)
+      break;
+
+  return xl;
+  }
+#endif
+
+
 /********************************* update ************************************/
 /*
 update object's properties each time one of its pixels is scanned by lutz()
@@ -828,10 +975,18 @@ void  sortit(picstruct *field, picstruct *dfield, picstruct *wfield,
 
   for (i=0; i<objlist2->nobj; i++)
     {
+/*-- Large objects are measured from contiguous copies of their pixels */
+    if (prefs.mem_compactarea
+	&& objlist2->obj[i].fdnpix >= prefs.mem_compactarea)
+      compact_plist(objlist2, i);
     preanalyse(i, objlist2, ANALYSE_FULL|ANALYSE_ROBUST);
     if (prefs.ext_maxarea && objlist2->obj[i].fdnpix > prefs.ext_maxarea)
+      {
+      reset_compactplist();
       continue; 
+      }
     analyse(field, dfield, i, objlist2);
+    reset_compactplist();
     cobj = objlist2->obj + i;
     if (prefs.blank_flag)
       {
@@ -886,7 +1041,11 @@ void  sortit(picstruct *field, picstruct *dfield, picstruct *wfield,
 
 /* Only add the object if it is not swallowed by cleaning */
     if (!prefs.clean_flag || clean(field, dfield, i, objlist2))
+      {
       addcleanobj(cobj);
+      if (cleanobjlist->nobj > thecat.nobjstack)
+        thecat.nobjstack = cleanobjlist->nobj;
+      }
     }
 
   free(objlistout.plist);
@@ -912,12 +1071,13 @@ void  preanalyse(int no, objliststruct *objlist, int analyse_type)
   {
    objstruct	*obj = &objlist->obj[no];
    pliststruct	*pixel = objlist->plist, *pixt;
+   plistsoastruct	*soa;
    PIXTYPE	peak, cpeak, val, cval, minthresh, thresht, dx, dy;
    double	thresh,thresh2, t1t2,darea,
 		mx,my, mx2,my2,mxy, rv, tv, mdx, mdy,
 		xm,ym, xm2,ym2,xym,
 		temp,temp2, theta,pmx2,pmy2;
-   int		x, y, xmin,xmax, ymin,ymax,area2, fdnpix, dnpix;
+   int		x, y, xmin,xmax, ymin,ymax,area2, fdnpix, dnpix, p;
   
 
 /*-----  initialize stacks and bounds */
@@ -933,28 +1093,58 @@ void  preanalyse(int no, objliststruct *objlist, int analyse_type)
   ymax = xmax = 0;
 
 /*-----  integrate results */
-  for (pixt=pixel+obj->firstpix; pixt>=pixel; pixt=pixel+PLIST(pixt,nextpix))
+  soa = get_compactplist(pixel, obj);
+  if (soa)
     {
-    x = PLIST(pixt, x);
-    y = PLIST(pixt, y);
-    val=PLISTPIX(pixt, dvalue);
-    if (cpeak < (cval=PLISTPIX(pixt, cdvalue)))
-      cpeak = cval;
-    if (PLISTEXIST(dthresh) && (thresht=PLISTPIX(pixt, dthresh))<minthresh)
-      minthresh = thresht;
-    if (peak < val)
-      peak = val;
-    rv += cval;
-    if (xmin > x)
-      xmin = x;
-    if (xmax < x)
-      xmax = x;
-    if (ymin > y)
-      ymin = y;
-    if (ymax < y)
-      ymax = y;
-    fdnpix++;
+    for (p=0; p<soa->npix; p++)
+      {
+      x = soa->x[p];
+      y = soa->y[p];
+      val = soa->dvalue[p];
+      if (cpeak < (cval=soa->cdvalue[p]))
+        cpeak = cval;
+      if (peak < val)
+        peak = val;
+      rv += cval;
+      if (xmin > x)
+        xmin = x;
+      if (xmax < x)
+        xmax = x;
+      if (ymin > y)
+        ymin = y;
+      if (ymax < y)
+        ymax = y;
+      }
+    if (PLISTEXIST(dthresh))
+      for (p=0; p<soa->npix; p++)
+        if ((thresht=soa->dthresh[p])<minthresh)
+          minthresh = thresht;
+    fdnpix = soa->npix;
     }
+  else
+    for (pixt=pixel+obj->firstpix; pixt>=pixel;
+	pixt=pixel+PLIST(pixt,nextpix))
+      {
+      x = PLIST(pixt, x);
+      y = PLIST(pixt, y);
+      val=PLISTPIX(pixt, dvalue);
+      if (cpeak < (cval=PLISTPIX(pixt, cdvalue)))
+        cpeak = cval;
+      if (PLISTEXIST(dthresh) && (thresht=PLISTPIX(pixt, dthresh))<minthresh)
+        minthresh = thresht;
+      if (peak < val)
+        peak = val;
+      rv += cval;
+      if (xmin > x)
+        xmin = x;
+      if (xmax < x)
+        xmax = x;
+      if (ymin > y)
+        ymin = y;
+      if (ymax < y)
+        ymax = y;
+      fdnpix++;
+      }
 
   if (PLISTEXIST(dthresh))
     obj->dthresh = thresh = minthresh;
@@ -976,22 +1166,47 @@ void  preanalyse(int no, objliststruct *objlist, int analyse_type)
     mx2 = my2 = mxy = 0.0;
     thresh2 = (thresh + peak)/2.0;
     area2 = 0;
-    for (pixt=pixel+obj->firstpix; pixt>=pixel; pixt=pixel+PLIST(pixt,nextpix))
-      {
-      cval = PLISTPIX(pixt, cdvalue);
-      tv += (val = PLISTPIX(pixt, dvalue));
-      if (val>thresh)
-        dnpix++;
-      if (val > thresh2)
-        area2++;
-      x = PLIST(pixt,x)-xmin;	/* avoid roundoff errors on big images */
-      y = PLIST(pixt,y)-ymin;	/* avoid roundoff errors on big images */
-      if PLISTEXIST(dgeo) {
-        x -= (dx = PLISTPIX(pixt, dgeox));
-        y -= (dy = PLISTPIX(pixt, dgeoy));
-        mdx += cval * dx;
-        mdy += cval * dy;
-      }
+    if (soa)
+      for (p=0; p<soa->npix; p++)
+        {
+        cval = soa->cdvalue[p];
+        tv += (val = soa->dvalue[p]);
+        if (val>thresh)
+          dnpix++;
+        if (val > thresh2)
+          area2++;
+        x = soa->x[p]-xmin;
+        y = soa->y[p]-ymin;
+        if PLISTEXIST(dgeo) {
+          x -= (dx = soa->dgeox[p]);
+          y -= (dy = soa->dgeoy[p]);
+          mdx += cval * dx;
+          mdy += cval * dy;
+        }
+        mx += cval * x;
+        my += cval * y;
+        mx2 += cval * x*x;
+        my2 += cval * y*y;
+        mxy += cval * x*y;
+        }
+    else
+      for (pixt=pixel+obj->firstpix; pixt>=pixel;
+	pixt=pixel+PLIST(pixt,nextpix))
+        {
+        cval = PLISTPIX(pixt, cdvalue);
+        tv += (val = PLISTPIX(pixt, dvalue));
+        if (val>thresh)
+          dnpix++;
+        if (val > thresh2)
+          area2++;
+        x = PLIST(pixt,x)-xmin;	/* avoid roundoff errors on big images */
+        y = PLIST(pixt,y)-ymin;	/* avoid roundoff errors on big images */
+        if PLISTEXIST(dgeo) {
+          x -= (dx = PLISTPIX(pixt, dgeox));
+          y -= (dy = PLISTPIX(pixt, dgeoy));
+          mdx += cval * dx;
+          mdy += cval * dy;
+        }
       mx += cval * x;
       my += cval * y;
       mx2 += cval * x*x;
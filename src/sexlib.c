@@ -0,0 +1,335 @@
+/*
+*				sexlib.c
+*
+* Library interface: source extraction from in-memory images.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifdef HAVE_CONFIG_H
+#include        "config.h"
+#endif
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"define.h"
+#include	"globals.h"
+#include	"prefs.h"
+#include	"fits/fitscat.h"
+#include	"sexlib.h"
+
+#define	SEXLIB_IMAGENAME	"sexlib:image"	/* in-memory image names */
+#define	SEXLIB_WEIGHTNAME	"sexlib:weight"
+#define	SEXLIB_FLAGNAME		"sexlib:flag"
+#define	SEXLIB_NKEYMAX		8		/* max. # of internal settings */
+
+static char	*sexlib_fits(const void *data, int bitpix, int width, int height,
+			const char *head, size_t *size);
+
+static prefstruct	sexlib_prefs;
+static char		**sexlib_argkey, **sexlib_argval;
+static int		sexlib_narg, sexlib_initflag;
+
+/****** sexlib_init ***********************************************************
+PROTO	int sexlib_init(const char *configname, int narg, const char **argkey,
+		const char **argval)
+PURPOSE	Set up the library.
+INPUT	Configuration file name (NULL for default.sex),
+	number of configuration parameters to override,
+	array of parameter names (without the leading '-'),
+	array of parameter values.
+OUTPUT	RETURN_OK.
+NOTES	The configuration file is re-read, and the overrides applied, for each
+	image; filters, PSFs and other models are loaded only once.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+int	sexlib_init(const char *configname, int narg, const char **argkey,
+		const char **argval)
+  {
+   int	i;
+
+  if (sexlib_initflag)
+    sexlib_end();
+
+  prefs.command_line = NULL;
+  prefs.ncommand_line = 0;
+  prefs.pipe_flag = 0;
+  prefs.batch_flag = 1;		/* keep filters, PSFs, etc. in memory */
+  prefs.nimage_name = 1;
+  strcpy(prefs.image_name[0], SEXLIB_IMAGENAME);
+  strcpy(prefs.prefs_name, configname? configname : "default.sex");
+  sexlib_prefs = prefs;
+
+  sexlib_narg = narg;
+  QMALLOC(sexlib_argkey, char *, narg+1);
+  QMALLOC(sexlib_argval, char *, narg+1);
+  for (i=0; i<narg; i++)
+    {
+    QMALLOC(sexlib_argkey[i], char, strlen(argkey[i])+1);
+    strcpy(sexlib_argkey[i], argkey[i]);
+    QMALLOC(sexlib_argval[i], char, strlen(argval[i])+1);
+    strcpy(sexlib_argval[i], argval[i]);
+    }
+
+  sexlib_initflag = 1;
+
+  return RETURN_OK;
+  }
+
+
+/****** sexlib_extract ********************************************************
+PROTO	sexlibcatstruct *sexlib_extract(const float *pix, const float *weight,
+		const unsigned int *flag, int width, int height,
+		const char *head)
+PURPOSE	Detect and measure sources in an in-memory image.
+INPUT	Pointer to the image pixels,
+	pointer to the weight-map pixels (or NULL),
+	pointer to the flag-map pixels (or NULL),
+	image width,
+	image height,
+	FITS header cards (e.g. WCS, GAIN) as a string of 80-char cards, or
+	NULL.
+OUTPUT	Pointer to a new in-memory catalog, to be freed with sexlib_freecat().
+NOTES	Pixel buffers belong to the caller and are not modified. The weight
+	map is a MAP_WEIGHT map unless WEIGHT_TYPE is set otherwise in the
+	configuration overrides.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+sexlibcatstruct	*sexlib_extract(const float *pix, const float *weight,
+			const unsigned int *flag, int width, int height,
+			const char *head)
+  {
+   sexlibcatstruct	*cat;
+   char			**argkey, **argval, *buf;
+   size_t		size;
+   int			i, n;
+
+  if (!sexlib_initflag)
+    sexlib_init(NULL, 0, NULL, NULL);
+
+  QMALLOC(argkey, char *, sexlib_narg + SEXLIB_NKEYMAX);
+  QMALLOC(argval, char *, sexlib_narg + SEXLIB_NKEYMAX);
+  n = 0;
+/* Default settings, which may be overridden by the caller */
+  argkey[n] = "VERBOSE_TYPE";
+  argval[n++] = "QUIET";
+  argkey[n] = "WRITE_XML";
+  argval[n++] = "N";
+  if (weight)
+    {
+    argkey[n] = "WEIGHT_TYPE";
+    argval[n++] = "MAP_WEIGHT";
+    }
+  for (i=0; i<sexlib_narg; i++)
+    {
+    argkey[n] = sexlib_argkey[i];
+    argval[n++] = sexlib_argval[i];
+    }
+/* Settings that only make sense with files */
+  argkey[n] = "BACK_CACHE";
+  argval[n++] = "N";
+  argkey[n] = "BACK_PYRAMID";
+  argval[n++] = "N";
+  argkey[n] = "CATALOG_TYPE";
+  argval[n++] = "NONE";
+
+/* Present the pixel buffers as in-memory FITS files */
+  buf = sexlib_fits(pix, BP_FLOAT, width, height, head, &size);
+  add_memimage(SEXLIB_IMAGENAME, buf, size);
+  if (weight)
+    {
+    buf = sexlib_fits(weight, BP_FLOAT, width, height, head, &size);
+    add_memimage(SEXLIB_WEIGHTNAME, buf, size);
+    argkey[n] = "WEIGHT_IMAGE";
+    argval[n++] = SEXLIB_WEIGHTNAME;
+    }
+  if (flag)
+    {
+    buf = sexlib_fits(flag, BP_LONG, width, height, head, &size);
+    add_memimage(SEXLIB_FLAGNAME, buf, size);
+    argkey[n] = "FLAG_IMAGE";
+    argval[n++] = SEXLIB_FLAGNAME;
+    }
+
+  prefs = sexlib_prefs;
+  readprefs(prefs.prefs_name, argkey, argval, n);
+  preprefs();
+  prefs.cat_type = CAT_MEMORY;
+  makeit();
+  endprefs();
+  free(argkey);
+  free(argval);
+
+  cat = getmemcat();
+
+  return cat;
+  }
+
+
+/****** sexlib_column *********************************************************
+PROTO	sexlibcolstruct *sexlib_column(sexlibcatstruct *cat, const char *name)
+PURPOSE	Find a catalog column from its measurement parameter name.
+INPUT	Pointer to the catalog,
+	parameter name (e.g. "MAG_AUTO").
+OUTPUT	Pointer to the column, or NULL if not found.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+sexlibcolstruct	*sexlib_column(sexlibcatstruct *cat, const char *name)
+  {
+   sexlibcolstruct	*col;
+   int			i;
+
+  for (i=cat->ncol, col=cat->col; i--; col++)
+    if (!strcmp(col->name, name))
+      return col;
+
+  return NULL;
+  }
+
+
+/****** sexlib_freecat ********************************************************
+PROTO	void sexlib_freecat(sexlibcatstruct *cat)
+PURPOSE	Free an in-memory catalog.
+INPUT	Pointer to the catalog.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	sexlib_freecat(sexlibcatstruct *cat)
+  {
+   int	i;
+
+  if (!cat)
+    return;
+  for (i=0; i<cat->ncol; i++)
+    free(cat->col[i].data);
+  free(cat->col);
+  free(cat);
+
+  return;
+  }
+
+
+/****** sexlib_end ************************************************************
+PROTO	void sexlib_end(void)
+PURPOSE	Free the memory used by the library.
+INPUT	-.
+OUTPUT	-.
+NOTES	-.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+void	sexlib_end(void)
+  {
+   int	i;
+
+  if (!sexlib_initflag)
+    return;
+
+  makeit_end();
+  for (i=0; i<sexlib_narg; i++)
+    {
+    free(sexlib_argkey[i]);
+    free(sexlib_argval[i]);
+    }
+  free(sexlib_argkey);
+  free(sexlib_argval);
+  sexlib_initflag = 0;
+
+  return;
+  }
+
+
+/****** sexlib_fits ***********************************************************
+PROTO	char *sexlib_fits(const void *data, int bitpix, int width, int height,
+		const char *head, size_t *size)
+PURPOSE	Build a FITS file in memory from a pixel buffer.
+INPUT	Pointer to the pixels (4 bytes each, native byte order),
+	FITS BITPIX (BP_FLOAT or BP_LONG),
+	image width,
+	image height,
+	extra FITS header cards, or NULL,
+	pointer to the returned file size.
+OUTPUT	Pointer to the new file content.
+NOTES	Structural keywords in the extra header cards are ignored.
+AUTHOR	E. Bertin (IAP)
+VERSION	19/10/2026
+ ***/
+static char	*sexlib_fits(const void *data, int bitpix, int width, int height,
+			const char *head, size_t *size)
+  {
+   static const char	*skipkey[] = {"SIMPLE  ", "BITPIX  ", "NAXIS", "EXTEND  ",
+				"XTENSION", "PCOUNT  ", "GCOUNT  ", "BSCALE  ",
+				"BZERO   ", "BLANK   ", ""};
+   const char		**key;
+   char			*buf, *card, str[81];
+   size_t		npix, headsize, nhead;
+   unsigned short	ashort=1;
+   int			i;
+
+  nhead = 0;
+  if (head)
+    for (i=strlen(head)/80; i-- && strncmp(head+nhead*80, "END     ", 8);)
+      nhead++;
+  npix = (size_t)width*height;
+  headsize = PADTOTAL((6+nhead)*80);
+  QMALLOC(buf, char, headsize + PADTOTAL(npix*4));
+  memset(buf, ' ', headsize);
+
+  card = buf;
+  sprintf(str, "SIMPLE  = %20s", "T");
+  memcpy(card, str, strlen(str));
+  sprintf(str, "BITPIX  = %20d", bitpix);
+  memcpy(card+=80, str, strlen(str));
+  sprintf(str, "NAXIS   = %20d", 2);
+  memcpy(card+=80, str, strlen(str));
+  sprintf(str, "NAXIS1  = %20d", width);
+  memcpy(card+=80, str, strlen(str));
+  sprintf(str, "NAXIS2  = %20d", height);
+  memcpy(card+=80, str, strlen(str));
+  for (i=0; i<nhead; i++, head+=80)
+    {
+    for (key=skipkey; **key && strncmp(head, *key, strlen(*key)); key++);
+    if (!**key)
+      memcpy(card+=80, head, 80);
+    }
+  memcpy(card+=80, "END", 3);
+/* Skipped cards may have made the header shorter */
+  headsize = PADTOTAL(card+80-buf);
+  *size = headsize + PADTOTAL(npix*4);
+
+/* FITS data are big-endian */
+  memcpy(buf+headsize, data, npix*4);
+  memset(buf+headsize+npix*4, 0, *size-headsize-npix*4);
+  if (*((char *)&ashort))
+    swapbytes(buf+headsize, 4, npix);
+
+  return buf;
+  }
@@ -0,0 +1,78 @@
+#pragma once
+/*
+*				sexlib.h
+*
+* Public interface of the SExtractor library (include file for sexlib.c).
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+/* Usage:
+	sexlib_init("default.sex", narg, argkey, argval);
+	for (each image)
+	  {
+	  cat = sexlib_extract(pix, weight, flag, width, height, head);
+	  col = sexlib_column(cat, "MAG_AUTO");
+	  mag = (float *)col->data;	-> mag[0 ... cat->nobj-1]
+	  sexlib_freecat(cat);
+	  }
+	sexlib_end();
+The measurement parameters are those listed in the PARAMETERS_NAME file.
+Configuration errors and other fatal errors terminate the process, as with
+the sex executable. The library is not reentrant: a single image may be
+processed at a time. */
+
+/*--------------------------------- typedefs --------------------------------*/
+typedef enum	{SEXLIB_BYTE, SEXLIB_SHORT, SEXLIB_INT, SEXLIB_LONGLONG,
+		SEXLIB_FLOAT, SEXLIB_DOUBLE, SEXLIB_STRING}
+			sexlibtype;	/* Data type of catalog columns */
+
+typedef struct
+  {
+  char		name[80];		/* measurement parameter name */
+  char		unit[80];		/* physical unit */
+  sexlibtype	type;			/* element data type */
+  int		nelem;			/* number of elements per object */
+  int		nbytes;			/* number of bytes per object */
+  void		*data;			/* nobj*nelem elements */
+  }	sexlibcolstruct;
+
+typedef struct
+  {
+  int		nobj;			/* number of objects */
+  int		ncol;			/* number of columns */
+  sexlibcolstruct	*col;		/* array of columns */
+  }	sexlibcatstruct;
+
+/*------------------------------- functions ---------------------------------*/
+extern sexlibcatstruct	*sexlib_extract(const float *pix, const float *weight,
+				const unsigned int *flag, int width, int height,
+				const char *head);
+
+extern sexlibcolstruct	*sexlib_column(sexlibcatstruct *cat, const char *name);
+
+extern int		sexlib_init(const char *configname, int narg,
+				const char **argkey, const char **argval);
+
+extern void		sexlib_end(void),
+			sexlib_freecat(sexlibcatstruct *cat);
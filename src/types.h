@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		02/12/2015
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -584,6 +584,7 @@ typedef struct pic
   int		stripy;			/* y position in buffer */
   int		stripylim;		/* y limit in buffer */
   int		stripysclim;		/* y scroll limit in buffer */
+  int		yprefetch;		/* y limit of read-ahead requests */
 /* ---- basic astrometric parameters */
    double	pixscale;		/* pixel size in arcsec.pix-1 */
    double	epoch;			/* epoch of coordinates */
@@ -604,12 +605,16 @@ typedef struct pic
   float		backsig;		/* median bkgnd rms in image */
   float		sigfac;			/* scaling RMS factor (for WEIGHTs) */
   PIXTYPE	*backline;		/* current interpolated bkgnd line */
+  float		*backnode;		/* bkgnd node interpolation buffer */
+  float		*backxcoef;		/* bkgnd x-interpolation coeffs */
+  int		*backxstart;		/* 1st pixel of each bkgnd segment */
   PIXTYPE	dthresh;		/* detection threshold */
   PIXTYPE	thresh;			/* analysis threshold */
   backenum	back_type;		/* Background type */
 /* ---- astrometric parameters */
   struct wcs	*wcs;			/* astrometric data */
   struct structassoc	*assoc;		/* ptr to the assoc-list */
+  struct structassoc	*modelassoc;	/* ptr to the model init. list */
   int		flags;			/* flags defining the field type */
 /* ---- image interpolation */
   int		interp_flag;		/* interpolation for this field? */
@@ -643,5 +648,11 @@ typedef struct
 /*----- MEF */
   int		currext;				/* current extension */
   int		next;					/* Nb of extensions */
+/*----- memory */
+  int		stripheight;				/* image buffer height*/
+  int		npixstack;				/* pixel stack size */
+  int		nobjstack;				/* peak object stack */
+  double	memfield;				/* image buffer mem. */
+  double	mempeak;				/* peak memory (est.)*/
   }		sexcatstruct;
 
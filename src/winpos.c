@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		04/03/2015
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -36,6 +36,7 @@
 #include	"define.h"
 #include	"globals.h"
 #include	"prefs.h"
+#include	"image.h"
 #include	"winpos.h"
 
 static  obj2struct	*obj2 = &outobj2;
@@ -70,10 +71,12 @@ void	compute_winpos(picstruct *field, picstruct *wfield,
    PIXTYPE              *strip,*stript, *wstrip, *wstript,
 			*dgeoxstrip, *dgeoystrip, *dgeoxstript, *dgeoystript,
                         wthresh = 0.0;
+   measvigstruct	*vig, *wvig, *gxvig, *gyvig;
 
   if (wfield)
     wthresh = wfield->weight_thresh;
   wstrip = wstript = NULL;
+  wvig = gxvig = gyvig = NULL;
   w = field->width;
   h = field->stripheight;
   fymin = field->ymin;
@@ -154,18 +157,25 @@ void	compute_winpos(picstruct *field, picstruct *wfield,
     wstrip = wstript = NULL;		/* To avoid gcc -Wall warnings */
     if (wfield)
       wstrip = wfield->strip;
+    vig = measvig_get(field, strip, xmin,xmax, ymin,ymax);
+    if (wfield)
+      wvig = measvig_get(field, wstrip, xmin,xmax, ymin,ymax);
     if (dgeofield) {			// Differential geometry map is present
       dgeoxstrip = dgeofield->dgeostrip[0];
       dgeoystrip = dgeofield->dgeostrip[1];
+      gxvig = measvig_get(field, dgeoxstrip, xmin,xmax, ymin,ymax);
+      gyvig = measvig_get(field, dgeoystrip, xmin,xmax, ymin,ymax);
     }
     for (y=ymin; y<ymax; y++)
       {
-      stript = strip + (pos = (y%h)*w + xmin);
+      stript = vig->pix + (y-vig->ymin)*vig->w + xmin-vig->xmin;
       if (wfield)
-        wstript = wstrip + pos;
+        wstript = wvig->pix + (y-wvig->ymin)*wvig->w + xmin-wvig->xmin;
       if (dgeofield) {
-        dgeoxstript = dgeoxstrip + pos;
-        dgeoystript = dgeoystrip + pos;
+        dgeoxstript = gxvig->pix + (y-gxvig->ymin)*gxvig->w
+		+ xmin-gxvig->xmin;
+        dgeoystript = gyvig->pix + (y-gyvig->ymin)*gyvig->w
+		+ xmin-gyvig->xmin;
       }
       for (x=xmin; x<xmax; x++)
         {
@@ -22,7 +22,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		07/03/2023
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -94,7 +94,7 @@ INPUT	-.
 OUTPUT	RETURN_OK if everything went fine, RETURN_ERROR otherwise.
 NOTES	-.
 AUTHOR	E. Bertin (IAP)
-VERSION	05/02/2010
+VERSION	19/10/2026
  ***/
 int	update_xml(sexcatstruct *sexcat, picstruct *dfield, picstruct *field,
 		picstruct *dwfield, picstruct *wfield)
@@ -131,6 +131,10 @@ int	update_xml(sexcatstruct *sexcat, picstruct *dfield, picstruct *field,
   x->gain[1] = field->gain;
   x->satur_level[0] = dfield->satur_level;
   x->satur_level[1] = field->satur_level;
+  x->stripheight = sexcat->stripheight;
+  x->npixstack = sexcat->npixstack;
+  x->nobjstack = sexcat->nobjstack;
+  x->mempeak = sexcat->mempeak;
 
   return EXIT_SUCCESS;
   }
@@ -232,7 +236,7 @@ INPUT	Pointer to the output file (or stream),
 OUTPUT	RETURN_OK if everything went fine, RETURN_ERROR otherwise.
 NOTES	-.
 AUTHOR	E. Bertin (CFHT/IAP)
-VERSION	07/03/2023
+VERSION	19/10/2026
  ***/
 int	write_xml_meta(FILE *file, char *error)
   {
@@ -380,8 +384,21 @@ int	write_xml_meta(FILE *file, char *error)
   fprintf(file, "   <FIELD name=\"Satur_Level\" datatype=\"float\""
 	" arraysize=\"%d\" ucd=\"instr.saturation;phot.count\" unit=\"ct\"/>\n",
 	prefs.nimage_name);
+/* Memory budget columns are only meaningful with MEMORY_LIMIT */
+  if (prefs.mem_limit > 0.0)
+    {
+    fprintf(file, "   <FIELD name=\"Buffer_Height\" datatype=\"int\""
+	" ucd=\"meta.number;obs.param\" unit=\"pix\"/>\n");
+    fprintf(file, "   <FIELD name=\"PixStack_Size\" datatype=\"int\""
+	" ucd=\"meta.number;obs.param\" unit=\"pix\"/>\n");
+    fprintf(file, "   <FIELD name=\"ObjStack_Peak\" datatype=\"int\""
+	" ucd=\"meta.number;src;obs.param\"/>\n");
+    fprintf(file, "   <FIELD name=\"Memory_Peak\" datatype=\"float\""
+	" ucd=\"meta.number;obs.param\" unit=\"Mbyte\"/>\n");
+    }
   fprintf(file, "   <DATA><TABLEDATA>\n");
   for (n=0; n<nxml; n++)
+    {
     if (prefs.nimage_name>1)
       fprintf(file, "     <TR>\n"
 	"      <TD>%d</TD><TD>%c %c</TD><TD>%s</TD><TD>%s</TD><TD>%.0f</TD>"
@@ -389,8 +406,7 @@ int	write_xml_meta(FILE *file, char *error)
 	"      <TD>%s,%s</TD><TD>%g %g</TD>\n"
 	"      <TD>%g %g</TD><TD>%g %g</TD><TD>%g %g</TD>"
 	"<TD>%g %g</TD><TD>%f %f</TD>\n"
-	"      <TD>%g %g</TD><TD>%g %g</TD>\n"
-	"     </TR>\n",
+	"      <TD>%g %g</TD><TD>%g %g</TD>\n",
 	xmlstack[n].currext,
 	xmlstack[n].headflag[0]?'T':'F',xmlstack[n].headflag[1]?'T':'F',
 	xmlstack[n].ext_date,
@@ -413,8 +429,7 @@ int	write_xml_meta(FILE *file, char *error)
 	"<TD>%d</TD><TD>%d</TD>\n"
 	"     <TD>%s</TD><TD>%g</TD>\n"
 	"     <TD>%g</TD><TD>%g</TD><TD>%g</TD><TD>%g</TD><TD>%f</TD>\n"
-	"     <TD>%g</TD><TD>%g</TD>\n"
-	"    </TR>\n",
+	"     <TD>%g</TD><TD>%g</TD>\n",
 	xmlstack[n].currext,
 	xmlstack[n].headflag[0]?'T':'F',
 	xmlstack[n].ext_date,
@@ -431,6 +446,12 @@ int	write_xml_meta(FILE *file, char *error)
         xmlstack[n].epoch[0],
 	xmlstack[n].gain[0],
 	xmlstack[n].satur_level[0]);
+    if (prefs.mem_limit > 0.0)
+      fprintf(file, "      <TD>%d</TD><TD>%d</TD><TD>%d</TD><TD>%.1f</TD>\n",
+	xmlstack[n].stripheight, xmlstack[n].npixstack, xmlstack[n].nobjstack,
+	xmlstack[n].mempeak/(1024.0*1024.0));
+    fprintf(file, "     </TR>\n");
+    }
   fprintf(file, "   </TABLEDATA></DATA>\n");
   fprintf(file, "  </TABLE>\n");
 
@@ -558,6 +579,8 @@ int	write_xml_meta(FILE *file, char *error)
 	"meta.number;obs.param", "%d");
     write_xmlconfigparam(file, "Memory_BufSize", "pix",
 	"meta.number;obs.param", "%d");
+    write_xmlconfigparam(file, "Memory_Limit", "Mbyte",
+	"meta.number;obs.param", "%g");
 
     write_xmlconfigparam(file, "Assoc_Name", "",
 	"meta;meta.table;meta.file", "");
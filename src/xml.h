@@ -23,7 +23,7 @@
 *	You should have received a copy of the GNU General Public License
 *	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
 *
-*	Last modified:		25/04/2013
+*	Last modified:		19/10/2026
 *
 *%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
@@ -56,6 +56,10 @@ typedef struct
   double	epoch[2];				/* epoch of coords */
   double	gain[2];				/* gain (e-/ADU) */
   double	satur_level[2];				/* saturation level */
+  int		stripheight;				/* image buffer height*/
+  int		npixstack;				/* pixel stack size */
+  int		nobjstack;				/* peak object stack */
+  double	mempeak;				/* peak memory (est.)*/
   }	xmlstruct;
 
 /*------------------------------- functions ---------------------------------*/
@@ -0,0 +1,132 @@
+/*
+*				backcmp.c
+*
+* Compare background maps computed from the image pyramid with full-resolution
+* ones.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifdef HAVE_CONFIG_H
+#include        "config.h"
+#endif
+
+#include	<math.h>
+#include	<stdio.h>
+#include	<stdlib.h>
+
+#include	"fits/fitscat_defs.h"
+#include	"fits/fitscat.h"
+
+/* Tolerances, in units of the full-resolution background RMS */
+#define	BACKCMP_MAXMEAN		0.05	/* mean background difference */
+#define	BACKCMP_MAXPEAK		0.25	/* max. background difference */
+#define	BACKCMP_MAXSIG		0.05	/* max. relative RMS difference */
+
+static float	*read_image(const char *filename, int *w, int *h);
+
+/*
+Usage: backcmp <back> <rms> <pyramid back> <pyramid rms>
+The images are BACKGROUND and BACKGROUND_RMS check-images.
+*/
+int	main(int argc, char **argv)
+  {
+   float	*back,*sig, *pback,*psig;
+   double	dback, dsig, mean, peak, sigpeak;
+   size_t	i, npix;
+   int		w,h, pw,ph;
+
+  if (argc != 5)
+    {
+    fprintf(stderr, "usage: backcmp <back> <rms> <pyramid back> "
+	"<pyramid rms>\n");
+    return EXIT_FAILURE;
+    }
+
+  back = read_image(argv[1], &w, &h);
+  sig = read_image(argv[2], &pw, &ph);
+  if (pw!=w || ph!=h)
+    return EXIT_FAILURE;
+  pback = read_image(argv[3], &pw, &ph);
+  if (pw!=w || ph!=h)
+    return EXIT_FAILURE;
+  psig = read_image(argv[4], &pw, &ph);
+  if (pw!=w || ph!=h)
+    return EXIT_FAILURE;
+
+  npix = (size_t)w*h;
+  mean = peak = sigpeak = 0.0;
+  for (i=0; i<npix; i++)
+    {
+    if (sig[i] <= 0.0)
+      {
+      fprintf(stderr, "backcmp: zero or negative RMS in %s\n", argv[2]);
+      return EXIT_FAILURE;
+      }
+    dback = fabs(pback[i] - back[i])/sig[i];
+    dsig = fabs(psig[i] - sig[i])/sig[i];
+    mean += dback;
+    if (dback > peak)
+      peak = dback;
+    if (dsig > sigpeak)
+      sigpeak = dsig;
+    }
+  mean /= npix;
+
+  printf("backcmp: background mean %.4f, max %.4f; RMS max %.4f\n",
+	mean, peak, sigpeak);
+  free(back);
+  free(sig);
+  free(pback);
+  free(psig);
+
+  return (mean > BACKCMP_MAXMEAN || peak > BACKCMP_MAXPEAK
+	|| sigpeak > BACKCMP_MAXSIG)? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
+
+/*
+Read the pixels of a 2D FITS image.
+*/
+static float	*read_image(const char *filename, int *w, int *h)
+  {
+   catstruct	*cat;
+   tabstruct	*tab;
+   float	*pix;
+
+  if (!(cat = read_cat((char *)filename)))
+    {
+    fprintf(stderr, "backcmp: cannot read %s\n", filename);
+    exit(EXIT_FAILURE);
+    }
+  tab = cat->tab;
+  *w = tab->naxisn[0];
+  *h = tab->naxisn[1];
+  QMALLOC(pix, float, (size_t)*w**h);
+  QFSEEK(cat->file, tab->bodypos, SEEK_SET, cat->filename);
+  read_body(tab, pix, (size_t)*w**h);
+  free_cat(&cat, 1);
+
+  return pix;
+  }
+
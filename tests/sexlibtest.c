@@ -0,0 +1,120 @@
+/*
+*				sexlibtest.c
+*
+* Check the library interface on the test image.
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*	This file part of:	SExtractor
+*
+*	Copyright:		(C) 2026 IAP/CNRS/SorbonneU
+*
+*	License:		GNU General Public License
+*
+*	SExtractor is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*	SExtractor is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*	You should have received a copy of the GNU General Public License
+*	along with SExtractor. If not, see <http://www.gnu.org/licenses/>.
+*
+*	Last modified:		19/10/2026
+*
+*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
+
+#ifdef HAVE_CONFIG_H
+#include        "config.h"
+#endif
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"fits/fitscat_defs.h"
+#include	"fits/fitscat.h"
+#include	"sexlib.h"
+
+#define	TEST_IMAGENAME	"galaxies.fits"
+#define	TEST_CONFIGNAME	"default.sex"
+#define	TEST_PARAMNAME	"sexlibtest.param"
+
+static int	test_fail(const char *msg);
+
+/*
+The image is read with the standalone FITS library, which is linked before
+libsex.a. As libsex.a holds a single object, the link would fail on duplicate
+symbols if it exported its own copy of the FITS functions.
+*/
+int	main(void)
+  {
+   const char		*key[] = {"PARAMETERS_NAME", "FILTER_NAME"},
+			*val[] = {TEST_PARAMNAME, "gauss_4.0_7x7.conv"};
+   catstruct		*fcat;
+   tabstruct		*tab;
+   sexlibcatstruct	*cat, *cat2;
+   sexlibcolstruct	*col, *col2;
+   PIXTYPE		*pix;
+   float		*x;
+   int			*number,
+			i, width,height;
+
+  if (!(fcat = read_cat(TEST_IMAGENAME)))
+    return test_fail("cannot read " TEST_IMAGENAME);
+  tab = fcat->tab;
+  width = tab->naxisn[0];
+  height = tab->naxisn[1];
+  QMALLOC(pix, PIXTYPE, (size_t)width*height);
+  QFSEEK(fcat->file, tab->bodypos, SEEK_SET, fcat->filename);
+  read_body(tab, pix, (size_t)width*height);
+  free_cat(&fcat, 1);
+
+  sexlib_init(TEST_CONFIGNAME, 2, key, val);
+  cat = sexlib_extract(pix, NULL, NULL, width, height, NULL);
+  if (!cat || cat->nobj<1)
+    return test_fail("no object in the catalog");
+  if (!(col = sexlib_column(cat, "NUMBER")) || col->type != SEXLIB_INT)
+    return test_fail("missing NUMBER column");
+  number = (int *)col->data;
+  for (i=0; i<cat->nobj; i++)
+    if (number[i] != i+1)
+      return test_fail("NUMBER is not a running index");
+  if (!(col = sexlib_column(cat, "X_IMAGE")) || col->type != SEXLIB_FLOAT
+	|| !sexlib_column(cat, "Y_IMAGE") || !sexlib_column(cat, "FLUX_AUTO"))
+    return test_fail("missing measurement columns");
+  x = (float *)col->data;
+  for (i=0; i<cat->nobj; i++)
+    if (x[i]<0.5 || x[i]>width+0.5)
+      return test_fail("X_IMAGE is outside of the image");
+
+/* A second run on the same pixels must give the same catalog */
+  cat2 = sexlib_extract(pix, NULL, NULL, width, height, NULL);
+  if (!cat2 || cat2->nobj != cat->nobj)
+    return test_fail("second run gives a different number of objects");
+  col2 = sexlib_column(cat2, "X_IMAGE");
+  if (memcmp(col->data, col2->data, (size_t)cat->nobj*col->nbytes))
+    return test_fail("second run gives different positions");
+
+  printf("sexlibtest: %d objects\n", cat->nobj);
+  sexlib_freecat(cat);
+  sexlib_freecat(cat2);
+  sexlib_end();
+  free(pix);
+
+  return EXIT_SUCCESS;
+  }
+
+
+/*
+Report a failed check.
+*/
+static int	test_fail(const char *msg)
+  {
+  fprintf(stderr, "sexlibtest: %s\n", msg);
+
+  return EXIT_FAILURE;
+  }
+